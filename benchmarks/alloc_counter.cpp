@@ -0,0 +1,45 @@
+/**
+ *
+ *  @file alloc_counter.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include "alloc_counter.hpp"
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+  std::atomic<std::uint64_t> g_allocations{0};
+
+  void *counted_alloc(std::size_t n)
+  {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(n ? n : 1))
+      return p;
+    throw std::bad_alloc();
+  }
+} // namespace
+
+namespace vix::bench
+{
+  std::uint64_t allocation_count() noexcept
+  {
+    return g_allocations.load(std::memory_order_relaxed);
+  }
+} // namespace vix::bench
+
+void *operator new(std::size_t n) { return counted_alloc(n); }
+void *operator new[](std::size_t n) { return counted_alloc(n); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
@@ -0,0 +1,48 @@
+/**
+ *
+ *  @file alloc_counter.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ * @brief Global heap allocation counter shared by the utils benchmarks.
+ *
+ * alloc_counter.cpp replaces the global operator new/delete for the
+ * benchmark executable and counts every allocation, so a benchmark can
+ * report heap allocations per iteration next to its timings.
+ */
+#ifndef VIX_UTILS_BENCH_ALLOC_COUNTER_HPP
+#define VIX_UTILS_BENCH_ALLOC_COUNTER_HPP
+
+#include <atomic>
+#include <cstdint>
+
+namespace vix::bench
+{
+  /**
+   * @brief Number of global operator new calls since process start.
+   */
+  std::uint64_t allocation_count() noexcept;
+
+  /**
+   * @brief Measure allocations performed between construction and read().
+   */
+  class AllocScope
+  {
+  public:
+    AllocScope() noexcept : start_(allocation_count()) {}
+
+    std::uint64_t read() const noexcept { return allocation_count() - start_; }
+
+  private:
+    std::uint64_t start_;
+  };
+
+} // namespace vix::bench
+
+#endif // VIX_UTILS_BENCH_ALLOC_COUNTER_HPP
@@ -0,0 +1,56 @@
+/**
+ *
+ *  @file bench_main.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ * @brief Entry point for vix_utils_bench.
+ *
+ * Logger benchmarks redirect stdout to /dev/null so that sink I/O does not
+ * dominate the numbers, therefore the console report is written to stderr.
+ * `--benchmark_format=json` selects a JSON display report; file output via
+ * `--benchmark_out=<file>` works as usual (the `vix_utils_bench_json`
+ * target writes one). The build info (version, git hash, date) is added to
+ * the report context so stored results can be matched to a commit.
+ */
+#include <vix/utils/Version.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <iostream>
+#include <memory>
+#include <string_view>
+
+int main(int argc, char **argv)
+{
+  bool json = false;
+  for (int i = 1; i < argc; ++i)
+  {
+    if (std::string_view(argv[i]) == "--benchmark_format=json")
+      json = true;
+  }
+
+  benchmark::AddCustomContext("vix_utils", vix::utils::build_info());
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+
+  std::unique_ptr<benchmark::BenchmarkReporter> display;
+  if (json)
+    display = std::make_unique<benchmark::JSONReporter>();
+  else
+    display = std::make_unique<benchmark::ConsoleReporter>();
+
+  display->SetOutputStream(&std::cerr);
+  display->SetErrorStream(&std::cerr);
+
+  benchmark::RunSpecifiedBenchmarks(display.get());
+  benchmark::Shutdown();
+  return 0;
+}
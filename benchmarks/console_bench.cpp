@@ -0,0 +1,115 @@
+/**
+ *
+ *  @file console_bench.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ * @brief Console coordination cost per line.
+ *
+ * - wait_banner: console_wait_banner() once the banner is done
+ * - locked_write: wait + console_mutex() + fwrite on the calling thread
+ *   (the pre-ConsoleWriter path)
+ * - writer_queue: wait + enqueue on ConsoleWriter
+ * - banner_render: composing the RuntimeBanner into one buffer
+ *
+ * stdout is redirected to /dev/null, so the locked numbers are a lower
+ * bound: a real terminal makes every locked write slower.
+ */
+#include <vix/utils/ConsoleMutex.hpp>
+#include <vix/utils/ConsoleWriter.hpp>
+#include <vix/utils/ServerPrettyLogs.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+namespace
+{
+  constexpr std::string_view kLine =
+      "12:00:00 [vix] [info] GET /api/v1/users/42 -> 200 in 3.25 ms\n";
+
+  void silence_stdout()
+  {
+    static const bool done = []
+    {
+#if defined(_WIN32)
+      return std::freopen("NUL", "w", stdout) != nullptr;
+#else
+      return std::freopen("/dev/null", "w", stdout) != nullptr;
+#endif
+    }();
+    (void)done;
+  }
+
+  void BM_ConsoleWaitBanner(benchmark::State &state)
+  {
+    for (auto _ : state)
+      vix::utils::console_wait_banner();
+  }
+
+  void BM_ConsoleLockedWrite(benchmark::State &state)
+  {
+    if (state.thread_index() == 0)
+      silence_stdout();
+
+    for (auto _ : state)
+    {
+      vix::utils::console_wait_banner();
+      std::lock_guard<std::mutex> lk(vix::utils::console_mutex());
+      std::fwrite(kLine.data(), 1, kLine.size(), stdout);
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+
+  void BM_ConsoleWriterQueue(benchmark::State &state)
+  {
+    if (state.thread_index() == 0)
+      silence_stdout();
+
+    auto &writer = vix::utils::ConsoleWriter::instance();
+    for (auto _ : state)
+    {
+      vix::utils::console_wait_banner();
+      writer.write(vix::utils::ConsoleStream::Out, kLine);
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0)
+      writer.flush();
+  }
+
+  void BM_BannerRender(benchmark::State &state)
+  {
+    using vix::utils::RuntimeBanner;
+
+    vix::utils::ServerReadyInfo info;
+    info.version = "Vix.cpp v1.16.1";
+    info.ready_ms = 42;
+    info.mode = "run";
+    info.config_path = "/srv/app/config.json";
+    info.threads = 8;
+    info.max_threads = 16;
+
+    std::string out;
+    for (auto _ : state)
+    {
+      out.clear();
+      RuntimeBanner::render_server_ready(out, info, RuntimeBanner::terminal());
+      benchmark::DoNotOptimize(out.data());
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * out.size()));
+  }
+} // namespace
+
+BENCHMARK(BM_ConsoleWaitBanner)->UseRealTime()->ThreadRange(1, 8);
+BENCHMARK(BM_ConsoleLockedWrite)->UseRealTime()->ThreadRange(1, 8);
+BENCHMARK(BM_ConsoleWriterQueue)->UseRealTime()->ThreadRange(1, 8);
+BENCHMARK(BM_BannerRender);
@@ -0,0 +1,49 @@
+/**
+ *
+ *  @file env_bench.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ * @brief Live getenv parsing versus the pre-parsed EnvSnapshot.
+ */
+#include <vix/utils/Env.hpp>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+  void BM_EnvUintLive(benchmark::State &state)
+  {
+    for (auto _ : state)
+      benchmark::DoNotOptimize(vix::utils::env_uint("VIX_LOG_ASYNC_QUEUE", 8192u));
+  }
+
+  void BM_EnvUintSnapshot(benchmark::State &state)
+  {
+    for (auto _ : state)
+      benchmark::DoNotOptimize(vix::utils::env_uint(vix::utils::env_snapshot(), "VIX_LOG_ASYNC_QUEUE", 8192u));
+  }
+
+  void BM_EnvOrLive(benchmark::State &state)
+  {
+    for (auto _ : state)
+      benchmark::DoNotOptimize(vix::utils::env_or("PATH"));
+  }
+
+  void BM_EnvViewSnapshot(benchmark::State &state)
+  {
+    for (auto _ : state)
+      benchmark::DoNotOptimize(vix::utils::env_snapshot().view_or("PATH"));
+  }
+} // namespace
+
+BENCHMARK(BM_EnvUintLive);
+BENCHMARK(BM_EnvUintSnapshot);
+BENCHMARK(BM_EnvOrLive);
+BENCHMARK(BM_EnvViewSnapshot);
@@ -0,0 +1,68 @@
+/**
+ *
+ *  @file file_sink_bench.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ * @brief Per-record cost of file output: BatchedFileSink vs spdlog's basic_file_sink.
+ *
+ * Both sinks get the same pattern and write to a file in the temp
+ * directory, which is removed afterwards.
+ */
+#include <vix/utils/FileSink.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <spdlog/logger.h>
+#include <spdlog/sinks/basic_file_sink.h>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+
+namespace
+{
+  std::string temp_log(const char *name)
+  {
+    return (std::filesystem::temp_directory_path() / name).string();
+  }
+
+  void run(benchmark::State &state, spdlog::sink_ptr sink)
+  {
+    sink->set_pattern("%Y-%m-%d %H:%M:%S.%e [%l] %v");
+    spdlog::logger log("bench", std::move(sink));
+
+    for (auto _ : state)
+      log.info("request method=GET path=/api/v1/users/42 status=200 duration_ms=3.25");
+
+    log.flush();
+    state.SetItemsProcessed(state.iterations());
+  }
+
+  void BM_FileSinkBatched(benchmark::State &state)
+  {
+    const std::string path = temp_log("vix_bench_batched.log");
+    {
+      vix::utils::BatchedFileSink::Options options;
+      options.path = path;
+      run(state, std::make_shared<vix::utils::BatchedFileSink>(options));
+    }
+    std::filesystem::remove(path);
+  }
+
+  void BM_FileSinkBasic(benchmark::State &state)
+  {
+    const std::string path = temp_log("vix_bench_basic.log");
+    run(state, std::make_shared<spdlog::sinks::basic_file_sink_st>(path, true));
+    std::filesystem::remove(path);
+  }
+} // namespace
+
+BENCHMARK(BM_FileSinkBatched);
+BENCHMARK(BM_FileSinkBasic);
@@ -0,0 +1,124 @@
+/**
+ *
+ *  @file logger_async_bench.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ * @brief Producer-side cost of Logger::log and Logger::logf in async modes.
+ *
+ * - pool: formatted on the caller, queued to the shared spdlog worker pool
+ * - rings: formatted on the caller, queued to the caller's own SPSC ring
+ * - deferred: arguments copied into the caller's ring, formatted by the backend
+ *
+ * BM_LogfAsync runs structured logf on the rings in each output format.
+ *
+ * The queue blocks when full, so sustained throughput is bounded by the
+ * backend; the per-call CPU time is what the calling thread pays. The
+ * threaded variants show contention on the shared queue.
+ */
+#include <vix/utils/Logger.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <string>
+
+using vix::utils::Logger;
+
+namespace
+{
+  void silence_stdout()
+  {
+    static const bool done = []
+    {
+#if defined(_WIN32)
+      return std::freopen("NUL", "w", stdout) != nullptr;
+#else
+      return std::freopen("/dev/null", "w", stdout) != nullptr;
+#endif
+    }();
+    (void)done;
+  }
+
+  enum class Mode
+  {
+    Pool,
+    Rings,
+    Deferred
+  };
+
+  void BM_LogAsync(benchmark::State &state, Mode mode)
+  {
+    auto &log = Logger::getInstance();
+
+    if (state.thread_index() == 0)
+    {
+      silence_stdout();
+      log.setFormat(Logger::Format::KV);
+      log.setLevel(Logger::Level::Info);
+
+      Logger::AsyncOptions options;
+      options.queue_capacity = 1u << 16;
+      options.overflow = Logger::AsyncOptions::Overflow::Block;
+      options.thread_rings = mode != Mode::Pool;
+      options.deferred = mode == Mode::Deferred;
+      log.setAsync(options);
+    }
+
+    const std::string path = "/api/v1/users/42";
+    for (auto _ : state)
+      log.info("GET {} -> {} in {:.2f} ms (user {})", path, 200, 3.25, 42u);
+
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0)
+      log.setAsync(false);
+  }
+
+  /**
+   * Structured logf through the per-thread rings, per output format.
+   */
+  void BM_LogfAsync(benchmark::State &state, Logger::Format format)
+  {
+    auto &log = Logger::getInstance();
+
+    if (state.thread_index() == 0)
+    {
+      silence_stdout();
+      log.setFormat(format);
+      log.setLevel(Logger::Level::Info);
+
+      Logger::AsyncOptions options;
+      options.queue_capacity = 1u << 16;
+      options.overflow = Logger::AsyncOptions::Overflow::Block;
+      options.thread_rings = true;
+      log.setAsync(options);
+    }
+
+    const std::string path = "/api/v1/users/42";
+    for (auto _ : state)
+      log.logf(Logger::Level::Info, "request", "method", "GET", "path", path,
+               "status", 200, "duration_ms", 3.25);
+
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0)
+    {
+      log.setAsync(false);
+      log.setFormat(Logger::Format::KV);
+    }
+  }
+} // namespace
+
+BENCHMARK_CAPTURE(BM_LogAsync, pool, Mode::Pool)->UseRealTime()->ThreadRange(1, 8);
+BENCHMARK_CAPTURE(BM_LogAsync, rings, Mode::Rings)->UseRealTime()->ThreadRange(1, 8);
+BENCHMARK_CAPTURE(BM_LogAsync, deferred, Mode::Deferred)->UseRealTime()->ThreadRange(1, 8);
+BENCHMARK_CAPTURE(BM_LogfAsync, kv, Logger::Format::KV)->UseRealTime()->ThreadRange(1, 8);
+BENCHMARK_CAPTURE(BM_LogfAsync, json, Logger::Format::JSON)->UseRealTime()->ThreadRange(1, 8);
+BENCHMARK_CAPTURE(BM_LogfAsync, json_pretty, Logger::Format::JSON_PRETTY)->UseRealTime()->ThreadRange(1, 8);
@@ -0,0 +1,162 @@
+/**
+ *
+ *  @file logger_format_bench.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ * @brief Synchronous logging (Logger::logf and Logger::log) cost per output format.
+ *
+ * Every benchmark logs the same record (context + mixed key/value types)
+ * in KV, JSON and JSON_PRETTY, with stdout redirected to /dev/null so the
+ * numbers measure formatting rather than terminal I/O. The fmt-style
+ * variants also run on 1..8 threads sharing the synchronous sink.
+ *
+ * Counters:
+ * - allocs_per_line: heap allocations per logf call, after warm-up.
+ *   This includes spdlog's own sink buffer for lines longer than its
+ *   inline capacity (250 bytes).
+ */
+#include <vix/utils/Logger.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <string>
+
+#include "alloc_counter.hpp"
+
+using vix::utils::Logger;
+
+namespace
+{
+  void silence_stdout()
+  {
+    static const bool done = []
+    {
+#if defined(_WIN32)
+      return std::freopen("NUL", "w", stdout) != nullptr;
+#else
+      return std::freopen("/dev/null", "w", stdout) != nullptr;
+#endif
+    }();
+    (void)done;
+  }
+
+  void setup(Logger::Format format)
+  {
+    silence_stdout();
+
+    auto &log = Logger::getInstance();
+    log.setFormat(format);
+    log.setLevel(Logger::Level::Info);
+
+    Logger::Context cx;
+    cx.request_id = "3f1c2a9e-6b1d-4c7a-9e0f-1a2b3c4d5e6f";
+    cx.module = "bench";
+    cx.fields["ip"] = "127.0.0.1";
+    log.setContext(std::move(cx));
+  }
+
+  void BM_Logf(benchmark::State &state, Logger::Format format)
+  {
+    setup(format);
+
+    auto &log = Logger::getInstance();
+    const std::string path = "/api/v1/users/42";
+
+    // warm up the thread-local arena
+    for (int i = 0; i < 16; ++i)
+      log.logf(Logger::Level::Info, "request", "method", "GET", "path", path,
+               "status", 200, "duration_ms", 3.25, "cached", true);
+
+    const vix::bench::AllocScope allocs;
+    for (auto _ : state)
+    {
+      log.logf(Logger::Level::Info, "request", "method", "GET", "path", path,
+               "status", 200, "duration_ms", 3.25, "cached", true);
+    }
+
+    state.counters["allocs_per_line"] = benchmark::Counter(
+        static_cast<double>(allocs.read()) / static_cast<double>(state.iterations()));
+    state.SetItemsProcessed(state.iterations());
+  }
+
+  /**
+   * Per-request context setup and teardown: reset in place, one field,
+   * two scoped fields, one line.
+   */
+  void BM_ContextSetup(benchmark::State &state)
+  {
+    setup(Logger::Format::KV);
+
+    auto &log = Logger::getInstance();
+    const std::string rid = "3f1c2a9e-6b1d-4c7a-9e0f-1a2b3c4d5e6f";
+
+    auto once = [&]
+    {
+      log.resetContext(rid, "bench");
+      log.setContextField("ip", "127.0.0.1");
+      Logger::ContextGuard g("user", "42");
+      g.push("tenant", "acme");
+      log.logf(Logger::Level::Info, "request", "status", 200);
+    };
+
+    for (int i = 0; i < 16; ++i)
+      once();
+
+    const vix::bench::AllocScope allocs;
+    for (auto _ : state)
+      once();
+
+    state.counters["allocs_per_request"] = benchmark::Counter(
+        static_cast<double>(allocs.read()) / static_cast<double>(state.iterations()));
+  }
+
+  void BM_LogfDisabled(benchmark::State &state)
+  {
+    setup(Logger::Format::KV);
+
+    auto &log = Logger::getInstance();
+    for (auto _ : state)
+      log.logf(Logger::Level::Debug, "request", "status", 200);
+  }
+
+  void BM_Log(benchmark::State &state, Logger::Format format)
+  {
+    // Every thread sets its own context; format and level are shared.
+    setup(format);
+
+    auto &log = Logger::getInstance();
+    const std::string path = "/api/v1/users/42";
+    for (auto _ : state)
+      log.log(Logger::Level::Info, "GET {} -> {} in {:.2f} ms", path, 200, 3.25);
+
+    state.SetItemsProcessed(state.iterations());
+  }
+
+  void BM_LogDisabled(benchmark::State &state)
+  {
+    setup(Logger::Format::KV);
+
+    auto &log = Logger::getInstance();
+    const std::string path = "/api/v1/users/42";
+    for (auto _ : state)
+      log.debug("GET {} -> {}", path, 200);
+  }
+} // namespace
+
+BENCHMARK_CAPTURE(BM_Logf, kv, Logger::Format::KV);
+BENCHMARK_CAPTURE(BM_Logf, json, Logger::Format::JSON);
+BENCHMARK_CAPTURE(BM_Logf, json_pretty, Logger::Format::JSON_PRETTY);
+BENCHMARK(BM_ContextSetup);
+BENCHMARK(BM_LogfDisabled);
+BENCHMARK_CAPTURE(BM_Log, kv, Logger::Format::KV)->UseRealTime()->ThreadRange(1, 8);
+BENCHMARK_CAPTURE(BM_Log, json, Logger::Format::JSON)->UseRealTime()->ThreadRange(1, 8);
+BENCHMARK_CAPTURE(BM_Log, json_pretty, Logger::Format::JSON_PRETTY)->UseRealTime()->ThreadRange(1, 8);
+BENCHMARK(BM_LogDisabled)->ThreadRange(1, 8);
@@ -0,0 +1,83 @@
+/**
+ *
+ *  @file metrics_bench.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ * @brief Write-side cost of the sharded metrics versus one shared atomic,
+ * from 1 to 64 threads, plus snapshot (read) cost.
+ */
+#include <vix/utils/Metrics.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+
+namespace
+{
+  using namespace vix::utils;
+
+  std::atomic<std::uint64_t> g_shared{0};
+  Counter g_counter;
+  Histogram g_histogram;
+
+  void BM_SharedAtomicInc(benchmark::State &state)
+  {
+    for (auto _ : state)
+      g_shared.fetch_add(1, std::memory_order_relaxed);
+    state.SetItemsProcessed(state.iterations());
+  }
+
+  void BM_CounterInc(benchmark::State &state)
+  {
+    for (auto _ : state)
+      g_counter.inc();
+    state.SetItemsProcessed(state.iterations());
+  }
+
+  void BM_HistogramRecord(benchmark::State &state)
+  {
+    std::uint64_t v = 1000 + static_cast<std::uint64_t>(state.thread_index());
+    for (auto _ : state)
+    {
+      g_histogram.record(v);
+      v = v * 6364136223846793005ull + 1442695040888963407ull;
+      v >>= 40; // up to ~16M
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+
+  void BM_ScopedTimer(benchmark::State &state)
+  {
+    Histogram h;
+    for (auto _ : state)
+    {
+      ScopedTimer t(h);
+      benchmark::DoNotOptimize(&t);
+    }
+  }
+
+  void BM_HistogramSnapshot(benchmark::State &state)
+  {
+    for (int i = 0; i < 1000; ++i)
+      g_histogram.record(static_cast<std::uint64_t>(i) * 977);
+    for (auto _ : state)
+    {
+      const HistogramSnapshot s = g_histogram.snapshot();
+      benchmark::DoNotOptimize(s.percentile(0.99));
+    }
+  }
+} // namespace
+
+BENCHMARK(BM_SharedAtomicInc)->UseRealTime()->ThreadRange(1, 64);
+BENCHMARK(BM_CounterInc)->UseRealTime()->ThreadRange(1, 64);
+BENCHMARK(BM_HistogramRecord)->UseRealTime()->ThreadRange(1, 64);
+BENCHMARK(BM_ScopedTimer);
+BENCHMARK(BM_HistogramSnapshot);
@@ -0,0 +1,84 @@
+/**
+ *
+ *  @file multipart_bench.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ * @brief Multipart upload parsing throughput: streaming parser vs std::string::find.
+ *
+ * One 4 MiB file part with binary-looking content, fed in 64 KiB chunks
+ * to MultipartParser; the baseline searches the whole buffered body for
+ * the delimiter with std::string_view::find.
+ */
+#include <vix/utils/Multipart.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+
+namespace
+{
+  const std::string kBoundary = "----WebKitFormBoundary7MA4YWxkTrZu0gW";
+
+  std::string upload_body()
+  {
+    std::string body = "--" + kBoundary + "\r\n"
+                       "Content-Disposition: form-data; name=\"file\"; filename=\"blob.bin\"\r\n"
+                       "Content-Type: application/octet-stream\r\n\r\n";
+
+    std::uint32_t x = 12345;
+    for (std::size_t i = 0; i < (4u << 20); ++i)
+    {
+      x = x * 1664525u + 1013904223u;
+      body.push_back(static_cast<char>(x >> 24));
+    }
+
+    body += "\r\n--" + kBoundary + "--\r\n";
+    return body;
+  }
+
+  struct Sink
+  {
+    std::size_t bytes = 0;
+
+    void on_part_begin(const vix::utils::MultipartParser::PartHeaders &) {}
+    void on_part_data(std::string_view d) { bytes += d.size(); }
+    void on_part_end() {}
+  };
+
+  void BM_MultipartStream(benchmark::State &state)
+  {
+    const std::string body = upload_body();
+    const std::size_t chunk = 64 * 1024;
+
+    for (auto _ : state)
+    {
+      vix::utils::MultipartParser parser(kBoundary);
+      Sink sink;
+      for (std::size_t pos = 0; pos < body.size(); pos += chunk)
+        parser.feed(std::string_view(body).substr(pos, chunk), sink);
+      benchmark::DoNotOptimize(sink.bytes);
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * body.size()));
+  }
+
+  void BM_MultipartFind(benchmark::State &state)
+  {
+    const std::string body = upload_body();
+    const std::string delim = "\r\n--" + kBoundary;
+
+    for (auto _ : state)
+      benchmark::DoNotOptimize(std::string_view(body).find(delim));
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * body.size()));
+  }
+} // namespace
+
+BENCHMARK(BM_MultipartStream);
+BENCHMARK(BM_MultipartFind);
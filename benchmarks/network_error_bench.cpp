@@ -0,0 +1,66 @@
+/**
+ *
+ *  @file network_error_bench.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2026, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ * @brief Disconnect classification: token-by-token scan versus the
+ * compile-time automaton, and the error_code fast path.
+ */
+#include <vix/utils/NetworkError.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <string_view>
+#include <system_error>
+
+namespace
+{
+  // No token matches, so every scan reads the whole message.
+  constexpr std::string_view kMessage =
+      "async_read_some: Connection refused [system:111 at /usr/include/asio/detail/reactive_socket_service_base.hpp:398]";
+
+  void BM_DisconnectMessagePerToken(benchmark::State &state)
+  {
+    for (auto _ : state)
+    {
+      bool hit = false;
+      for (const std::string_view token : vix::utils::detail::kDisconnectTokens)
+        hit = hit || vix::utils::contains_token_icase(kMessage, token);
+      benchmark::DoNotOptimize(hit);
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * kMessage.size()));
+  }
+
+  void BM_DisconnectMessageAutomaton(benchmark::State &state)
+  {
+    for (auto _ : state)
+      benchmark::DoNotOptimize(vix::utils::is_normal_network_disconnect_message(kMessage));
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * kMessage.size()));
+  }
+
+  void BM_DisconnectErrorCode(benchmark::State &state)
+  {
+    const std::error_code code(ECONNRESET, std::system_category());
+    for (auto _ : state)
+      benchmark::DoNotOptimize(vix::utils::is_normal_network_disconnect(code));
+  }
+
+  void BM_DisconnectSystemError(benchmark::State &state)
+  {
+    const std::system_error e(std::error_code(ECONNREFUSED, std::system_category()), "async_read_some");
+    for (auto _ : state)
+      benchmark::DoNotOptimize(vix::utils::is_normal_network_disconnect(e));
+  }
+} // namespace
+
+BENCHMARK(BM_DisconnectMessagePerToken);
+BENCHMARK(BM_DisconnectMessageAutomaton);
+BENCHMARK(BM_DisconnectErrorCode);
+BENCHMARK(BM_DisconnectSystemError);
@@ -0,0 +1,191 @@
+/**
+ *
+ *  @file result_bench.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ * @brief Result<T, E> returns, moves, monadic chains and bulk copies versus
+ * std::expected (when the standard library provides it) and std::variant.
+ */
+#include <vix/utils/Result.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <variant>
+#include <vector>
+#include <version>
+
+#if defined(__cpp_lib_expected)
+#include <expected>
+#endif
+
+namespace
+{
+  using vix::utils::Result;
+
+  [[gnu::noinline]] Result<int, int> parse_result(int x)
+  {
+    if (x < 0)
+      return Result<int, int>::Err(x);
+    return Result<int, int>::Ok(x + 1);
+  }
+
+  [[gnu::noinline]] std::variant<int, unsigned> parse_variant(int x)
+  {
+    if (x < 0)
+      return std::variant<int, unsigned>(std::in_place_index<1>, static_cast<unsigned>(-x));
+    return std::variant<int, unsigned>(std::in_place_index<0>, x + 1);
+  }
+
+#if defined(__cpp_lib_expected)
+  [[gnu::noinline]] std::expected<int, int> parse_expected(int x)
+  {
+    if (x < 0)
+      return std::unexpected(x);
+    return x + 1;
+  }
+#endif
+
+  void BM_ResultReturn(benchmark::State &state)
+  {
+    int x = 0;
+    for (auto _ : state)
+    {
+      auto r = parse_result(x);
+      x = r.is_ok() ? r.value() & 0xFFFF : 0;
+      benchmark::DoNotOptimize(x);
+    }
+  }
+
+  void BM_VariantReturn(benchmark::State &state)
+  {
+    int x = 0;
+    for (auto _ : state)
+    {
+      auto r = parse_variant(x);
+      x = r.index() == 0 ? std::get<0>(r) & 0xFFFF : 0;
+      benchmark::DoNotOptimize(x);
+    }
+  }
+
+  void BM_ResultChain(benchmark::State &state)
+  {
+    int x = 0;
+    for (auto _ : state)
+    {
+      auto r = parse_result(x)
+                   .and_then(parse_result)
+                   .map([](int v)
+                        { return v & 0xFFFF; });
+      x = r.is_ok() ? r.value() : 0;
+      benchmark::DoNotOptimize(x);
+    }
+  }
+
+  void BM_ResultStringMap(benchmark::State &state)
+  {
+    const std::string payload(64, 'x');
+    for (auto _ : state)
+    {
+      auto r = Result<std::string>::Ok(payload)
+                   .map([](std::string &&s)
+                        { s.push_back('!'); return std::move(s); })
+                   .map([](std::string &&s)
+                        { return s.size(); });
+      benchmark::DoNotOptimize(r.value());
+    }
+  }
+
+  [[gnu::noinline]] Result<std::string, std::string> pass_through(Result<std::string, std::string> r)
+  {
+    return r;
+  }
+
+  // Move a string-carrying Result through a call and back out of it.
+  void BM_ResultMove(benchmark::State &state)
+  {
+    auto r = Result<std::string, std::string>::Ok(std::string(64, 'x'));
+    for (auto _ : state)
+    {
+      r = pass_through(std::move(r));
+      benchmark::DoNotOptimize(r);
+    }
+  }
+
+  void BM_ResultVectorCopy(benchmark::State &state)
+  {
+    std::vector<Result<int, int>> src;
+    src.reserve(static_cast<std::size_t>(state.range(0)));
+    for (int i = 0; i < state.range(0); ++i)
+      src.push_back(i % 7 ? Result<int, int>::Ok(i) : Result<int, int>::Err(i));
+
+    std::vector<Result<int, int>> dst(src);
+    for (auto _ : state)
+    {
+      dst = src;
+      benchmark::DoNotOptimize(dst.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * src.size()));
+  }
+
+#if defined(__cpp_lib_expected)
+  void BM_ExpectedReturn(benchmark::State &state)
+  {
+    int x = 0;
+    for (auto _ : state)
+    {
+      auto r = parse_expected(x);
+      x = r ? *r & 0xFFFF : 0;
+      benchmark::DoNotOptimize(x);
+    }
+  }
+
+  void BM_ExpectedChain(benchmark::State &state)
+  {
+    int x = 0;
+    for (auto _ : state)
+    {
+      auto r = parse_expected(x)
+                   .and_then(parse_expected)
+                   .transform([](int v)
+                              { return v & 0xFFFF; });
+      x = r ? *r : 0;
+      benchmark::DoNotOptimize(x);
+    }
+  }
+
+  void BM_ExpectedStringMap(benchmark::State &state)
+  {
+    const std::string payload(64, 'x');
+    for (auto _ : state)
+    {
+      auto r = std::expected<std::string, std::string>(payload)
+                   .transform([](std::string &&s)
+                              { s.push_back('!'); return std::move(s); })
+                   .transform([](std::string &&s)
+                              { return s.size(); });
+      benchmark::DoNotOptimize(*r);
+    }
+  }
+#endif
+} // namespace
+
+BENCHMARK(BM_ResultReturn);
+BENCHMARK(BM_VariantReturn);
+BENCHMARK(BM_ResultChain);
+BENCHMARK(BM_ResultStringMap);
+BENCHMARK(BM_ResultMove);
+BENCHMARK(BM_ResultVectorCopy)->Arg(4096);
+
+#if defined(__cpp_lib_expected)
+BENCHMARK(BM_ExpectedReturn);
+BENCHMARK(BM_ExpectedChain);
+BENCHMARK(BM_ExpectedStringMap);
+#endif
@@ -0,0 +1,72 @@
+/**
+ *
+ *  @file scope_guard_bench.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ * @brief Scope guard cost: inline ScopeGuardT, type-erased small-buffer and
+ * heap-allocated callables.
+ */
+#include <vix/utils/ScopeGuard.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+
+namespace
+{
+  void BM_ScopeGuardInline(benchmark::State &state)
+  {
+    int n = 0;
+    for (auto _ : state)
+    {
+      auto g = vix::utils::make_scope_guard([&]
+                                            { ++n; });
+      benchmark::DoNotOptimize(n);
+    }
+  }
+
+  void BM_ScopeExitMacro(benchmark::State &state)
+  {
+    int n = 0;
+    for (auto _ : state)
+    {
+      VIX_SCOPE_EXIT { ++n; };
+      benchmark::DoNotOptimize(n);
+    }
+  }
+
+  void BM_ScopeGuardErasedSmall(benchmark::State &state)
+  {
+    int n = 0;
+    for (auto _ : state)
+    {
+      vix::utils::ScopeGuard g([&]
+                               { ++n; });
+      benchmark::DoNotOptimize(n);
+    }
+  }
+
+  void BM_ScopeGuardErasedLarge(benchmark::State &state)
+  {
+    int n = 0;
+    std::array<int, 16> pad{};
+    for (auto _ : state)
+    {
+      vix::utils::ScopeGuard g([&n, pad]
+                               { n += pad[0] + 1; });
+      benchmark::DoNotOptimize(n);
+    }
+  }
+} // namespace
+
+BENCHMARK(BM_ScopeGuardInline);
+BENCHMARK(BM_ScopeExitMacro);
+BENCHMARK(BM_ScopeGuardErasedSmall);
+BENCHMARK(BM_ScopeGuardErasedLarge);
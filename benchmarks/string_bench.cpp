@@ -0,0 +1,263 @@
+/**
+ *
+ *  @file string_bench.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ * @brief Throughput of the string helpers (JSON escaping, ASCII case and trim,
+ *        splitting, URL and query decoding).
+ *
+ * The payload is mostly clean text with a few escapes every ~170 bytes,
+ * like a JSON log field carrying a request body.
+ */
+#include <vix/utils/String.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+namespace
+{
+  std::string payload(std::size_t n)
+  {
+    std::string s;
+    s.reserve(n);
+    for (std::size_t i = 0; s.size() < n; ++i)
+    {
+      s += "GET /api/v1/items?page=3&sort=desc HTTP/1.1 user-agent: curl/8.5 accept: */* ";
+      if (i % 2 == 1)
+        s += "\"quoted\"\n";
+    }
+    s.resize(n);
+    return s;
+  }
+
+  void BM_JsonEscape(benchmark::State &state)
+  {
+    const std::string in = payload(static_cast<std::size_t>(state.range(0)));
+    std::string out;
+    out.reserve(in.size() * 2);
+
+    for (auto _ : state)
+    {
+      out.clear();
+      vix::utils::json_escape_to(out, in);
+      benchmark::DoNotOptimize(out.data());
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * in.size()));
+  }
+
+  void BM_JsonScanScalar(benchmark::State &state)
+  {
+    const std::string in(static_cast<std::size_t>(state.range(0)), 'x');
+
+    for (auto _ : state)
+      benchmark::DoNotOptimize(
+          vix::utils::simd::find_json_escape_scalar(in.data(), in.data() + in.size()));
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * in.size()));
+  }
+
+  void BM_JsonScan(benchmark::State &state)
+  {
+    const std::string in(static_cast<std::size_t>(state.range(0)), 'x');
+
+    for (auto _ : state)
+      benchmark::DoNotOptimize(
+          vix::utils::simd::find_json_escape(in.data(), in.data() + in.size()));
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * in.size()));
+  }
+
+  void BM_ToLowerScalar(benchmark::State &state)
+  {
+    const std::string in = payload(static_cast<std::size_t>(state.range(0)));
+    std::string buf = in;
+
+    for (auto _ : state)
+    {
+      buf.assign(in);
+      vix::utils::simd::to_lower_ascii_scalar(buf.data(), buf.data() + buf.size());
+      benchmark::DoNotOptimize(buf.data());
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * in.size()));
+  }
+
+  void BM_ToLowerInplace(benchmark::State &state)
+  {
+    const std::string in = payload(static_cast<std::size_t>(state.range(0)));
+    std::string buf = in;
+
+    for (auto _ : state)
+    {
+      buf.assign(in);
+      vix::utils::to_lower_inplace(buf);
+      benchmark::DoNotOptimize(buf.data());
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * in.size()));
+  }
+
+  // Header-name lookup: compare each incoming name against a known one.
+  const std::string_view kHeaderNames[] = {
+      "Host", "User-Agent", "Accept", "Accept-Encoding", "Content-Type",
+      "Content-Length", "Connection", "X-Request-Id"};
+
+  void BM_IequalsHeaderNames(benchmark::State &state)
+  {
+    for (auto _ : state)
+    {
+      int hits = 0;
+      for (std::string_view name : kHeaderNames)
+        hits += vix::utils::iequals(name, "content-type");
+      benchmark::DoNotOptimize(hits);
+    }
+  }
+
+  void BM_IequalsLong(benchmark::State &state)
+  {
+    const std::string a = payload(static_cast<std::size_t>(state.range(0)));
+    const std::string b = vix::utils::to_lower(a);
+
+    for (auto _ : state)
+      benchmark::DoNotOptimize(vix::utils::iequals(a, b));
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * a.size()));
+  }
+
+  void BM_TrimCopy(benchmark::State &state)
+  {
+    const std::string in = "   text/html; charset=utf-8 \t";
+    for (auto _ : state)
+      benchmark::DoNotOptimize(vix::utils::trim(in));
+  }
+
+  void BM_TrimView(benchmark::State &state)
+  {
+    const std::string in = "   text/html; charset=utf-8 \t";
+    for (auto _ : state)
+      benchmark::DoNotOptimize(vix::utils::trim_view(in));
+  }
+
+  // Cookie-header shaped input: "k0=v0; k1=v1; ..."
+  std::string cookie_header()
+  {
+    std::string s;
+    for (int i = 0; i < 12; ++i)
+    {
+      if (i)
+        s += "; ";
+      s += "session_key" + std::to_string(i) + "=value" + std::to_string(i * 7919);
+    }
+    return s;
+  }
+
+  void BM_Split(benchmark::State &state)
+  {
+    const std::string in = cookie_header();
+    for (auto _ : state)
+    {
+      std::size_t total = 0;
+      for (const auto &part : vix::utils::split(in, ';'))
+        total += part.size();
+      benchmark::DoNotOptimize(total);
+    }
+  }
+
+  void BM_SplitView(benchmark::State &state)
+  {
+    const std::string in = cookie_header();
+    for (auto _ : state)
+    {
+      std::size_t total = 0;
+      for (std::string_view part : vix::utils::split_view(in, ';'))
+        total += part.size();
+      benchmark::DoNotOptimize(total);
+    }
+  }
+
+  void BM_Tokenize(benchmark::State &state)
+  {
+    const std::string in = cookie_header();
+    for (auto _ : state)
+    {
+      std::size_t total = 0;
+      for (std::string_view part : vix::utils::tokenize(in, "; "))
+        total += part.size();
+      benchmark::DoNotOptimize(total);
+    }
+  }
+
+  // Search-API shaped query value.
+  const std::string kQuery =
+      "q=red+running+shoes%20size%2042&brand=acme%2Csprint&price_min=20&price_max=120"
+      "&sort=relevance&filters=color%3Ared%7Cmaterial%3Amesh&page=2&lang=en-US";
+
+  void BM_UrlDecode(benchmark::State &state)
+  {
+    for (auto _ : state)
+      benchmark::DoNotOptimize(vix::utils::url_decode(kQuery));
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * kQuery.size()));
+  }
+
+  void BM_UrlDecodeInto(benchmark::State &state)
+  {
+    std::string out;
+    for (auto _ : state)
+    {
+      vix::utils::url_decode_into(kQuery, out);
+      benchmark::DoNotOptimize(out.data());
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * kQuery.size()));
+  }
+
+  // Handlers typically read two or three of the parameters.
+  void BM_ParseQueryMap(benchmark::State &state)
+  {
+    for (auto _ : state)
+    {
+      const auto m = vix::utils::parse_query_string(kQuery);
+      benchmark::DoNotOptimize(m.find("q")->second.size() + m.find("page")->second.size());
+    }
+  }
+
+  void BM_QueryView(benchmark::State &state)
+  {
+    std::string term;
+    for (auto _ : state)
+    {
+      const vix::utils::QueryView q(kQuery);
+      q.get_into("q", term);
+      benchmark::DoNotOptimize(term.size() + q.raw("page").size());
+    }
+  }
+
+  void BM_DecodedQuery(benchmark::State &state)
+  {
+    for (auto _ : state)
+    {
+      const vix::utils::DecodedQuery q(kQuery);
+      benchmark::DoNotOptimize(q.get("q").size() + q.get("page").size());
+    }
+  }
+} // namespace
+
+BENCHMARK(BM_JsonEscape)->Arg(64)->Arg(4096);
+BENCHMARK(BM_JsonScanScalar)->Arg(64)->Arg(4096);
+BENCHMARK(BM_JsonScan)->Arg(64)->Arg(4096);
+BENCHMARK(BM_ToLowerScalar)->Arg(16)->Arg(4096);
+BENCHMARK(BM_ToLowerInplace)->Arg(16)->Arg(4096);
+BENCHMARK(BM_IequalsHeaderNames);
+BENCHMARK(BM_IequalsLong)->Arg(4096);
+BENCHMARK(BM_TrimCopy);
+BENCHMARK(BM_TrimView);
+BENCHMARK(BM_Split);
+BENCHMARK(BM_SplitView);
+BENCHMARK(BM_Tokenize);
+BENCHMARK(BM_UrlDecode);
+BENCHMARK(BM_UrlDecodeInto);
+BENCHMARK(BM_ParseQueryMap);
+BENCHMARK(BM_QueryView);
+BENCHMARK(BM_DecodedQuery);
@@ -0,0 +1,140 @@
+/**
+ *
+ *  @file time_bench.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ * @brief Cost of the clocks and of rendering the HTTP Date header.
+ *
+ * The iostream baseline is what rfc1123_now() did before the date cache.
+ */
+#include <vix/utils/Time.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+  void BM_Rfc1123Iostream(benchmark::State &state)
+  {
+    for (auto _ : state)
+    {
+      const std::tm tm = vix::utils::utc_tm(std::time(nullptr));
+      std::ostringstream os;
+      os << std::put_time(&tm, "%a, %d %b %Y %H:%M:%S GMT");
+      benchmark::DoNotOptimize(os.str());
+    }
+  }
+
+  void BM_Rfc1123Now(benchmark::State &state)
+  {
+    for (auto _ : state)
+      benchmark::DoNotOptimize(vix::utils::rfc1123_now());
+  }
+
+  void BM_Rfc1123NowView(benchmark::State &state)
+  {
+    for (auto _ : state)
+      benchmark::DoNotOptimize(vix::utils::rfc1123_now_view().data());
+  }
+
+  void BM_Iso8601Now(benchmark::State &state)
+  {
+    for (auto _ : state)
+      benchmark::DoNotOptimize(vix::utils::iso8601_now());
+  }
+
+  void BM_Iso8601NowView(benchmark::State &state)
+  {
+    for (auto _ : state)
+      benchmark::DoNotOptimize(vix::utils::iso8601_now_view().data());
+  }
+
+  void BM_Rfc1123Cached(benchmark::State &state)
+  {
+    char buf[vix::utils::kRfc1123Size];
+    for (auto _ : state)
+    {
+      vix::utils::rfc1123_cached(buf);
+      benchmark::DoNotOptimize(buf);
+    }
+  }
+
+  void BM_FormatRfc1123(benchmark::State &state)
+  {
+    char buf[vix::utils::kRfc1123Size];
+    std::time_t t = std::time(nullptr);
+    for (auto _ : state)
+    {
+      vix::utils::format_rfc1123(t++, buf);
+      benchmark::DoNotOptimize(buf);
+    }
+  }
+
+  void BM_FormatIso8601(benchmark::State &state)
+  {
+    char buf[vix::utils::kIso8601Size];
+    std::time_t t = std::time(nullptr);
+    for (auto _ : state)
+    {
+      vix::utils::format_iso8601(t++, buf);
+      benchmark::DoNotOptimize(buf);
+    }
+  }
+
+  void BM_NowMs(benchmark::State &state)
+  {
+    for (auto _ : state)
+      benchmark::DoNotOptimize(vix::utils::now_ms());
+  }
+
+  void BM_CoarseNowMs(benchmark::State &state)
+  {
+    for (auto _ : state)
+      benchmark::DoNotOptimize(vix::utils::coarse_now_ms());
+  }
+
+  void BM_CoarseClockTicker(benchmark::State &state)
+  {
+    auto &clock = vix::utils::CoarseClock::instance();
+    clock.start();
+    for (auto _ : state)
+      benchmark::DoNotOptimize(clock.now_ms());
+    clock.stop();
+  }
+
+  void BM_SteadyNs(benchmark::State &state)
+  {
+    for (auto _ : state)
+      benchmark::DoNotOptimize(vix::utils::TscClock::steady_ns());
+  }
+
+  void BM_FastNowNs(benchmark::State &state)
+  {
+    vix::utils::fast_now_ns();
+    for (auto _ : state)
+      benchmark::DoNotOptimize(vix::utils::fast_now_ns());
+  }
+} // namespace
+
+BENCHMARK(BM_Rfc1123Iostream);
+BENCHMARK(BM_Rfc1123Now);
+BENCHMARK(BM_Rfc1123NowView);
+BENCHMARK(BM_Iso8601Now);
+BENCHMARK(BM_Iso8601NowView);
+BENCHMARK(BM_Rfc1123Cached)->Threads(1)->Threads(4);
+BENCHMARK(BM_FormatRfc1123);
+BENCHMARK(BM_FormatIso8601);
+BENCHMARK(BM_NowMs);
+BENCHMARK(BM_CoarseNowMs);
+BENCHMARK(BM_CoarseClockTicker);
+BENCHMARK(BM_SteadyNs);
+BENCHMARK(BM_FastNowNs);
@@ -0,0 +1,87 @@
+/**
+ *
+ *  @file uuid_bench.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ * @brief UUID generation cost: string API, value type, batch, secure engine and v7.
+ */
+#include <vix/utils/UUID.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+namespace
+{
+  void BM_Uuid4String(benchmark::State &state)
+  {
+    for (auto _ : state)
+      benchmark::DoNotOptimize(vix::utils::uuid4());
+  }
+
+  void BM_UuidV4ToChars(benchmark::State &state)
+  {
+    char buf[vix::utils::Uuid::kStringSize];
+    for (auto _ : state)
+    {
+      vix::utils::Uuid::v4().to_chars(buf);
+      benchmark::DoNotOptimize(buf);
+    }
+  }
+
+  void BM_UuidV4SecureToChars(benchmark::State &state)
+  {
+    char buf[vix::utils::Uuid::kStringSize];
+    for (auto _ : state)
+    {
+      vix::utils::Uuid::v4_secure().to_chars(buf);
+      benchmark::DoNotOptimize(buf);
+    }
+  }
+
+  void BM_Uuid4Batch(benchmark::State &state)
+  {
+    std::vector<vix::utils::Uuid> ids(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+      vix::utils::uuid4_batch(ids);
+      benchmark::DoNotOptimize(ids.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * ids.size()));
+  }
+
+  void BM_UuidV7ToChars(benchmark::State &state)
+  {
+    char buf[vix::utils::Uuid::kStringSize];
+    for (auto _ : state)
+    {
+      vix::utils::Uuid::v7().to_chars(buf);
+      benchmark::DoNotOptimize(buf);
+    }
+  }
+
+  void BM_Uuid7Batch(benchmark::State &state)
+  {
+    std::vector<vix::utils::Uuid> ids(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+      vix::utils::uuid7_batch(ids);
+      benchmark::DoNotOptimize(ids.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * ids.size()));
+  }
+} // namespace
+
+BENCHMARK(BM_Uuid4String);
+BENCHMARK(BM_UuidV4ToChars);
+BENCHMARK(BM_UuidV4SecureToChars);
+BENCHMARK(BM_Uuid4Batch)->Arg(1024);
+BENCHMARK(BM_UuidV7ToChars);
+BENCHMARK(BM_Uuid7Batch)->Arg(1024);
@@ -0,0 +1,132 @@
+/**
+ *
+ *  @file validation_bench.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ * @brief validate_map versus CompiledSchema on a typical signup form, and
+ *        validate_batch on a columnar import.
+ */
+#include <vix/utils/Validation.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+  using Form = std::unordered_map<std::string, std::string>;
+
+  vix::utils::Schema signup_schema()
+  {
+    using namespace vix::utils;
+    return Schema{
+        {"name", required("Name")},
+        {"age", num_range(18, 120, "Age")},
+        {"email", match(R"(^[^@\s]+@[^@\s]+\.[^@\s]+$)", "Email")},
+        {"username", match(R"([a-z][a-z0-9_]{2,15})", "Username")},
+        {"zip", match(R"(\d{5}(-\d{4})?)", "Zip")}};
+  }
+
+  Form valid_form()
+  {
+    return Form{{"name", "Ada Lovelace"},
+                {"age", "36"},
+                {"email", "ada.lovelace@example.com"},
+                {"username", "ada_1815"},
+                {"zip", "12345-6789"}};
+  }
+
+  Form invalid_form()
+  {
+    Form f = valid_form();
+    f["age"] = "12";
+    f["email"] = "ada@";
+    return f;
+  }
+
+  void BM_ValidateMap(benchmark::State &state)
+  {
+    const auto schema = signup_schema();
+    const Form form = state.range(0) ? valid_form() : invalid_form();
+    for (auto _ : state)
+      benchmark::DoNotOptimize(vix::utils::validate_map(form, schema).is_ok());
+  }
+
+  void BM_CompiledSchema(benchmark::State &state)
+  {
+    const vix::utils::CompiledSchema schema(signup_schema());
+    const Form form = state.range(0) ? valid_form() : invalid_form();
+    for (auto _ : state)
+      benchmark::DoNotOptimize(schema.validate(form).is_ok());
+  }
+
+  void BM_CompiledSchemaFailFast(benchmark::State &state)
+  {
+    const vix::utils::CompiledSchema schema(signup_schema());
+    const Form form = invalid_form();
+    for (auto _ : state)
+      benchmark::DoNotOptimize(schema.validate(form, vix::utils::ValidationMode::FailFast).is_ok());
+  }
+
+  void BM_CompiledSchemaIsValid(benchmark::State &state)
+  {
+    const vix::utils::CompiledSchema schema(signup_schema());
+    const Form form = valid_form();
+    for (auto _ : state)
+      benchmark::DoNotOptimize(schema.is_valid(form));
+  }
+
+  void BM_ValidateMapPerRow(benchmark::State &state)
+  {
+    const auto schema = signup_schema();
+    const Form row = valid_form();
+    const auto rows = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state)
+    {
+      std::size_t ok = 0;
+      for (std::size_t i = 0; i < rows; ++i)
+        ok += vix::utils::validate_map(row, schema).is_ok();
+      benchmark::DoNotOptimize(ok);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * rows));
+  }
+
+  void BM_ValidateBatch(benchmark::State &state)
+  {
+    const vix::utils::CompiledSchema schema(signup_schema());
+    const Form row = valid_form();
+    const auto rows = static_cast<std::size_t>(state.range(0));
+
+    std::vector<std::vector<std::string_view>> values;
+    std::vector<vix::utils::ColumnView> columns;
+    values.reserve(row.size());
+    for (const auto &[key, value] : row)
+    {
+      values.emplace_back(rows, std::string_view(value));
+      columns.push_back({key, values.back()});
+    }
+
+    vix::utils::BatchOptions opts;
+    opts.threads = static_cast<std::size_t>(state.range(1));
+    for (auto _ : state)
+      benchmark::DoNotOptimize(vix::utils::validate_batch(schema, columns, opts).ok());
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * rows));
+  }
+} // namespace
+
+BENCHMARK(BM_ValidateMap)->ArgName("valid")->Arg(1)->Arg(0);
+BENCHMARK(BM_CompiledSchema)->ArgName("valid")->Arg(1)->Arg(0);
+BENCHMARK(BM_CompiledSchemaFailFast);
+BENCHMARK(BM_CompiledSchemaIsValid);
+BENCHMARK(BM_ValidateMapPerRow)->Arg(10000);
+BENCHMARK(BM_ValidateBatch)->ArgNames({"rows", "threads"})->Args({10000, 1})->Args({100000, 1})->Args({100000, 0});
@@ -16,8 +16,9 @@
 #ifndef VIX_CONSOLE_MUTEX_HPP
 #define VIX_CONSOLE_MUTEX_HPP
 
-#include <mutex>
+#include <atomic>
 #include <condition_variable>
+#include <mutex>
 
 namespace vix::utils
 {
@@ -26,6 +27,12 @@ namespace vix::utils
    *
    * This mutex can be used to ensure that log lines, banners,
    * or other console writes do not interleave across threads.
+   * ConsoleWriter takes it around each batch it writes, so code that
+   * prints directly while holding it stays ordered with queued output.
+   *
+   * @warning Do not log or call console_write()/console_flush() while
+   * holding it: those may wait for the writer thread, which needs this
+   * mutex to make progress.
    *
    * @return Reference to the global console mutex.
    */
@@ -38,8 +45,8 @@ namespace vix::utils
   /**
    * @brief Mutex protecting banner-related state.
    *
-   * This mutex guards access to the banner completion flag
-   * and coordinates threads waiting for banner output.
+   * Only used on the slow path: threads that find the banner in
+   * progress wait on console_cv() under this mutex.
    *
    * @return Reference to the banner mutex.
    */
@@ -67,26 +74,32 @@ namespace vix::utils
    * @brief Flag indicating whether the console banner is done.
    *
    * When true, threads waiting for the banner may proceed.
+   * Atomic so that console_wait_banner() can check it without
+   * taking banner_mutex().
    *
    * @return Reference to the banner completion flag.
    */
-  inline bool &console_banner_done()
+  inline std::atomic<bool> &console_banner_done()
   {
-    static bool done = true;
+    static std::atomic<bool> done{true};
     return done;
   }
 
   /**
    * @brief Block until the console banner has completed.
    *
-   * This function waits on the banner condition variable
-   * until console_banner_done() becomes true.
+   * Once the banner is done this is a single acquire load; only a
+   * thread arriving while the banner is being printed takes
+   * banner_mutex() and waits on the condition variable.
    */
   inline void console_wait_banner()
   {
+    if (console_banner_done().load(std::memory_order_acquire))
+      return;
+
     std::unique_lock<std::mutex> lk(banner_mutex());
     console_cv().wait(lk, []
-                      { return console_banner_done(); });
+                      { return console_banner_done().load(std::memory_order_acquire); });
   }
 
   /**
@@ -98,7 +111,7 @@ namespace vix::utils
   {
     {
       std::lock_guard<std::mutex> lk(banner_mutex());
-      console_banner_done() = true;
+      console_banner_done().store(true, std::memory_order_release);
     }
     console_cv().notify_all();
   }
@@ -113,7 +126,7 @@ namespace vix::utils
   inline void console_reset_banner()
   {
     std::lock_guard<std::mutex> lk(banner_mutex());
-    console_banner_done() = false;
+    console_banner_done().store(false, std::memory_order_release);
   }
 
 } // namespace vix::utils
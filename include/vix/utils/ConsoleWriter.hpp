@@ -0,0 +1,164 @@
+/**
+ *
+ *  @file ConsoleWriter.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_UTILS_CONSOLE_WRITER_HPP
+#define VIX_UTILS_CONSOLE_WRITER_HPP
+
+/**
+ * @brief Single writer thread for console output.
+ *
+ * Producers (Logger lines with VIX_CONSOLE_SYNC, the runtime banner) copy
+ * their text into a bounded lock-free queue and return; one background
+ * thread drains it in order and writes each batch to stdout/stderr with a
+ * single fwrite + fflush, holding console_mutex() only around the write.
+ * Lines therefore never interleave and no producer waits on terminal I/O.
+ *
+ * A producer only waits when the queue is full (backpressure), so it must
+ * not hold console_mutex() while writing. After stop(), which also runs at
+ * exit, writes go straight to the stream.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace vix::utils
+{
+  /**
+   * @brief Destination stream of a console write.
+   */
+  enum class ConsoleStream : std::uint8_t
+  {
+    Out, ///< stdout
+    Err  ///< stderr
+  };
+
+  /**
+   * @class ConsoleWriter
+   * @brief Process-wide console writer fed by a bounded MPSC queue.
+   *
+   * The thread starts on the first write. Queue slots keep their string
+   * capacity, so steady-state writes do not allocate. The instance is never
+   * destroyed, so it stays usable from other static destructors.
+   */
+  class ConsoleWriter
+  {
+  public:
+    /// Number of queued writes before producers wait for the writer.
+    static constexpr std::size_t kCapacity = 1024;
+
+    /**
+     * @brief Process-wide instance.
+     */
+    static ConsoleWriter &instance();
+
+    ConsoleWriter(const ConsoleWriter &) = delete;
+    ConsoleWriter &operator=(const ConsoleWriter &) = delete;
+
+    /**
+     * @brief Queue `text` for `stream`; it is written verbatim, in order.
+     *
+     * Waits while the queue is full, so the caller must not hold
+     * console_mutex(): the writer thread takes it to drain the queue.
+     */
+    void write(ConsoleStream stream, std::string_view text);
+
+    /**
+     * @brief Block until every write queued before this call is on the stream.
+     *
+     * Same rule as write(): do not call it while holding console_mutex().
+     */
+    void flush();
+
+    /**
+     * @brief Drain the queue and stop the thread; later writes are direct.
+     */
+    void stop();
+
+    /**
+     * @brief True while the writer thread is running.
+     */
+    bool running() const noexcept
+    {
+      return state_.load(std::memory_order_acquire) == kRunning;
+    }
+
+    /**
+     * @brief Number of queued writes handed to the streams so far.
+     */
+    std::uint64_t written() const noexcept
+    {
+      return done_.load(std::memory_order_acquire);
+    }
+
+  private:
+    enum State : int
+    {
+      kIdle,
+      kRunning,
+      kStopped
+    };
+
+    struct Slot
+    {
+      std::atomic<std::uint64_t> seq{0};
+      ConsoleStream stream = ConsoleStream::Out;
+      std::string text;
+    };
+
+    ConsoleWriter();
+    ~ConsoleWriter();
+
+    bool ensureStarted();
+    void run();
+    void wake() noexcept;
+    static void writeDirect(ConsoleStream stream, std::string_view text);
+
+    std::unique_ptr<Slot[]> slots_;
+    alignas(64) std::atomic<std::uint64_t> tail_{0};
+    alignas(64) std::uint64_t head_ = 0;
+    std::atomic<std::uint64_t> done_{0};
+    std::atomic<std::uint32_t> wake_{0};
+    std::atomic<bool> sleeping_{false};
+    std::atomic<int> inflight_{0}; // producers between the state check and publishing
+    std::atomic<int> state_{kIdle};
+    std::mutex control_;
+    std::thread thread_;
+  };
+
+  /**
+   * @brief Queue console output through ConsoleWriter::instance().
+   */
+  inline void console_write(ConsoleStream stream, std::string_view text)
+  {
+    ConsoleWriter::instance().write(stream, text);
+  }
+
+  /**
+   * @brief Wait until queued console output has been written.
+   */
+  inline void console_flush()
+  {
+    ConsoleWriter::instance().flush();
+  }
+
+} // namespace vix::utils
+
+#endif // VIX_UTILS_CONSOLE_WRITER_HPP
@@ -0,0 +1,414 @@
+/**
+ *
+ *  @file DeferredLog.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_UTILS_DEFERRED_LOG_HPP
+#define VIX_UTILS_DEFERRED_LOG_HPP
+
+/**
+ * @brief Deferred (binary) log records for the async Logger backend.
+ *
+ * In deferred mode the producer does not run fmt. It copies the format
+ * string, the module and the arguments into a compact record in its own
+ * ring, and the backend thread decodes the record, formats it and writes
+ * it to the sinks.
+ *
+ * Arguments are captured by value when they are arithmetic, and as bytes
+ * when they are strings (std::string, std::string_view, C strings). Calls
+ * with any other argument type are formatted eagerly on the caller and
+ * shipped as text, so every call site keeps working.
+ *
+ * Used through Logger::AsyncOptions (deferred / thread_rings); not meant
+ * to be used directly.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#if defined(SPDLOG_FMT_EXTERNAL)
+#include <fmt/format.h>
+#else
+#include <spdlog/fmt/bundled/format.h>
+#endif
+
+namespace vix::utils::deferred
+{
+  /**
+   * @brief Decodes a record's arguments and formats them into out.
+   */
+  using DecodeFn = void (*)(const std::byte *args,
+                            std::string_view fmtstr,
+                            fmt::memory_buffer &out);
+
+  /**
+   * @brief How one argument type is stored in a record.
+   *
+   * The primary template marks the type as not deferrable.
+   */
+  template <typename T, typename = void>
+  struct ArgCodec
+  {
+    static constexpr bool deferrable = false;
+  };
+
+  /**
+   * @brief Arithmetic values are copied as-is.
+   */
+  template <typename T>
+  struct ArgCodec<T, std::enable_if_t<std::is_arithmetic_v<T>>>
+  {
+    static constexpr bool deferrable = true;
+    using view_type = T;
+
+    static std::size_t size(const T &) noexcept { return sizeof(T); }
+
+    static std::byte *write(std::byte *p, const T &v) noexcept
+    {
+      std::memcpy(p, &v, sizeof(T));
+      return p + sizeof(T);
+    }
+
+    static const std::byte *read(const std::byte *p, view_type &v) noexcept
+    {
+      std::memcpy(&v, p, sizeof(T));
+      return p + sizeof(T);
+    }
+  };
+
+  /**
+   * @brief Strings are copied as a length prefix followed by the bytes.
+   */
+  struct StringCodec
+  {
+    static constexpr bool deferrable = true;
+    using view_type = std::string_view;
+
+    static std::size_t size(std::string_view s) noexcept
+    {
+      return sizeof(std::uint32_t) + s.size();
+    }
+
+    static std::byte *write(std::byte *p, std::string_view s) noexcept
+    {
+      const auto n = static_cast<std::uint32_t>(s.size());
+      std::memcpy(p, &n, sizeof(n));
+      if (n)
+        std::memcpy(p + sizeof(n), s.data(), n);
+      return p + sizeof(n) + n;
+    }
+
+    static const std::byte *read(const std::byte *p, view_type &v) noexcept
+    {
+      std::uint32_t n = 0;
+      std::memcpy(&n, p, sizeof(n));
+      v = std::string_view(reinterpret_cast<const char *>(p + sizeof(n)), n);
+      return p + sizeof(n) + n;
+    }
+  };
+
+  template <>
+  struct ArgCodec<std::string> : StringCodec
+  {
+  };
+
+  template <>
+  struct ArgCodec<std::string_view> : StringCodec
+  {
+  };
+
+  template <>
+  struct ArgCodec<const char *> : StringCodec
+  {
+    static std::size_t size(const char *s) noexcept
+    {
+      return StringCodec::size(s ? std::string_view(s) : std::string_view());
+    }
+
+    static std::byte *write(std::byte *p, const char *s) noexcept
+    {
+      return StringCodec::write(p, s ? std::string_view(s) : std::string_view());
+    }
+  };
+
+  template <>
+  struct ArgCodec<char *> : ArgCodec<const char *>
+  {
+  };
+
+  template <std::size_t N>
+  struct ArgCodec<char[N]> : ArgCodec<const char *>
+  {
+  };
+
+  template <std::size_t N>
+  struct ArgCodec<const char[N]> : ArgCodec<const char *>
+  {
+  };
+
+  /**
+   * @brief Codec for an argument as passed to a log call.
+   */
+  template <typename T>
+  using codec_t = ArgCodec<std::remove_cv_t<std::remove_reference_t<T>>>;
+
+  /**
+   * @brief Whether every argument type can be captured in a record.
+   */
+  template <typename... Args>
+  inline constexpr bool deferrable_v = (codec_t<Args>::deferrable && ...);
+
+  /**
+   * @brief Total bytes needed to store the arguments.
+   */
+  template <typename... Args>
+  std::size_t args_size(const Args &...args) noexcept
+  {
+    return (std::size_t{0} + ... + codec_t<Args>::size(args));
+  }
+
+  /**
+   * @brief Store the arguments at p (left to right).
+   */
+  template <typename... Args>
+  void write_args(std::byte *p, const Args &...args) noexcept
+  {
+    ((p = codec_t<Args>::write(p, args)), ...);
+  }
+
+  /**
+   * @brief Backend-side decoder for one argument pack, instantiated per call signature.
+   */
+  template <typename... Args>
+  void decode(const std::byte *p, std::string_view fmtstr, fmt::memory_buffer &out)
+  {
+    std::tuple<typename codec_t<Args>::view_type...> values{};
+
+    std::apply(
+        [&](auto &...v)
+        {
+          ((p = codec_t<Args>::read(p, v)), ...);
+          fmt::vformat_to(std::back_inserter(out), fmtstr, fmt::make_format_args(v...));
+        },
+        values);
+  }
+
+  /**
+   * @brief Fixed part of a record.
+   *
+   * The payload holds the format string (or the preformatted text when
+   * decode is null), then the module, then the encoded arguments.
+   */
+  struct RecordHeader
+  {
+    DecodeFn decode = nullptr;
+    std::int64_t time_ns = 0;
+    std::uint32_t fmt_size = 0;
+    std::uint32_t module_size = 0;
+    std::uint32_t args_size = 0;
+    std::uint8_t level = 0;
+    bool spilled = false;
+  };
+
+  /**
+   * @brief Log backend fed by per-thread SPSC rings and drained by one thread.
+   *
+   * Each producing thread gets its own byte ring the first time it logs
+   * (registered through a thread_local), so producers never share a cache
+   * line. The backend thread drains all rings, merging visible records by
+   * timestamp, and writes them through a synchronous logger.
+   *
+   * A ring whose thread has exited is drained before it is released, and
+   * the destructor drains every ring, so queued records are not lost.
+   * When a ring is full the producer either waits (block) or drops the
+   * record and counts it. Records larger than a quarter of the ring are
+   * spilled to the heap.
+   */
+  class DeferredBackend
+  {
+  public:
+    /**
+     * @brief Start the backend thread.
+     *
+     * @param ring_bytes Ring size per producing thread (rounded up to a power of two).
+     * @param block Wait for space instead of dropping when a ring is full.
+     * @param defer_format Capture arguments and format on the backend;
+     *        when false, submit() formats on the caller.
+     * @param logger Synchronous logger the backend writes through.
+     * @param console_sync Hold records back while the runtime banner prints.
+     * @param cpu CPU to pin the backend thread to, -1 for none.
+     */
+    DeferredBackend(std::size_t ring_bytes,
+                    bool block,
+                    bool defer_format,
+                    std::shared_ptr<spdlog::logger> logger,
+                    bool console_sync,
+                    int cpu);
+
+    /**
+     * @brief Drain every ring, then stop the backend thread.
+     */
+    ~DeferredBackend();
+
+    DeferredBackend(const DeferredBackend &) = delete;
+    DeferredBackend &operator=(const DeferredBackend &) = delete;
+
+    /**
+     * @brief Queue a call, deferring formatting when possible.
+     *
+     * @return False if the record was dropped.
+     */
+    template <typename... Args>
+    bool submit(spdlog::level::level_enum level,
+                std::string_view module,
+                fmt::format_string<Args...> fmtstr,
+                Args &&...args)
+    {
+      if constexpr (deferrable_v<Args...>)
+      {
+        if (defer_format_)
+        {
+          const fmt::string_view fsv = fmtstr;
+          const std::string_view f(fsv.data(), fsv.size());
+          const std::size_t asize = args_size(args...);
+
+          Reservation r;
+          if (!reserve(f.size() + module.size() + asize, r))
+            return false;
+
+          r.header->decode = &decode<Args...>;
+          r.header->fmt_size = static_cast<std::uint32_t>(f.size());
+          r.header->module_size = static_cast<std::uint32_t>(module.size());
+          r.header->args_size = static_cast<std::uint32_t>(asize);
+          r.header->level = static_cast<std::uint8_t>(level);
+
+          std::byte *p = r.payload;
+          std::memcpy(p, f.data(), f.size());
+          p += f.size();
+          if (!module.empty())
+            std::memcpy(p, module.data(), module.size());
+          p += module.size();
+          write_args(p, args...);
+
+          commit(r);
+          return true;
+        }
+      }
+
+      fmt::memory_buffer buf;
+      fmt::format_to(std::back_inserter(buf), fmtstr, std::forward<Args>(args)...);
+      return submitText(level, module, std::string_view(buf.data(), buf.size()));
+    }
+
+    /**
+     * @brief Queue preformatted text.
+     *
+     * @return False if the record was dropped.
+     */
+    bool submitText(spdlog::level::level_enum level,
+                    std::string_view module,
+                    std::string_view text);
+
+    /**
+     * @brief Wait until every record queued before the call has been written,
+     *        then flush the sinks.
+     */
+    void flush();
+
+    /**
+     * @brief Ring size per producing thread, in bytes.
+     */
+    std::size_t ringBytes() const noexcept { return ring_bytes_; }
+
+    /**
+     * @brief Records queued and not yet written, over all rings.
+     */
+    std::size_t depth() const;
+
+    /**
+     * @brief Number of registered producer rings.
+     */
+    std::size_t producers() const;
+
+    /**
+     * @brief Records dropped because a ring was full.
+     */
+    std::uint64_t dropped() const;
+
+  private:
+    struct Ring;
+    struct Cursor;
+
+    /**
+     * @brief Space claimed in the calling thread's ring.
+     */
+    struct Reservation
+    {
+      Ring *ring = nullptr;
+      std::size_t next_tail = 0;
+      RecordHeader *header = nullptr;
+      std::byte *payload = nullptr;
+    };
+
+    Ring &localRing();
+    bool reserve(std::size_t payload_size, Reservation &r);
+    void commit(const Reservation &r) noexcept;
+    void run();
+    std::size_t drain(std::vector<Cursor> &cursors);
+    void write(const RecordHeader &h, const std::byte *payload);
+
+    static std::int64_t now_ns() noexcept
+    {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                 spdlog::log_clock::now().time_since_epoch())
+          .count();
+    }
+
+    const std::uint64_t id_;
+    std::size_t ring_bytes_ = 0;
+    bool block_ = true;
+    bool defer_format_ = true;
+    bool console_sync_ = false;
+    std::shared_ptr<spdlog::logger> logger_;
+
+    mutable std::mutex rings_mutex_;
+    std::vector<std::shared_ptr<Ring>> rings_;
+    std::atomic<std::uint64_t> rings_version_{0};
+    std::uint64_t released_dropped_ = 0;
+
+    std::atomic<bool> sleeping_{false};
+    std::atomic<bool> stop_{false};
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+    fmt::memory_buffer line_;
+    std::thread worker_;
+  };
+
+} // namespace vix::utils::deferred
+
+#endif // VIX_UTILS_DEFERRED_LOG_HPP
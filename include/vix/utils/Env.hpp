@@ -17,8 +17,22 @@
 #include <string>
 #include <string_view>
 #include <cstdlib>
-#include <cctype>
 #include <charconv>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include <vix/utils/String.hpp>
+
+#if defined(__APPLE__)
+#include <crt_externs.h>
+#elif !defined(_WIN32)
+extern char **environ;
+#endif
 
 /**
  * @file VIX_ENV_HPP
@@ -44,8 +58,20 @@
  * double ratio  = env_double("CACHE_RATIO", 0.25);
  * @endcode
  *
+ * `EnvSnapshot` captures the whole environment once, with each value
+ * pre-parsed into the typed forms above, so repeated reads are a hash
+ * lookup. `env_snapshot()` is the process-wide instance (captured on first
+ * use, refreshed by `env_reload()`); the free functions also accept it as
+ * a first argument:
+ *
+ * @code
+ * const auto &env = env_snapshot();
+ * bool debug = env_bool(env, "APP_DEBUG", false);
+ * @endcode
+ *
  * @note Thread-safe for read-only access.
  * @note Works on POSIX and Windows.
+ * @note The free functions without a snapshot read the live environment.
  */
 
 namespace vix::utils
@@ -53,46 +79,54 @@ namespace vix::utils
   namespace detail
   {
     /**
-     * @brief Converts a character to lowercase (ASCII only).
-     * @param c The input character.
-     * @return Lowercase version of `c`.
+     * @brief `env_bool` rule on an already trimmed value.
      */
-    inline char to_lower_ascii(unsigned char c) noexcept
+    inline bool parse_env_bool(std::string_view v) noexcept
     {
-      return static_cast<char>(std::tolower(c));
+      return v == "1" || iequals(v, "true") || iequals(v, "yes") || iequals(v, "on");
     }
 
     /**
-     * @brief Performs a case-insensitive comparison between two strings (ASCII only).
-     * @param a First string.
-     * @param b Second string.
-     * @return `true` if equal ignoring case, otherwise `false`.
+     * @brief Whole-string base-10 integer parse; false on empty or garbage.
      */
-    inline bool iequals(std::string_view a, std::string_view b) noexcept
+    template <typename T>
+    inline bool parse_env_integer(std::string_view v, T &out) noexcept
     {
-      if (a.size() != b.size())
+      if (v.empty())
         return false;
-      for (std::size_t i = 0; i < a.size(); ++i)
-      {
-        if (to_lower_ascii(static_cast<unsigned char>(a[i])) !=
-            to_lower_ascii(static_cast<unsigned char>(b[i])))
-          return false;
-      }
+      T value{};
+      const auto [ptr, ec] = std::from_chars(v.data(), v.data() + v.size(), value, 10);
+      if (ec != std::errc{} || ptr != v.data() + v.size())
+        return false;
+      out = value;
       return true;
     }
 
-    inline std::string_view trim(std::string_view s) noexcept
+    /**
+     * @brief Whole-string `strtod` parse; false on empty or trailing characters.
+     */
+    inline bool parse_env_double(std::string_view v, double &out)
     {
-      std::size_t b = 0;
-      std::size_t e = s.size();
-
-      while (b < e && std::isspace(static_cast<unsigned char>(s[b])))
-        ++b;
-      while (e > b && std::isspace(static_cast<unsigned char>(s[e - 1])))
-        --e;
+      if (v.empty())
+        return false;
 
-      return std::string_view{s.data() + b, e - b};
+      const std::string tmp(v); // ensure null-terminated for strtod
+      char *endp = nullptr;
+      const double d = std::strtod(tmp.c_str(), &endp);
+      if (!endp || *endp != '\0')
+        return false;
+      out = d;
+      return true;
     }
+
+    struct StringHash
+    {
+      using is_transparent = void;
+      std::size_t operator()(std::string_view s) const noexcept
+      {
+        return std::hash<std::string_view>{}(s);
+      }
+    };
   } // namespace detail
 
   static inline const char *vix_getenv(const char *name) noexcept
@@ -155,12 +189,7 @@ namespace vix::utils
   {
     using namespace std::literals;
     const auto s = env_or(key, def ? "1"sv : "0"sv);
-    const std::string_view v = detail::trim(s);
-
-    return v == "1"sv ||
-           detail::iequals(v, "true") ||
-           detail::iequals(v, "yes") ||
-           detail::iequals(v, "on");
+    return detail::parse_env_bool(trim_view(s));
   }
   /**
    * @brief Reads an environment variable as a signed integer (base 10).
@@ -180,15 +209,8 @@ namespace vix::utils
   inline int env_int(std::string_view key, int def = 0)
   {
     const auto s = env_or(key);
-    const std::string_view v = detail::trim(s);
-    if (v.empty())
-      return def;
-
     int value = def;
-    const auto [ptr, ec] = std::from_chars(v.data(), v.data() + v.size(), value, 10);
-    if (ec != std::errc{} || ptr != v.data() + v.size())
-      return def;
-    return value;
+    return detail::parse_env_integer(trim_view(s), value) ? value : def;
   }
 
   /**
@@ -208,15 +230,8 @@ namespace vix::utils
   inline unsigned env_uint(std::string_view key, unsigned def = 0u)
   {
     const auto s = env_or(key);
-    const std::string_view v = detail::trim(s);
-    if (v.empty())
-      return def;
-
     unsigned value = def;
-    const auto [ptr, ec] = std::from_chars(v.data(), v.data() + v.size(), value, 10);
-    if (ec != std::errc{} || ptr != v.data() + v.size())
-      return def;
-    return value;
+    return detail::parse_env_integer(trim_view(s), value) ? value : def;
   }
 
   /**
@@ -236,18 +251,261 @@ namespace vix::utils
   inline double env_double(std::string_view key, double def = 0.0)
   {
     const auto s = env_or(key);
-    const std::string_view v = detail::trim(s);
-    if (v.empty())
-      return def;
+    double value = def;
+    return detail::parse_env_double(trim_view(s), value) ? value : def;
+  }
+
+  /**
+   * @brief Immutable copy of the environment with pre-parsed typed values.
+   *
+   * Built once from the process environment; every lookup is a hash probe
+   * with no allocation, trimming or parsing. Typed getters follow exactly
+   * the rules of the matching free functions (`env_bool`, `env_int`, ...).
+   * Later `setenv` calls are not seen until `reload()`.
+   *
+   * @code
+   * EnvSnapshot env;
+   * int port = env.get_int("PORT", 8080);
+   * @endcode
+   */
+  class EnvSnapshot
+  {
+  public:
+    /**
+     * @brief Capture the current process environment.
+     */
+    EnvSnapshot() { reload(); }
+
+    /**
+     * @brief Re-read the process environment into this snapshot.
+     *
+     * Not safe against concurrent readers of the same object; use
+     * `env_reload()` for the process-wide instance.
+     */
+    void reload()
+    {
+      vars_.clear();
+#if defined(_WIN32)
+      char **env = _environ;
+#elif defined(__APPLE__)
+      char **env = *_NSGetEnviron();
+#else
+      char **env = environ;
+#endif
+      for (; env && *env; ++env)
+      {
+        const std::string_view kv(*env);
+        // Windows keeps per-drive entries such as "=C:=C:\\"; skip the lead '='.
+        const std::size_t eq = kv.find('=', 1);
+        if (eq == std::string_view::npos)
+          continue;
+        vars_.try_emplace(std::string(kv.substr(0, eq)), kv.substr(eq + 1));
+      }
+    }
+
+    std::size_t size() const noexcept { return vars_.size(); }
+
+    /**
+     * @brief Whether both snapshots hold the same variables and values.
+     */
+    bool same_as(const EnvSnapshot &other) const noexcept
+    {
+      if (vars_.size() != other.vars_.size())
+        return false;
+      for (const auto &[key, value] : vars_)
+      {
+        const Value *v = other.find(key);
+        if (!v || v->raw != value.raw)
+          return false;
+      }
+      return true;
+    }
+
+    bool contains(std::string_view key) const noexcept { return find(key) != nullptr; }
+
+    /**
+     * @brief Raw value, or nullopt when unset.
+     */
+    std::optional<std::string_view> get(std::string_view key) const noexcept
+    {
+      if (const Value *v = find(key))
+        return std::string_view(v->raw);
+      return std::nullopt;
+    }
+
+    /**
+     * @brief Raw value, or `def` when unset (no allocation).
+     */
+    std::string_view view_or(std::string_view key, std::string_view def = {}) const noexcept
+    {
+      const Value *v = find(key);
+      return v ? std::string_view(v->raw) : def;
+    }
+
+    std::string get_or(std::string_view key, std::string_view def = "") const
+    {
+      return std::string(view_or(key, def));
+    }
+
+    bool get_bool(std::string_view key, bool def = false) const noexcept
+    {
+      const Value *v = find(key);
+      return v ? v->truthy : def;
+    }
+
+    int get_int(std::string_view key, int def = 0) const noexcept
+    {
+      const Value *v = find(key);
+      return v && v->has_int ? v->i : def;
+    }
+
+    unsigned get_uint(std::string_view key, unsigned def = 0u) const noexcept
+    {
+      const Value *v = find(key);
+      return v && v->has_uint ? v->u : def;
+    }
+
+    double get_double(std::string_view key, double def = 0.0) const noexcept
+    {
+      const Value *v = find(key);
+      return v && v->has_double ? v->d : def;
+    }
+
+  private:
+    struct Value
+    {
+      explicit Value(std::string_view s) : raw(s)
+      {
+        const std::string_view t = trim_view(raw);
+        truthy = detail::parse_env_bool(t);
+        has_int = detail::parse_env_integer(t, i);
+        has_uint = detail::parse_env_integer(t, u);
+        has_double = detail::parse_env_double(t, d);
+      }
+
+      std::string raw;
+      int i = 0;
+      unsigned u = 0;
+      double d = 0.0;
+      bool truthy = false;
+      bool has_int = false;
+      bool has_uint = false;
+      bool has_double = false;
+    };
+
+    const Value *find(std::string_view key) const noexcept
+    {
+      const auto it = vars_.find(key);
+      return it == vars_.end() ? nullptr : &it->second;
+    }
+
+    std::unordered_map<std::string, Value, detail::StringHash, std::equal_to<>> vars_;
+  };
+
+  namespace detail
+  {
+    /**
+     * @brief Holder of the process-wide snapshot.
+     *
+     * Readers take one acquire load. Replaced snapshots are kept alive so
+     * references handed out earlier stay valid; a reload that finds the
+     * environment unchanged keeps the current one, so only actual changes
+     * add a snapshot. Never destroyed, so static destructors may still read it.
+     */
+    struct EnvRegistry
+    {
+      std::atomic<const EnvSnapshot *> current{nullptr};
+      std::mutex mutex;
+      std::vector<std::unique_ptr<EnvSnapshot>> all;
+
+      static EnvRegistry &instance()
+      {
+        static EnvRegistry *r = new EnvRegistry();
+        return *r;
+      }
+
+      /**
+       * @brief Capture a new snapshot and make it current.
+       *
+       * @param keep_current Return the existing snapshot if there is one.
+       */
+      const EnvSnapshot &publish(bool keep_current)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (const EnvSnapshot *p = current.load(std::memory_order_acquire); p && keep_current)
+          return *p;
+        auto next = std::make_unique<EnvSnapshot>();
+        if (const EnvSnapshot *p = current.load(std::memory_order_acquire); p && next->same_as(*p))
+          return *p;
+        all.push_back(std::move(next));
+        current.store(all.back().get(), std::memory_order_release);
+        return *all.back();
+      }
+    };
+  } // namespace detail
+
+  /**
+   * @brief Process-wide environment snapshot, captured on first use.
+   */
+  inline const EnvSnapshot &env_snapshot()
+  {
+    auto &r = detail::EnvRegistry::instance();
+    if (const EnvSnapshot *p = r.current.load(std::memory_order_acquire))
+      return *p;
+    return r.publish(true);
+  }
+
+  /**
+   * @brief Recapture the process-wide snapshot (e.g. after `setenv`).
+   *
+   * Readers switch to the new snapshot on their next `env_snapshot()` call.
+   * Logger::setAsync, Logger::setPattern and
+   * RuntimeBanner::emit_server_ready call it, so variables changed before
+   * those points are picked up; call it directly after other `setenv` calls.
+   */
+  inline const EnvSnapshot &env_reload()
+  {
+    return detail::EnvRegistry::instance().publish(false);
+  }
+
+  /**
+   * @brief `env_or` served from a snapshot.
+   */
+  inline std::string env_or(const EnvSnapshot &env, std::string_view key, std::string_view def = "")
+  {
+    return env.get_or(key, def);
+  }
 
-    const std::string tmp(v); // ensure null-terminated for strtod
-    char *endp = nullptr;
-    const double out = std::strtod(tmp.c_str(), &endp);
+  /**
+   * @brief `env_bool` served from a snapshot.
+   */
+  inline bool env_bool(const EnvSnapshot &env, std::string_view key, bool def = false) noexcept
+  {
+    return env.get_bool(key, def);
+  }
 
-    if (!endp || *endp != '\0')
-      return def;
+  /**
+   * @brief `env_int` served from a snapshot.
+   */
+  inline int env_int(const EnvSnapshot &env, std::string_view key, int def = 0) noexcept
+  {
+    return env.get_int(key, def);
+  }
 
-    return out;
+  /**
+   * @brief `env_uint` served from a snapshot.
+   */
+  inline unsigned env_uint(const EnvSnapshot &env, std::string_view key, unsigned def = 0u) noexcept
+  {
+    return env.get_uint(key, def);
+  }
+
+  /**
+   * @brief `env_double` served from a snapshot.
+   */
+  inline double env_double(const EnvSnapshot &env, std::string_view key, double def = 0.0) noexcept
+  {
+    return env.get_double(key, def);
   }
 
 } // namespace Vix::utils
@@ -0,0 +1,180 @@
+/**
+ *
+ *  @file FileSink.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_UTILS_FILE_SINK_HPP
+#define VIX_UTILS_FILE_SINK_HPP
+
+/**
+ * @brief Batched, rotating file sink for Logger.
+ *
+ * Formatted records are appended to an in-memory batch and written with a
+ * single write call when the batch fills up, on flush, or from the
+ * background thread every flush_interval. The file rotates by size and/or
+ * on fixed UTC time boundaries; rotated segments are renamed with a
+ * timestamp and can be gzip-compressed on the background thread (when
+ * built with zlib).
+ *
+ * Usually configured through Logger::setFile or the VIX_LOG_FILE and
+ * VIX_LOG_ROTATE_* environment variables.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <spdlog/details/log_msg.h>
+#include <spdlog/sinks/base_sink.h>
+
+namespace vix::utils
+{
+  /**
+   * @brief spdlog sink writing batches to a rotating file.
+   */
+  class BatchedFileSink final : public spdlog::sinks::base_sink<std::mutex>
+  {
+  public:
+    /**
+     * @brief File output configuration.
+     */
+    struct Options
+    {
+      /**
+       * @brief Path of the active log file (parent directories are created).
+       */
+      std::string path;
+
+      /**
+       * @brief Rotate once the file reaches this size in bytes (0 disables).
+       */
+      std::size_t max_size;
+
+      /**
+       * @brief Rotate on multiples of this interval since the epoch, UTC (0 disables).
+       */
+      std::chrono::seconds interval;
+
+      /**
+       * @brief Rotated segments to keep (0 keeps all).
+       *
+       * Counts every segment of this path found in its directory at open,
+       * including ones left by earlier runs, plus those rotated since.
+       */
+      std::size_t max_files;
+
+      /**
+       * @brief Gzip rotated segments on the background thread.
+       *
+       * Ignored when the library is built without zlib.
+       */
+      bool compress;
+
+      /**
+       * @brief Batch size that triggers a write.
+       */
+      std::size_t batch_bytes;
+
+      /**
+       * @brief Maximum time a record waits in the batch (0 disables).
+       */
+      std::chrono::milliseconds flush_interval;
+
+      Options()
+          : path(),
+            max_size(0),
+            interval(0),
+            max_files(0),
+            compress(false),
+            batch_bytes(256 * 1024),
+            flush_interval(200)
+      {
+      }
+    };
+
+    /**
+     * @brief Open (append to) the file and start the background thread.
+     *
+     * @throws spdlog::spdlog_ex if the file cannot be opened.
+     */
+    explicit BatchedFileSink(Options options);
+
+    /**
+     * @brief Write the pending batch, finish compressions and close the file.
+     */
+    ~BatchedFileSink() override;
+
+    BatchedFileSink(const BatchedFileSink &) = delete;
+    BatchedFileSink &operator=(const BatchedFileSink &) = delete;
+
+    /**
+     * @brief Active options.
+     */
+    const Options &options() const noexcept { return options_; }
+
+    /**
+     * @brief Whether rotated segments are actually compressed in this build.
+     */
+    static bool compressionAvailable() noexcept;
+
+    /**
+     * @brief Records discarded because the file could not be (re)opened.
+     */
+    std::uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+  protected:
+    void sink_it_(const spdlog::details::log_msg &msg) override;
+    void flush_() override;
+
+  private:
+    void open();
+    void writeBatch();
+    void rotate();
+    void prune();
+    void scanSegments();
+    std::string rotatedName() const;
+    void run();
+    static bool gzipFile(const std::string &src, const std::string &dst);
+
+    Options options_;
+    std::FILE *file_ = nullptr;
+    std::size_t file_size_ = 0;
+    spdlog::memory_buf_t batch_;
+    std::size_t batch_records_ = 0;
+    std::atomic<std::uint64_t> dropped_{0};
+    spdlog::memory_buf_t formatted_;
+    spdlog::log_clock::time_point next_rotation_{};
+    std::chrono::steady_clock::time_point batch_since_{};
+    /**
+     * @brief Rotated segments, oldest first, without the .gz suffix.
+     */
+    std::deque<std::string> segments_;
+
+    std::mutex bg_mutex_;
+    std::condition_variable bg_cv_;
+    std::deque<std::string> to_compress_;
+    std::string compressing_; // segment the background thread is gzipping
+    bool bg_stop_ = false;
+    std::thread bg_;
+  };
+
+} // namespace vix::utils
+
+#endif // VIX_UTILS_FILE_SINK_HPP
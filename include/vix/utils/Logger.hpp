@@ -48,6 +48,14 @@
  * log.logf(vix::utils::Logger::Level::Info, "Login ok",
  *          "user", user.c_str(),
  *          "latency_ms", 12);
+ *
+ * // Throttled: at most 5 lines per second for this key, then a
+ * // "suppressed N similar messages" summary
+ * log.logRateLimited("db.retry", 5, vix::utils::Logger::Level::Warn,
+ *                    "retrying {}", query);
+ *
+ * // Compile-time elided below VIX_LOG_ACTIVE_LEVEL (arguments not evaluated)
+ * VIX_LOG_DEBUG("cache miss for {}", expensive_key());
  * @endcode
  */
 
@@ -87,6 +95,12 @@
 
 #endif
 
+#include <atomic>
+#include <chrono>
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -94,9 +108,12 @@
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <thread>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 #include <cstdlib>
 
 #include <fmt/ostream.h>
@@ -105,7 +122,33 @@
 #include <spdlog/spdlog.h>
 
 #include <vix/utils/ConsoleMutex.hpp>
+#include <vix/utils/DeferredLog.hpp>
 #include <vix/utils/Env.hpp>
+#include <vix/utils/FileSink.hpp>
+#include <vix/utils/Metrics.hpp>
+#include <vix/utils/NetworkError.hpp>
+#include <vix/utils/String.hpp>
+
+/**
+ * @brief Compile-time log level values (same numbering as spdlog::level).
+ */
+#define VIX_LOG_LEVEL_TRACE 0
+#define VIX_LOG_LEVEL_DEBUG 1
+#define VIX_LOG_LEVEL_INFO 2
+#define VIX_LOG_LEVEL_WARN 3
+#define VIX_LOG_LEVEL_ERROR 4
+#define VIX_LOG_LEVEL_CRITICAL 5
+#define VIX_LOG_LEVEL_OFF 6
+
+/**
+ * @brief Compile-time minimum log level.
+ *
+ * Calls below this level compile to nothing. Normally injected by the
+ * VIX_LOG_ACTIVE_LEVEL CMake option; defaults to TRACE (nothing elided).
+ */
+#ifndef VIX_LOG_ACTIVE_LEVEL
+#define VIX_LOG_ACTIVE_LEVEL VIX_LOG_LEVEL_TRACE
+#endif
 
 #if defined(SPDLOG_FMT_EXTERNAL)
 #include <fmt/format.h>
@@ -127,6 +170,15 @@ namespace vix::utils
    *
    * The logger is designed to be safe in multi-threaded applications and
    * to keep output deterministic and easy to parse.
+   *
+   * Hot path:
+   * - the active level is mirrored in an atomic, so a disabled level costs
+   *   a single relaxed load
+   * - the spdlog logger is published RCU-style through an atomic pointer;
+   *   reconfiguration swaps it under mutex_ and frees the previous one once
+   *   in-flight calls have left it, so log calls never take mutex_
+   * - async mode runs on a Logger-owned bounded queue (see AsyncOptions)
+   * - logf formats into a thread-local buffer without holding any lock
    */
   class Logger
   {
@@ -157,6 +209,21 @@ namespace vix::utils
       Off
     };
 
+    /**
+     * @brief Number of levels that emit lines (Trace..Critical).
+     */
+    static constexpr std::size_t kLevelCount = 6;
+
+    /**
+     * @brief Pre-rendered JSON value for logf (e.g. metrics_to_json output).
+     *
+     * Written verbatim in every format, so it must be valid JSON.
+     */
+    struct RawJson
+    {
+      std::string_view json;
+    };
+
     /**
      * @brief Output format for structured logging.
      */
@@ -178,6 +245,17 @@ namespace vix::utils
       JSON_PRETTY
     };
 
+    /**
+     * @brief Whether a level survives the compile-time VIX_LOG_ACTIVE_LEVEL cut.
+     *
+     * Logger::Level and VIX_LOG_LEVEL_* share the same numbering.
+     */
+    static constexpr bool compiled(Level level) noexcept
+    {
+      return level != Level::Off &&
+             static_cast<int>(level) >= VIX_LOG_ACTIVE_LEVEL;
+    }
+
     /**
      * @brief Get the global Logger instance.
      *
@@ -197,8 +275,11 @@ namespace vix::utils
     void setLevel(Level level)
     {
       std::lock_guard<std::mutex> lock(mutex_);
-      if (spd_)
-        spd_->set_level(toSpdLevel(level));
+      if (!spd_)
+        return;
+
+      spd_->set_level(toSpdLevel(level));
+      level_.store(static_cast<int>(toSpdLevel(level)), std::memory_order_relaxed);
     }
 
     /**
@@ -229,7 +310,8 @@ namespace vix::utils
     template <typename... Args>
     void trace(fmt::format_string<Args...> fmtstr, Args &&...args)
     {
-      log(Level::Trace, fmtstr, std::forward<Args>(args)...);
+      if constexpr (compiled(Level::Trace))
+        log(Level::Trace, fmtstr, std::forward<Args>(args)...);
     }
 
     /**
@@ -238,7 +320,8 @@ namespace vix::utils
     template <typename... Args>
     void debug(fmt::format_string<Args...> fmtstr, Args &&...args)
     {
-      log(Level::Debug, fmtstr, std::forward<Args>(args)...);
+      if constexpr (compiled(Level::Debug))
+        log(Level::Debug, fmtstr, std::forward<Args>(args)...);
     }
 
     /**
@@ -247,7 +330,8 @@ namespace vix::utils
     template <typename... Args>
     void info(fmt::format_string<Args...> fmtstr, Args &&...args)
     {
-      log(Level::Info, fmtstr, std::forward<Args>(args)...);
+      if constexpr (compiled(Level::Info))
+        log(Level::Info, fmtstr, std::forward<Args>(args)...);
     }
 
     /**
@@ -256,7 +340,8 @@ namespace vix::utils
     template <typename... Args>
     void warn(fmt::format_string<Args...> fmtstr, Args &&...args)
     {
-      log(Level::Warn, fmtstr, std::forward<Args>(args)...);
+      if constexpr (compiled(Level::Warn))
+        log(Level::Warn, fmtstr, std::forward<Args>(args)...);
     }
 
     /**
@@ -265,7 +350,8 @@ namespace vix::utils
     template <typename... Args>
     void error(fmt::format_string<Args...> fmtstr, Args &&...args)
     {
-      log(Level::Error, fmtstr, std::forward<Args>(args)...);
+      if constexpr (compiled(Level::Error))
+        log(Level::Error, fmtstr, std::forward<Args>(args)...);
     }
 
     /**
@@ -274,13 +360,17 @@ namespace vix::utils
     template <typename... Args>
     void critical(fmt::format_string<Args...> fmtstr, Args &&...args)
     {
-      log(Level::Critical, fmtstr, std::forward<Args>(args)...);
+      if constexpr (compiled(Level::Critical))
+        log(Level::Critical, fmtstr, std::forward<Args>(args)...);
     }
 
     /**
      * @brief Log a formatted message at the given level.
      *
      * This function checks the logger level and only formats/logs if enabled.
+     * Levels below VIX_LOG_ACTIVE_LEVEL are rejected at compile time when
+     * `level` is a constant; use the VIX_LOG* macros to also skip argument
+     * evaluation.
      *
      * @param level Log level.
      * @param fmtstr Format string.
@@ -289,28 +379,29 @@ namespace vix::utils
     template <typename... Args>
     void log(Level level, fmt::format_string<Args...> fmtstr, Args &&...args)
     {
-      if (level == Level::Off)
+      if (!compiled(level) || !enabled(level))
         return;
 
-      std::shared_ptr<spdlog::logger> spd;
+      const PipelineRef ref(*this);
+      const Pipeline *p = ref.get();
+      if (!p || !admit(*p, level))
+        return;
+      countLine(level);
+      const std::uint64_t t0 = statsClock();
+      if (p->backend)
       {
-        std::lock_guard<std::mutex> lock(mutex_);
-        spd = spd_;
-        if (!spd)
-          return;
-        if (!spd->should_log(toSpdLevel(level)))
-          return;
+        p->backend->submit(toSpdLevel(level), {}, fmtstr, std::forward<Args>(args)...);
+        recordStage(sink_ns_, t0);
+        return;
       }
 
-      if (console_sync_enabled())
-      {
+      spdlog::logger *spd = p->logger.get();
+
+      if (p->console_sync)
         vix::utils::console_wait_banner();
-        std::lock_guard<std::mutex> lk(vix::utils::console_mutex());
-        spd->log(toSpdLevel(level), fmtstr, std::forward<Args>(args)...);
-        return;
-      }
 
       spd->log(toSpdLevel(level), fmtstr, std::forward<Args>(args)...);
+      recordStage(sink_ns_, t0);
     }
 
     /**
@@ -329,32 +420,38 @@ namespace vix::utils
                    fmt::format_string<Args...> fmtstr,
                    Args &&...args)
     {
-      if (level == Level::Off)
+      if (!compiled(level) || !enabled(level))
         return;
 
-      std::shared_ptr<spdlog::logger> spd;
+      const PipelineRef ref(*this);
+      const Pipeline *p = ref.get();
+      if (!p || !admit(*p, level))
+        return;
+      countLine(level);
+      const std::uint64_t t0 = statsClock();
+      if (p->backend)
       {
-        std::lock_guard<std::mutex> lock(mutex_);
-        spd = spd_;
-        if (!spd)
-          return;
-        if (!spd->should_log(toSpdLevel(level)))
-          return;
+        p->backend->submit(toSpdLevel(level), module, fmtstr, std::forward<Args>(args)...);
+        recordStage(sink_ns_, t0);
+        return;
       }
 
-      fmt::memory_buffer buf;
-      fmt::format_to(std::back_inserter(buf), "[{}] ", module);
+      spdlog::logger *spd = p->logger.get();
+
+      BufferLease lease;
+      fmt::memory_buffer &buf = lease.get();
+      buf.push_back('[');
+      append(buf, module);
+      append(buf, "] ");
       fmt::format_to(std::back_inserter(buf), fmtstr, std::forward<Args>(args)...);
+      const spdlog::string_view_t line(buf.data(), buf.size());
+      const std::uint64_t t1 = recordStage(format_ns_, t0);
 
-      if (console_sync_enabled())
-      {
+      if (p->console_sync)
         vix::utils::console_wait_banner();
-        std::lock_guard<std::mutex> lk(vix::utils::console_mutex());
-        spd->log(toSpdLevel(level), "{}", fmt::to_string(buf));
-        return;
-      }
 
-      spd->log(toSpdLevel(level), "{}", fmt::to_string(buf));
+      spd->log(toSpdLevel(level), line);
+      recordStage(sink_ns_, t1);
     }
 
     /**
@@ -377,6 +474,98 @@ namespace vix::utils
       throw std::runtime_error(msg);
     }
 
+    /**
+     * @brief Log only every n-th call of this call site.
+     *
+     * The call site is identified by its format string. The first call is
+     * logged, then one call out of n (n = 0 behaves like 1).
+     *
+     * The format string is keyed by address, and the compiler or linker may
+     * pool identical literals (-fmerge-constants, /GF), so two sites with
+     * the same text can share one counter. Give them distinct text, or use
+     * logRateLimited with an explicit key.
+     */
+    template <typename... Args>
+    void logEvery(std::uint64_t n,
+                  Level level,
+                  fmt::format_string<Args...> fmtstr,
+                  Args &&...args)
+    {
+      if (!compiled(level) || !enabled(level))
+        return;
+
+      const fmt::string_view fsv = fmtstr;
+      if (throttle(Throttle::Every, siteKey(fsv.data()), n ? n : 1, level, {fsv.data(), fsv.size()}))
+        log(level, fmtstr, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Log at most per_second calls per second for a key.
+     *
+     * Calls sharing a key share the budget; per_second = 0 disables the
+     * limit. When a one-second window closes, the first call of the next
+     * window also logs "suppressed N similar messages: <key>" at the same
+     * level.
+     */
+    template <typename... Args>
+    void logRateLimited(std::string_view key,
+                        std::uint32_t per_second,
+                        Level level,
+                        fmt::format_string<Args...> fmtstr,
+                        Args &&...args)
+    {
+      if (!compiled(level) || !enabled(level))
+        return;
+
+      if (per_second == 0 || throttle(Throttle::Rate, keyHash(key), per_second, level, key))
+        log(level, fmtstr, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Log a call with the given probability (0..1).
+     *
+     * Sampled-out calls of the site are counted and reported once per
+     * second like logRateLimited. Sites are keyed like logEvery, so
+     * identical format strings may share one counter.
+     */
+    template <typename... Args>
+    void logSampled(double probability,
+                    Level level,
+                    fmt::format_string<Args...> fmtstr,
+                    Args &&...args)
+    {
+      if (!compiled(level) || !enabled(level))
+        return;
+
+      const fmt::string_view fsv = fmtstr;
+      if (throttle(Throttle::Sample, siteKey(fsv.data()), sampleThreshold(probability),
+                   level, {fsv.data(), fsv.size()}))
+        log(level, fmtstr, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Log a network error, rate limiting disconnect storms.
+     *
+     * Normal peer disconnects (see is_normal_network_disconnect) are logged
+     * at DEBUG, at most per_second per second; other errors are logged at
+     * WARN with the same budget under their own key.
+     *
+     * @param where Optional prefix naming the operation (e.g. "read").
+     */
+    void logNetworkError(const std::system_error &e,
+                         std::string_view where = {},
+                         std::uint32_t per_second = 10)
+    {
+      const bool normal = is_normal_network_disconnect(e);
+      const Level level = normal ? Level::Debug : Level::Warn;
+      const std::string_view key = normal ? "vix.net.disconnect" : "vix.net.error";
+
+      if (where.empty())
+        logRateLimited(key, per_second, level, "{}", e.what());
+      else
+        logRateLimited(key, per_second, level, "{}: {}", where, e.what());
+    }
+
     /**
      * @brief Per-thread logging context.
      *
@@ -405,6 +594,9 @@ namespace vix::utils
     /**
      * @brief Set the spdlog pattern for console output.
      *
+     * Also refreshes env_snapshot(), like setAsync. The console sink itself
+     * (VIX_CONSOLE_SYNC) is only rebuilt by setAsync and setFile.
+     *
      * @param pattern spdlog pattern string.
      */
     void setPattern(const std::string &pattern);
@@ -412,10 +604,275 @@ namespace vix::utils
     /**
      * @brief Enable or disable async logging mode.
      *
+     * Refreshes env_snapshot() first and rebuilds the console sink for the
+     * current VIX_CONSOLE_SYNC, so console serialization and the banner wait
+     * follow setenv calls made since.
+     *
      * @param enable True to enable async mode.
      */
     void setAsync(bool enable);
 
+    /**
+     * @brief Async backend configuration.
+     *
+     * The defaults match setAsync(true): one worker, 262144 slots,
+     * overrun oldest on overflow, no periodic flush.
+     */
+    struct AsyncOptions
+    {
+      /**
+       * @brief What a producer does when the queue is full.
+       */
+      enum class Overflow
+      {
+        /**
+         * @brief Wait for a free slot (lossless, may stall the caller).
+         */
+        Block,
+
+        /**
+         * @brief Drop the incoming record (counted in Stats::dropped).
+         */
+        DropNew,
+
+        /**
+         * @brief Replace the oldest queued record (counted in Stats::overrun).
+         */
+        Overrun
+      };
+
+      /**
+       * @brief Queue capacity in records (pre-allocated).
+       */
+      std::size_t queue_capacity;
+
+      /**
+       * @brief Number of worker threads draining the queue.
+       */
+      std::size_t worker_threads;
+
+      /**
+       * @brief Overflow policy.
+       */
+      Overflow overflow;
+
+      /**
+       * @brief Periodic flush interval (0 disables).
+       */
+      std::chrono::milliseconds flush_interval;
+
+      /**
+       * @brief First CPU to pin workers to (worker i -> cpu + i), -1 for none.
+       *
+       * Only honored on Linux.
+       */
+      int worker_cpu;
+
+      /**
+       * @brief Format log()/logModule() calls on the worker instead of the caller.
+       *
+       * Arithmetic and string arguments are copied into a binary record
+       * (see DeferredLog.hpp); other calls are formatted eagerly. Implies
+       * thread_rings.
+       */
+      bool deferred;
+
+      /**
+       * @brief Give each producing thread its own SPSC ring drained by one worker.
+       *
+       * Replaces the shared spdlog queue: queue_capacity and worker_threads
+       * are ignored, and Overrun behaves like DropNew.
+       */
+      bool thread_rings;
+
+      /**
+       * @brief Ring size per producing thread, in bytes (thread_rings only).
+       */
+      std::size_t ring_bytes;
+
+      AsyncOptions()
+          : queue_capacity(262144),
+            worker_threads(1),
+            overflow(Overflow::Overrun),
+            flush_interval(0),
+            worker_cpu(-1),
+            deferred(false),
+            thread_rings(false),
+            ring_bytes(1u << 20)
+      {
+      }
+
+      /**
+       * @brief Read options from the environment, starting from the defaults.
+       *
+       * - VIX_LOG_ASYNC_QUEUE: queue capacity
+       * - VIX_LOG_ASYNC_THREADS: worker threads
+       * - VIX_LOG_ASYNC_OVERFLOW: block|drop|overrun
+       * - VIX_LOG_ASYNC_FLUSH_MS: flush interval in milliseconds
+       * - VIX_LOG_ASYNC_CPU: first worker CPU
+       * - VIX_LOG_ASYNC_DEFERRED: deferred formatting (bool)
+       * - VIX_LOG_ASYNC_RINGS: per-thread rings (bool)
+       * - VIX_LOG_ASYNC_RING_BYTES: ring size per thread
+       */
+      static AsyncOptions fromEnv();
+
+      /**
+       * @brief Parse an overflow policy name (block|drop|overrun).
+       *
+       * Unknown names map to Overrun.
+       */
+      static Overflow parseOverflow(std::string_view s);
+    };
+
+    /**
+     * @brief Switch to async mode with explicit options.
+     *
+     * Workers are owned by the Logger (not the global spdlog pool). The
+     * pool is reused when capacity, worker count and pinning are unchanged.
+     *
+     * @param options Async backend configuration.
+     */
+    void setAsync(const AsyncOptions &options);
+
+    /**
+     * @brief Configure async mode from the environment.
+     *
+     * Does nothing unless VIX_LOG_ASYNC is true; options come from
+     * AsyncOptions::fromEnv().
+     */
+    void setAsyncFromEnv();
+
+    /**
+     * @brief Write logs to a batched, rotating file (see BatchedFileSink).
+     *
+     * Replaces any previous file output and keeps the current sync/async
+     * mode; the replaced file sink writes its pending batch, closes its
+     * file and joins its thread once no log call uses it. Sink patterns are
+     * reset to the defaults of the current format; the file gets a plain
+     * (uncolored) pattern with the date. In file mode records are flushed
+     * on warn+ and every options.flush_interval.
+     *
+     * @param options File sink configuration.
+     * @param console Keep the console sink next to the file.
+     */
+    void setFile(const BatchedFileSink::Options &options, bool console = true);
+
+    /**
+     * @brief Configure file output from the environment.
+     *
+     * Does nothing unless VIX_LOG_FILE is set.
+     * - VIX_LOG_FILE: log file path
+     * - VIX_LOG_ROTATE_SIZE: rotate size in bytes (K/M/G suffixes accepted)
+     * - VIX_LOG_ROTATE_INTERVAL: hourly|daily or seconds (s/m/h/d suffixes accepted)
+     * - VIX_LOG_ROTATE_KEEP: rotated files to keep
+     * - VIX_LOG_ROTATE_COMPRESS: gzip rotated files (bool)
+     * - VIX_LOG_FILE_FLUSH_MS: maximum batching delay
+     * - VIX_LOG_CONSOLE: keep console output (bool, default true)
+     */
+    void setFileFromEnv();
+
+    /**
+     * @brief Snapshot of the async backend counters.
+     */
+    struct Stats
+    {
+      /**
+       * @brief Whether the async backend is active.
+       */
+      bool async = false;
+
+      /**
+       * @brief Queue capacity in records (0 in sync mode).
+       *
+       * With per-thread rings: ring size per producer, in bytes.
+       */
+      std::size_t queue_capacity = 0;
+
+      /**
+       * @brief Producer rings currently registered (per-thread rings only).
+       */
+      std::size_t producers = 0;
+
+      /**
+       * @brief Records currently waiting in the queue.
+       */
+      std::size_t queue_depth = 0;
+
+      /**
+       * @brief Records replaced under the Overrun policy.
+       */
+      std::uint64_t overrun = 0;
+
+      /**
+       * @brief Records rejected under the DropNew policy.
+       */
+      std::uint64_t dropped = 0;
+
+      /**
+       * @brief Lines handed to the sinks or the async queue, per Level.
+       */
+      std::array<std::uint64_t, kLevelCount> lines{};
+
+      /**
+       * @brief DropNew rejections per Level (ring drops are only in `dropped`).
+       */
+      std::array<std::uint64_t, kLevelCount> dropped_by_level{};
+
+      /**
+       * @brief logf / logModule line build time in ns, while stats timing is on.
+       */
+      HistogramSnapshot format_ns;
+
+      /**
+       * @brief Time in the sink call in ns, while stats timing is on.
+       *
+       * Sync mode: the spdlog call including the sink write. Async modes:
+       * the enqueue only.
+       */
+      HistogramSnapshot sink_ns;
+    };
+
+    /**
+     * @brief Read the logger counters.
+     *
+     * Async counters are cumulative for the current worker pool, line
+     * counters for the process; queue_depth briefly takes the queue lock.
+     * The same values are exported as `log.*` by MetricsRegistry::instance().
+     */
+    Stats stats() const;
+
+    /**
+     * @brief Time line building and sink calls into Stats::format_ns / sink_ns.
+     *
+     * Off by default (two clock reads per line); VIX_LOG_STATS_TIMING=1
+     * turns it on at startup.
+     */
+    void setStatsTiming(bool enable) noexcept
+    {
+      stats_timing_.store(enable, std::memory_order_relaxed);
+    }
+
+    bool statsTiming() const noexcept
+    {
+      return stats_timing_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Log a metrics snapshot as one line in the current format.
+     *
+     * JSON formats carry it as a `"metrics"` object (metrics_to_json); KV
+     * appends the `name=value` entries (metrics_to_text) to `msg`.
+     */
+    void logMetrics(Level level, const MetricsSnapshot &snap, std::string_view msg = "metrics");
+
+    /**
+     * @brief Write out every queued record and flush the sinks.
+     *
+     * In async modes this waits for the backend to drain what was queued
+     * before the call. Also run when the Logger is destroyed at exit.
+     */
+    void flush();
+
     /**
      * @brief Replace the current thread context.
      *
@@ -423,16 +880,92 @@ namespace vix::utils
      */
     void setContext(Context ctx);
 
+    /**
+     * @brief Reset the current thread context in place.
+     *
+     * Same result as setContext() with only request_id and module set, but
+     * reuses the existing string and map storage.
+     *
+     * @param request_id Request identifier.
+     * @param module Logical module name.
+     */
+    void resetContext(std::string_view request_id, std::string_view module = {});
+
+    /**
+     * @brief Set (or replace) one field of the current thread context.
+     */
+    void setContextField(std::string_view key, std::string_view value);
+
     /**
      * @brief Clear the current thread context.
+     *
+     * Fields pushed by a live ContextGuard are kept.
      */
     void clearContext();
 
     /**
      * @brief Get a copy of the current thread context.
+     *
+     * Fields pushed by ContextGuard are not included.
      */
     Context getContext() const;
 
+    /**
+     * @brief Read the current thread context without copying it.
+     */
+    const Context &context() const noexcept { return tls_ctx_.ctx; }
+
+    /**
+     * @brief Scoped context fields for the current thread (RAII).
+     *
+     * Fields are appended after the Context fields and removed when the
+     * guard is destroyed. Keys and values are copied into per-thread
+     * storage that is reused across guards, so pushing and popping does
+     * not allocate once the thread is warm. Guards must be destroyed in
+     * reverse order of construction, on the thread that created them.
+     *
+     * @code
+     * Logger::ContextGuard g("user", user_id);
+     * g.push("tenant", tenant);
+     * log.logf(Logger::Level::Info, "checkout");   // ... user=42 tenant=acme
+     * @endcode
+     */
+    class ContextGuard
+    {
+    public:
+      ContextGuard() noexcept = default;
+
+      /**
+       * @brief Push one field.
+       */
+      ContextGuard(std::string_view key, std::string_view value)
+      {
+        push(key, value);
+      }
+
+      ContextGuard(const ContextGuard &) = delete;
+      ContextGuard &operator=(const ContextGuard &) = delete;
+      ContextGuard(ContextGuard &&) = delete;
+      ContextGuard &operator=(ContextGuard &&) = delete;
+
+      /**
+       * @brief Remove every field pushed through this guard.
+       */
+      ~ContextGuard() noexcept;
+
+      /**
+       * @brief Push one more field, removed with the others.
+       */
+      ContextGuard &push(std::string_view key, std::string_view value);
+
+    private:
+      /**
+       * @brief Scoped field count when the first field was pushed.
+       */
+      std::size_t base_ = 0;
+      bool active_ = false;
+    };
+
     /**
      * @brief Log a message with key/value pairs.
      *
@@ -440,6 +973,11 @@ namespace vix::utils
      *   logf(INFO, "msg", "k1", v1, "k2", v2, ...).
      *
      * Depending on the configured format, output is KV, JSON, or pretty JSON.
+     * The line is built in a reused thread-local buffer and handed to spdlog
+     * as a view, so no heap allocation happens once the buffer is warm.
+     * No Logger lock is taken: formatting runs on the caller's thread
+     * against the published logger snapshot. With VIX_CONSOLE_SYNC the
+     * console sink hands the line to ConsoleWriter instead of writing it.
      *
      * @param level Log level.
      * @param msg Base message.
@@ -448,43 +986,52 @@ namespace vix::utils
     template <typename... Args>
     void logf(Level level, const std::string &msg, Args &&...kvpairs)
     {
-      if (level == Level::Off)
+      if (!compiled(level) || !enabled(level))
         return;
 
-      std::lock_guard<std::mutex> lock(mutex_);
-      if (!spd_ || !spd_->should_log(toSpdLevel(level)))
+      const PipelineRef ref(*this);
+      const Pipeline *p = ref.get();
+      if (!p || !admit(*p, level))
         return;
+      spdlog::logger *spd = p->logger.get();
+      countLine(level);
+      const std::uint64_t t0 = statsClock();
+
+      BufferLease lease;
+      fmt::memory_buffer &buf = lease.get();
 
-      if (console_sync_enabled())
+      const Format format = format_.load(std::memory_order_relaxed);
+      if (format == Format::JSON_PRETTY)
       {
-        vix::utils::console_wait_banner();
-        std::lock_guard<std::mutex> lk(vix::utils::console_mutex());
-        (void)lk;
+        buildJsonPretty(buf, level, msg, std::forward<Args>(kvpairs)...);
       }
-
-      if (format_ == Format::JSON_PRETTY)
+      else if (format == Format::JSON)
       {
-        spd_->log(toSpdLevel(level), "{}", buildJsonPretty(level, msg, std::forward<Args>(kvpairs)...));
-        return;
+        buildJsonLine(buf, level, msg, std::forward<Args>(kvpairs)...);
+      }
+      else
+      {
+        append(buf, msg);
+        appendKV(buf, std::forward<Args>(kvpairs)...);
+        appendContextKV(buf);
       }
-      if (format_ == Format::JSON)
+
+      const std::uint64_t t1 = recordStage(format_ns_, t0);
+
+      if (p->backend)
       {
-        spd_->log(toSpdLevel(level), "{}", buildJsonLine(level, msg, std::forward<Args>(kvpairs)...));
+        p->backend->submitText(toSpdLevel(level), {}, std::string_view(buf.data(), buf.size()));
+        recordStage(sink_ns_, t1);
         return;
       }
 
-      std::string line = msg;
-      appendKV(line, std::forward<Args>(kvpairs)...);
+      const spdlog::string_view_t line(buf.data(), buf.size());
 
-      const auto &c = ctx();
-      if (!c.request_id.empty())
-        line += " rid=" + c.request_id;
-      if (!c.module.empty())
-        line += " mod=" + c.module;
-      for (const auto &it : c.fields)
-        line += " " + it.first + "=" + it.second;
+      if (p->console_sync)
+        vix::utils::console_wait_banner();
 
-      spd_->log(toSpdLevel(level), "{}", line);
+      spd->log(toSpdLevel(level), line);
+      recordStage(sink_ns_, t1);
     }
 
     /**
@@ -519,11 +1066,8 @@ namespace vix::utils
      */
     Level level() const noexcept
     {
-      std::lock_guard<std::mutex> lock(mutex_);
-      if (!spd_)
-        return Level::Off;
-
-      const auto lvl = spd_->level();
+      const auto lvl = static_cast<spdlog::level::level_enum>(
+          level_.load(std::memory_order_relaxed));
       if (lvl == spdlog::level::trace)
         return Level::Trace;
       if (lvl == spdlog::level::debug)
@@ -541,13 +1085,12 @@ namespace vix::utils
 
     /**
      * @brief Check whether the given level is enabled.
+     *
+     * Lock-free: a single relaxed load of the mirrored level.
      */
     bool enabled(Level lvl) const noexcept
     {
-      std::lock_guard<std::mutex> lock(mutex_);
-      if (!spd_)
-        return false;
-      return spd_->should_log(toSpdLevel(lvl));
+      return static_cast<int>(toSpdLevel(lvl)) >= level_.load(std::memory_order_relaxed);
     }
 
   private:
@@ -557,7 +1100,12 @@ namespace vix::utils
     Logger();
 
     /**
-     * @brief Convert Logger::Level to spdlog level.
+     * @brief Stop the flusher and drain the async queue.
+     */
+    ~Logger();
+
+    /**
+     * @brief Convert Logger::Level to spdlog level.
      */
     static spdlog::level::level_enum toSpdLevel(Level level) noexcept
     {
@@ -582,143 +1130,529 @@ namespace vix::utils
       }
     }
 
+    /**
+     * @brief Immutable logging pipeline read by the hot path.
+     *
+     * Bundles the spdlog logger with the async pool it writes to, so a
+     * caller that loaded active_ sees a consistent pair.
+     */
+    struct Pipeline
+    {
+      std::shared_ptr<spdlog::logger> logger;
+      std::shared_ptr<spdlog::details::thread_pool> pool;
+      std::size_t capacity = 0;
+
+      /**
+       * @brief DropNew policy: reject records while the queue is full.
+       */
+      bool drop_new = false;
+
+      /**
+       * @brief Per-thread ring backend; logger is then its sync sink logger.
+       */
+      std::shared_ptr<deferred::DeferredBackend> backend;
+
+      /**
+       * @brief Console output goes through ConsoleWriter (VIX_CONSOLE_SYNC).
+       */
+      bool console_sync = false;
+    };
+
+    /**
+     * @brief Whether a record may be submitted to the pipeline.
+     */
+    bool admit(const Pipeline &p, Level level) noexcept
+    {
+      return !p.drop_new || admitSlow(p, level);
+    }
+
+    /**
+     * @brief DropNew check against the pool queue depth.
+     *
+     * Best effort: producers racing past a nearly full queue briefly
+     * block instead of dropping.
+     */
+    bool admitSlow(const Pipeline &p, Level level) noexcept;
+
+    /**
+     * @brief Add `s` to a metrics snapshot under the `log.` prefix.
+     */
+    static void appendMetrics(MetricsSnapshot &snap, const Stats &s);
+
+    /**
+     * @brief Count one line handed to the pipeline (sharded, see Metrics.hpp).
+     */
+    void countLine(Level level) noexcept
+    {
+      lines_[static_cast<std::size_t>(level)].inc();
+    }
+
+    /**
+     * @brief fast_now_ns() while stats timing is on, otherwise 0.
+     */
+    std::uint64_t statsClock() const noexcept
+    {
+      return stats_timing_.load(std::memory_order_relaxed) ? fast_now_ns() : 0;
+    }
+
+    /**
+     * @brief Record the time since t0 into h and return the new time.
+     *
+     * Does nothing and returns 0 when t0 is 0 (timing off).
+     */
+    static std::uint64_t recordStage(Histogram &h, std::uint64_t t0) noexcept
+    {
+      if (!t0)
+        return 0;
+      const std::uint64_t now = fast_now_ns();
+      h.record(now - t0);
+      return now;
+    }
+
+    /**
+     * @brief Reader side of pipeline reclamation.
+     *
+     * A log call registers in a per-shard counter of the current reader
+     * epoch before it loads active_, and leaves it when the call returns.
+     * publish() waits on these counters before freeing a pipeline.
+     */
+    class PipelineRef
+    {
+    public:
+      explicit PipelineRef(const Logger &owner) noexcept
+          : count_(owner.readers_[owner.reader_epoch_.load(std::memory_order_relaxed) & 1u]
+                                 [detail::metric_shard()]
+                                     .n)
+      {
+        count_.fetch_add(1, std::memory_order_seq_cst);
+        p_ = owner.active_.load(std::memory_order_seq_cst);
+      }
+
+      ~PipelineRef() { count_.fetch_sub(1, std::memory_order_release); }
+
+      PipelineRef(const PipelineRef &) = delete;
+      PipelineRef &operator=(const PipelineRef &) = delete;
+
+      const Pipeline *get() const noexcept { return p_; }
+
+    private:
+      std::atomic<std::uint32_t> &count_;
+      const Pipeline *p_ = nullptr;
+    };
+
+    /**
+     * @brief Publish a new pipeline (caller holds mutex_).
+     *
+     * The previous pipeline is destroyed, which drains and joins its
+     * backend and closes sinks no other pipeline shares, once no log call
+     * can still be using it (see waitForReaders).
+     */
+    void publish(Pipeline next)
+    {
+      auto p = std::make_unique<Pipeline>(std::move(next));
+      std::unique_ptr<const Pipeline> old = std::move(current_);
+
+      spd_ = p->logger;
+      current_ = std::move(p);
+      active_.store(current_.get(), std::memory_order_seq_cst);
+
+      if (old)
+      {
+        waitForReaders();
+        old.reset();
+      }
+    }
+
+    /**
+     * @brief Wait until every call that may have loaded a replaced pipeline has left.
+     *
+     * Such a call registered before the store to active_, in either epoch.
+     * Each epoch is retired in turn while new calls register in the other,
+     * so a steady stream of logging cannot keep the wait going.
+     */
+    void waitForReaders() noexcept;
+
+    /**
+     * @brief Throttling policy of logEvery / logRateLimited / logSampled.
+     */
+    enum class Throttle
+    {
+      Every,
+      Rate,
+      Sample
+    };
+
+    /**
+     * @brief Per-key throttling state, one cache line per slot.
+     *
+     * Claimed by a CAS on key. When every slot of a probe run is taken,
+     * the one with the oldest window is handed to the new key, so distinct
+     * keys never share a budget. The window fields track the current
+     * one-second window; suppressed counts the calls that were not logged
+     * since the last summary.
+     */
+    struct alignas(64) ThrottleSlot
+    {
+      std::atomic<std::uint64_t> key{0};
+      std::atomic<std::uint64_t> calls{0};
+      std::atomic<std::int64_t> window_start{0};
+      std::atomic<std::uint64_t> window_count{0};
+      std::atomic<std::uint64_t> suppressed{0};
+    };
+
+    static constexpr std::size_t kThrottleSlots = 1024;
+
+    /**
+     * @brief Key of a call site, derived from its format string address.
+     *
+     * Pooled identical literals yield the same key (see logEvery).
+     */
+    static std::uint64_t siteKey(const void *site) noexcept
+    {
+      return static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(site));
+    }
+
+    /**
+     * @brief FNV-1a hash of an explicit throttling key.
+     */
+    static std::uint64_t keyHash(std::string_view key) noexcept
+    {
+      std::uint64_t h = 14695981039346656037ull;
+      for (const char c : key)
+      {
+        h ^= static_cast<unsigned char>(c);
+        h *= 1099511628211ull;
+      }
+      return h;
+    }
+
+    /**
+     * @brief Map a probability to a threshold on a uniform 64-bit draw.
+     */
+    static std::uint64_t sampleThreshold(double probability) noexcept
+    {
+      if (!(probability > 0.0))
+        return 0;
+      if (probability >= 1.0)
+        return UINT64_MAX;
+      return static_cast<std::uint64_t>(probability * 18446744073709551616.0);
+    }
+
+    /**
+     * @brief Decide whether a throttled call is logged (lock-free).
+     *
+     * Also emits the suppression summary of the previous window.
+     *
+     * @param param n (Every), calls per second (Rate) or threshold (Sample).
+     * @param label Format string or key, quoted in the summary.
+     */
+    bool throttle(Throttle mode,
+                  std::uint64_t key,
+                  std::uint64_t param,
+                  Level level,
+                  std::string_view label);
+
+    /**
+     * @brief Find, claim or evict the slot of a key (linear probing).
+     */
+    ThrottleSlot &throttleSlot(std::uint64_t key) noexcept;
+
+    /**
+     * @brief Stop the periodic flusher thread (caller must not hold mutex_).
+     */
+    void stopFlusher();
+
+    /**
+     * @brief Start the periodic flusher thread (caller must not hold mutex_).
+     */
+    void startFlusher(std::chrono::milliseconds interval);
+
     std::shared_ptr<spdlog::logger> spd_;
     mutable std::mutex mutex_;
-    Format format_ = Format::KV;
+
+    /**
+     * @brief Pattern given to a console sink rebuilt for VIX_CONSOLE_SYNC.
+     *
+     * Follows setPattern and setFormat (guarded by mutex_).
+     */
+    std::string console_pattern_;
+
+    /**
+     * @brief Structured output format, written by setFormat, read by logf.
+     */
+    std::atomic<Format> format_{Format::KV};
+
+    /**
+     * @brief Lock-free snapshot of current_ read by the logging hot path.
+     */
+    std::atomic<const Pipeline *> active_{nullptr};
+
+    /**
+     * @brief Mirror of the spdlog level (spdlog::level::level_enum as int).
+     *
+     * Stays at spdlog::level::off until a logger has been published.
+     */
+    std::atomic<int> level_{static_cast<int>(spdlog::level::off)};
+
+    /**
+     * @brief Pipeline owned by publish(); active_ points into it.
+     */
+    std::unique_ptr<const Pipeline> current_;
+
+    /**
+     * @brief In-flight log calls per reader epoch and shard (see PipelineRef).
+     */
+    struct alignas(64) ReaderCount
+    {
+      std::atomic<std::uint32_t> n{0};
+    };
+    mutable ReaderCount readers_[2][kMetricShards];
+    std::atomic<unsigned> reader_epoch_{0};
+
+    /**
+     * @brief Async worker pool, kept across sync/async toggles for reuse.
+     */
+    std::shared_ptr<spdlog::details::thread_pool> pool_;
+    AsyncOptions pool_options_;
+
+    /**
+     * @brief Records rejected under the DropNew policy, per Level.
+     */
+    Counter dropped_[kLevelCount];
+
+    /**
+     * @brief Lines handed to the pipeline, per Level.
+     */
+    Counter lines_[kLevelCount];
+
+    /**
+     * @brief Stage timings, recorded while stats_timing_ is set.
+     */
+    Histogram format_ns_;
+    Histogram sink_ns_;
+    std::atomic<bool> stats_timing_{false};
+
+    /**
+     * @brief Id of the `log.*` collector in MetricsRegistry::instance().
+     */
+    std::uint64_t metrics_collector_ = 0;
+
+    /**
+     * @brief Periodic flusher (spdlog::flush_every only has second resolution).
+     */
+    std::thread flusher_;
+    std::condition_variable flusher_cv_;
+    bool flusher_stop_ = false;
+
+    /**
+     * @brief Open-addressed throttling table shared by all throttled call sites.
+     */
+    std::unique_ptr<ThrottleSlot[]> throttle_{new ThrottleSlot[kThrottleSlots]};
+
+    /**
+     * @brief Per-thread context plus its pre-rendered KV/JSON fragments.
+     *
+     * The Context part is rendered once after each mutation; scoped fields
+     * (ContextGuard) are rendered when pushed and truncated when popped.
+     * All buffers keep their capacity, so steady-state logging only
+     * appends the fragments.
+     */
+    struct ContextState
+    {
+      /**
+       * @brief One scoped field and the buffer sizes before it was pushed.
+       */
+      struct Field
+      {
+        std::size_t key_off;
+        std::size_t key_len;
+        std::size_t val_off;
+        std::size_t val_len;
+        std::size_t arena_mark;
+        std::size_t kv_mark;
+        std::size_t json_mark;
+      };
+
+      Context ctx;
+      bool base_valid = false;
+      fmt::memory_buffer base_kv;
+      fmt::memory_buffer base_json;
+
+      std::vector<Field> fields;
+      std::string arena;
+      fmt::memory_buffer scoped_kv;
+      fmt::memory_buffer scoped_json;
+
+      std::string_view key(const Field &f) const noexcept
+      {
+        return std::string_view(arena).substr(f.key_off, f.key_len);
+      }
+
+      std::string_view value(const Field &f) const noexcept
+      {
+        return std::string_view(arena).substr(f.val_off, f.val_len);
+      }
+    };
 
     /**
      * @brief Thread-local context for the current thread.
      */
-    static thread_local Context tls_ctx_;
+    static thread_local ContextState tls_ctx_;
 
     /**
      * @brief Access the thread-local context.
      */
-    const Context &ctx() const noexcept { return tls_ctx_; }
+    const Context &ctx() const noexcept { return tls_ctx_.ctx; }
+
+    /**
+     * @brief Current thread context with the Context fragments up to date.
+     */
+    static ContextState &contextState()
+    {
+      ContextState &st = tls_ctx_;
+      if (!st.base_valid)
+        renderContext(st);
+      return st;
+    }
+
+    /**
+     * @brief Render the Context part of st into base_kv/base_json.
+     */
+    static void renderContext(ContextState &st);
+
+    /**
+     * @brief Append raw bytes to a format buffer.
+     */
+    static void append(fmt::memory_buffer &out, std::string_view s)
+    {
+      out.append(s.data(), s.data() + s.size());
+    }
+
+    /**
+     * @brief Append a value as text (strings verbatim, others through fmt).
+     */
+    template <typename V>
+    static void appendText(fmt::memory_buffer &out, V &&v)
+    {
+      using T = std::remove_cv_t<std::remove_reference_t<V>>;
+
+      if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>)
+        append(out, std::string_view(v));
+      else if constexpr (std::is_same_v<T, RawJson>)
+        append(out, v.json);
+      else
+        fmt::format_to(std::back_inserter(out), "{}", std::forward<V>(v));
+    }
 
     /**
-     * @brief Append key/value pairs to a string in KV form.
+     * @brief Append key/value pairs to a buffer in KV form.
      */
-    static void appendKV(std::string &) {}
+    static void appendKV(fmt::memory_buffer &) {}
 
     template <typename V, typename... Rest>
-    static void appendKV(std::string &s, const char *k, V &&v, Rest &&...rest)
+    static void appendKV(fmt::memory_buffer &out, const char *k, V &&v, Rest &&...rest)
     {
-      s += " ";
-      s += k;
-      s += "=";
-      s += fmt::format("{}", std::forward<V>(v));
+      out.push_back(' ');
+      append(out, k);
+      out.push_back('=');
+      appendText(out, std::forward<V>(v));
       if constexpr (sizeof...(rest) > 0)
-        appendKV(s, std::forward<Rest>(rest)...);
+        appendKV(out, std::forward<Rest>(rest)...);
+    }
+
+    /**
+     * @brief Append the thread context in KV form (" rid=.. mod=.. k=v").
+     */
+    void appendContextKV(fmt::memory_buffer &out) const
+    {
+      const ContextState &st = contextState();
+      out.append(st.base_kv.data(), st.base_kv.data() + st.base_kv.size());
+      out.append(st.scoped_kv.data(), st.scoped_kv.data() + st.scoped_kv.size());
     }
 
     /**
      * @brief Append a string to JSON with proper escaping.
+     *
+     * Delegates to json_escape_to (vectorized scan, bulk append of clean runs).
      */
-    static void appendJsonEscaped(std::string &out, std::string_view s)
+    static void appendJsonEscaped(fmt::memory_buffer &out, std::string_view s)
     {
-      for (const char ch : s)
-      {
-        switch (ch)
-        {
-        case '\"':
-          out += "\\\"";
-          break;
-        case '\\':
-          out += "\\\\";
-          break;
-        case '\b':
-          out += "\\b";
-          break;
-        case '\f':
-          out += "\\f";
-          break;
-        case '\n':
-          out += "\\n";
-          break;
-        case '\r':
-          out += "\\r";
-          break;
-        case '\t':
-          out += "\\t";
-          break;
-        default:
-          if (static_cast<unsigned char>(ch) < 0x20)
-          {
-            out += "\\u00";
-            static constexpr char hex[] = "0123456789abcdef";
-            const unsigned char uc = static_cast<unsigned char>(ch);
-            out.push_back(hex[(uc >> 4) & 0x0F]);
-            out.push_back(hex[uc & 0x0F]);
-          }
-          else
-          {
-            out.push_back(ch);
-          }
-          break;
-        }
-      }
+      json_escape_to(out, s);
     }
 
     /**
      * @brief Append a JSON key (with quotes and escaping) and a colon.
      */
-    static void appendJsonKey(std::string &out, std::string_view key)
+    static void appendJsonKey(fmt::memory_buffer &out, std::string_view key)
     {
-      out += "\"";
+      out.push_back('"');
       appendJsonEscaped(out, key);
-      out += "\":";
+      append(out, "\":");
     }
 
     /**
      * @brief Append a JSON string value (with quotes and escaping).
      */
-    static void appendJsonStringValue(std::string &out, std::string_view value)
+    static void appendJsonStringValue(fmt::memory_buffer &out, std::string_view value)
     {
-      out += "\"";
+      out.push_back('"');
       appendJsonEscaped(out, value);
-      out += "\"";
+      out.push_back('"');
     }
 
     /**
-     * @brief Append a JSON value of various supported types.
+     * @brief Append an arbitrary value as a quoted, escaped JSON string.
      *
-     * Numbers and booleans are emitted as JSON primitives. Other values
-     * are formatted as strings.
+     * Non-string values are formatted into a thread-local scratch buffer
+     * first, so escaping never allocates once warmed up.
      */
     template <typename V>
-    static void appendJsonValue(std::string &out, V &&v)
+    static void appendJsonQuoted(fmt::memory_buffer &out, V &&v)
     {
       using T = std::remove_cv_t<std::remove_reference_t<V>>;
 
-      if constexpr (std::is_same_v<T, bool>)
-      {
-        out += (v ? "true" : "false");
-      }
-      else if constexpr (std::is_integral_v<T> || std::is_floating_point_v<T>)
-      {
-        out += fmt::format("{}", v);
-      }
-      else if constexpr (std::is_same_v<T, std::string> ||
-                         std::is_same_v<T, std::string_view>)
+      if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>)
       {
         appendJsonStringValue(out, std::string_view(v));
       }
-      else if constexpr (std::is_same_v<T, const char *> ||
-                         std::is_same_v<T, char *>)
+      else if constexpr (std::is_same_v<T, const char *> || std::is_same_v<T, char *>)
       {
         appendJsonStringValue(out, v ? std::string_view(v) : std::string_view(""));
       }
       else
       {
-        appendJsonStringValue(out, fmt::format("{}", std::forward<V>(v)));
+        thread_local fmt::memory_buffer scratch;
+        scratch.clear();
+        fmt::format_to(std::back_inserter(scratch), "{}", std::forward<V>(v));
+        appendJsonStringValue(out, std::string_view(scratch.data(), scratch.size()));
       }
     }
 
+    /**
+     * @brief Append a JSON value of various supported types.
+     *
+     * Numbers and booleans are emitted as JSON primitives. Other values
+     * are formatted as strings.
+     */
+    template <typename V>
+    static void appendJsonValue(fmt::memory_buffer &out, V &&v)
+    {
+      using T = std::remove_cv_t<std::remove_reference_t<V>>;
+
+      if constexpr (std::is_same_v<T, bool>)
+        append(out, v ? "true" : "false");
+      else if constexpr (std::is_integral_v<T> || std::is_floating_point_v<T>)
+        fmt::format_to(std::back_inserter(out), "{}", v);
+      else if constexpr (std::is_same_v<T, RawJson>)
+        append(out, v.json);
+      else
+        appendJsonQuoted(out, std::forward<V>(v));
+    }
+
     /**
      * @brief Convert Level to a lowercase string (for JSON output).
      */
-    static std::string levelToString(Level level)
+    static constexpr std::string_view levelToString(Level level) noexcept
     {
       switch (level)
       {
@@ -742,138 +1676,98 @@ namespace vix::utils
     }
 
     /**
-     * @brief Build a single-line JSON log entry.
+     * @brief Build a single-line JSON log entry into `out`.
      */
     template <typename... Args>
-    std::string buildJsonLine(Level level, std::string_view msg, Args &&...kvpairs) const
+    void buildJsonLine(fmt::memory_buffer &out, Level level, std::string_view msg, Args &&...kvpairs) const
     {
-      std::string out;
-      out.reserve(256);
-      out += "{";
+      out.push_back('{');
 
       appendJsonKey(out, "level");
       appendJsonStringValue(out, levelToString(level));
-      out += ",";
+      out.push_back(',');
 
       appendJsonKey(out, "msg");
       appendJsonStringValue(out, msg);
 
-      const auto &c = ctx();
-      if (!c.request_id.empty())
-      {
-        out += ",";
-        appendJsonKey(out, "rid");
-        appendJsonStringValue(out, c.request_id);
-      }
-      if (!c.module.empty())
-      {
-        out += ",";
-        appendJsonKey(out, "mod");
-        appendJsonStringValue(out, c.module);
-      }
-      for (const auto &it : c.fields)
-      {
-        out += ",";
-        appendJsonKey(out, it.first);
-        appendJsonStringValue(out, it.second);
-      }
+      const ContextState &st = contextState();
+      out.append(st.base_json.data(), st.base_json.data() + st.base_json.size());
+      out.append(st.scoped_json.data(), st.scoped_json.data() + st.scoped_json.size());
 
       appendJsonKV(out, std::forward<Args>(kvpairs)...);
 
-      out += "}";
-      return out;
+      out.push_back('}');
     }
 
     /**
-     * @brief Append a value to pretty JSON output.
+     * @brief ANSI color codes used by pretty JSON.
      */
-    template <typename V>
-    static void appendJsonPrettyValue(std::string &out, V &&v, bool color)
+    static constexpr std::string_view kAnsiReset = "\033[0m";
+    static constexpr std::string_view kAnsiKey = "\033[36m";
+    static constexpr std::string_view kAnsiStr = "\033[32m";
+    static constexpr std::string_view kAnsiNum = "\033[33m";
+    static constexpr std::string_view kAnsiBool = "\033[35m";
+    static constexpr std::string_view kAnsiPunc = "\033[90m";
+    static constexpr std::string_view kAnsiBlue = "\033[34m";
+    static constexpr std::string_view kAnsiDim = "\033[2m";
+
+    /**
+     * @brief Append `s` wrapped with an ANSI color code when enabled.
+     */
+    static void appendColored(fmt::memory_buffer &out, std::string_view code, std::string_view s, bool on)
     {
-      using T = std::remove_cv_t<std::remove_reference_t<V>>;
+      if (on)
+        append(out, code);
+      append(out, s);
+      if (on)
+        append(out, kAnsiReset);
+    }
 
-      if constexpr (std::is_same_v<T, bool>)
-      {
-        const char *s = v ? "true" : "false";
-        out += c_bool(s, color);
-      }
-      else if constexpr (std::is_integral_v<T> || std::is_floating_point_v<T>)
-      {
-        out += c_num(fmt::format("{}", v), color);
-      }
-      else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>)
-      {
-        std::string tmp;
-        tmp.reserve(std::string_view(v).size() + 2);
-        tmp += "\"";
-        std::string escaped;
-        escaped.reserve(std::string_view(v).size() + 8);
-        appendJsonEscaped(escaped, std::string_view(v));
-        tmp += escaped;
-        tmp += "\"";
-
-        out += c_str(tmp, color);
-      }
-      else if constexpr (std::is_same_v<T, const char *> || std::is_same_v<T, char *>)
-      {
-        std::string_view sv = v ? std::string_view(v) : std::string_view("");
-        std::string escaped;
-        escaped.reserve(sv.size() + 8);
-        appendJsonEscaped(escaped, sv);
-
-        std::string tmp;
-        tmp.reserve(escaped.size() + 2);
-        tmp += "\"";
-        tmp += escaped;
-        tmp += "\"";
-
-        out += c_str(tmp, color);
-      }
-      else
-      {
-        const std::string s = fmt::format("{}", std::forward<V>(v));
-        std::string escaped;
-        escaped.reserve(s.size() + 8);
-        appendJsonEscaped(escaped, s);
-
-        std::string tmp;
-        tmp.reserve(escaped.size() + 2);
-        tmp += "\"";
-        tmp += escaped;
-        tmp += "\"";
-
-        out += c_str(tmp, color);
-      }
+    /**
+     * @brief Append a quoted, escaped string wrapped with an ANSI color code.
+     */
+    template <typename V>
+    static void appendColoredQuoted(fmt::memory_buffer &out, std::string_view code, V &&v, bool on)
+    {
+      if (on)
+        append(out, code);
+      appendJsonQuoted(out, std::forward<V>(v));
+      if (on)
+        append(out, kAnsiReset);
     }
 
     /**
-     * @brief Helpers for ANSI colored output (used by pretty JSON).
+     * @brief Append a number wrapped with an ANSI color code.
      */
-    static std::string c_red(std::string_view s, bool on) { return ansi_wrap("\033[31m", s, on); }
-    static std::string c_blue(std::string_view s, bool on) { return ansi_wrap("\033[34m", s, on); }
-    static std::string c_dim(std::string_view s, bool on) { return ansi_wrap("\033[2m", s, on); }
+    template <typename N>
+    static void appendColoredNumber(fmt::memory_buffer &out, std::string_view code, N n, bool on)
+    {
+      if (on)
+        append(out, code);
+      fmt::format_to(std::back_inserter(out), "{}", n);
+      if (on)
+        append(out, kAnsiReset);
+    }
 
     /**
-     * @brief Colorize HTTP status codes in pretty JSON.
+     * @brief Append an HTTP status code, colored by class in pretty JSON.
      */
     template <typename Int>
-    static std::string c_http_status(Int code, bool on)
+    static void appendHttpStatus(fmt::memory_buffer &out, Int code, bool on)
     {
       const int c = static_cast<int>(code);
-      const std::string s = fmt::format("{}", c);
-
-      if (!on)
-        return s;
 
+      std::string_view color = "\033[90m";
       if (c >= 200 && c < 300)
-        return ansi_wrap("\033[32m", s, true);
-      if (c >= 300 && c < 400)
-        return ansi_wrap("\033[36m", s, true);
-      if (c >= 400 && c < 500)
-        return ansi_wrap("\033[33m", s, true);
-      if (c >= 500 && c < 600)
-        return ansi_wrap("\033[31m", s, true);
-      return ansi_wrap("\033[90m", s, true);
+        color = "\033[32m";
+      else if (c >= 300 && c < 400)
+        color = "\033[36m";
+      else if (c >= 400 && c < 500)
+        color = "\033[33m";
+      else if (c >= 500 && c < 600)
+        color = "\033[31m";
+
+      appendColoredNumber(out, color, c, on);
     }
 
     /**
@@ -884,132 +1778,93 @@ namespace vix::utils
       return s.size() >= suf.size() && s.substr(s.size() - suf.size()) == suf;
     }
 
+    /**
+     * @brief Append one pretty JSON key (`  "key": `).
+     */
+    static void appendJsonPrettyKey(fmt::memory_buffer &out, std::string_view k, bool color)
+    {
+      append(out, "  ");
+      if (color)
+        append(out, kAnsiKey);
+      out.push_back('"');
+      append(out, k);
+      out.push_back('"');
+      if (color)
+        append(out, kAnsiReset);
+      appendColored(out, kAnsiPunc, ": ", color);
+    }
+
     /**
      * @brief Append pretty JSON key/value pairs.
      */
-    static void appendJsonPrettyKV(std::string &, bool) {}
+    static void appendJsonPrettyKV(fmt::memory_buffer &, bool) {}
 
     template <typename V, typename... Rest>
-    static void appendJsonPrettyKV(std::string &out, bool color, const char *k, V &&v, Rest &&...rest)
+    static void appendJsonPrettyKV(fmt::memory_buffer &out, bool color, const char *k, V &&v, Rest &&...rest)
     {
-      out += "  ";
-      out += c_key(std::string("\"") + k + "\"", color);
-      out += c_punc(": ", color);
+      appendJsonPrettyKey(out, k, color);
 
       using T = std::remove_cv_t<std::remove_reference_t<V>>;
 
       if constexpr (std::is_same_v<T, bool>)
       {
-        const char *s = v ? "true" : "false";
-        out += c_bool(s, color);
+        appendColored(out, kAnsiBool, v ? "true" : "false", color);
       }
       else if constexpr (std::is_integral_v<T> || std::is_floating_point_v<T>)
       {
         if (std::string_view(k) == "status")
         {
-          out += c_http_status(v, color);
+          appendHttpStatus(out, v, color);
         }
         else if (std::string_view(k) == "duration_ms" || ends_with(k, "_ms"))
         {
-          out += c_dim(c_blue(fmt::format("{}", v), color), color);
+          if (color)
+            append(out, kAnsiDim);
+          appendColoredNumber(out, kAnsiBlue, v, color);
+          if (color)
+            append(out, kAnsiReset);
         }
         else
         {
-          out += c_num(fmt::format("{}", v), color);
+          appendColoredNumber(out, kAnsiNum, v, color);
         }
       }
-      else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>)
+      else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view> ||
+                         std::is_same_v<T, const char *> || std::is_same_v<T, char *>)
       {
-        std::string escaped;
-        escaped.reserve(std::string_view(v).size() + 8);
-        appendJsonEscaped(escaped, std::string_view(v));
-
-        std::string tmp;
-        tmp.reserve(escaped.size() + 2);
-        tmp += "\"";
-        tmp += escaped;
-        tmp += "\"";
-
-        if (std::string_view(k) == "method" || std::string_view(k) == "path")
-          out += ansi_wrap("\033[36m", tmp, color);
-        else
-          out += c_str(tmp, color);
+        const bool accent = std::string_view(k) == "method" || std::string_view(k) == "path";
+        appendColoredQuoted(out, accent ? kAnsiKey : kAnsiStr, std::forward<V>(v), color);
       }
-      else if constexpr (std::is_same_v<T, const char *> || std::is_same_v<T, char *>)
+      else if constexpr (std::is_same_v<T, RawJson>)
       {
-        std::string_view sv = v ? std::string_view(v) : std::string_view("");
-        std::string escaped;
-        escaped.reserve(sv.size() + 8);
-        appendJsonEscaped(escaped, sv);
-
-        std::string tmp;
-        tmp.reserve(escaped.size() + 2);
-        tmp += "\"";
-        tmp += escaped;
-        tmp += "\"";
-
-        if (std::string_view(k) == "method" || std::string_view(k) == "path")
-          out += ansi_wrap("\033[36m", tmp, color);
-        else
-          out += c_str(tmp, color);
+        append(out, v.json);
       }
       else
       {
-        const std::string s = fmt::format("{}", std::forward<V>(v));
-        std::string escaped;
-        escaped.reserve(s.size() + 8);
-        appendJsonEscaped(escaped, s);
-
-        std::string tmp;
-        tmp.reserve(escaped.size() + 2);
-        tmp += "\"";
-        tmp += escaped;
-        tmp += "\"";
-
-        out += c_str(tmp, color);
+        appendColoredQuoted(out, kAnsiStr, std::forward<V>(v), color);
       }
 
-      out += c_punc(",\n", color);
+      appendColored(out, kAnsiPunc, ",\n", color);
 
       if constexpr (sizeof...(rest) > 0)
         appendJsonPrettyKV(out, color, std::forward<Rest>(rest)...);
     }
 
     /**
-     * @brief Build a pretty JSON log entry.
+     * @brief Build a pretty JSON log entry into `out`.
      */
     template <typename... Args>
-    std::string buildJsonPretty(Level level, std::string_view msg, Args &&...kvpairs) const
+    void buildJsonPretty(fmt::memory_buffer &out, Level level, std::string_view msg, Args &&...kvpairs) const
     {
       const bool color = Logger::jsonColorsEnabled();
 
-      std::string out;
-      out.reserve(512);
-      out += c_punc("{\n", color);
+      appendColored(out, kAnsiPunc, "{\n", color);
 
       auto add_str = [&](std::string_view k, std::string_view v)
       {
-        std::string kq;
-        kq.reserve(k.size() + 2);
-        kq += "\"";
-        kq.append(k.data(), k.size());
-        kq += "\"";
-
-        std::string escaped;
-        escaped.reserve(v.size() + 8);
-        appendJsonEscaped(escaped, v);
-
-        std::string vq;
-        vq.reserve(escaped.size() + 2);
-        vq += "\"";
-        vq += escaped;
-        vq += "\"";
-
-        out += "  ";
-        out += c_key(kq, color);
-        out += c_punc(": ", color);
-        out += c_str(vq, color);
-        out += c_punc(",\n", color);
+        appendJsonPrettyKey(out, k, color);
+        appendColoredQuoted(out, kAnsiStr, v, color);
+        appendColored(out, kAnsiPunc, ",\n", color);
       };
 
       add_str("level", levelToString(level));
@@ -1024,33 +1879,32 @@ namespace vix::utils
       for (const auto &it : c.fields)
         add_str(it.first, it.second);
 
-      appendJsonPrettyKV(out, color, std::forward<Args>(kvpairs)...);
+      const ContextState &st = tls_ctx_;
+      for (const auto &f : st.fields)
+        add_str(st.key(f), st.value(f));
 
-      auto ends_with_plain = [&](const std::string &suf) -> bool
-      {
-        return out.size() >= suf.size() && out.compare(out.size() - suf.size(), suf.size(), suf) == 0;
-      };
+      appendJsonPrettyKV(out, color, std::forward<Args>(kvpairs)...);
 
-      if (ends_with_plain(",\n"))
+      if (ends_with(std::string_view(out.data(), out.size()), ",\n"))
       {
-        out.pop_back();
-        out.pop_back();
-        out += "\n";
+        out.resize(out.size() - 2);
+        out.push_back('\n');
       }
 
-      out += c_punc("}", color);
+      appendColored(out, kAnsiPunc, "}", color);
       if (color)
-        out += "\033[0m";
-      return out;
+        append(out, kAnsiReset);
     }
 
     /**
      * @brief Append JSON key/value pairs (single-line JSON).
      */
+    static void appendJsonKV(fmt::memory_buffer &) {}
+
     template <typename V, typename... Rest>
-    static void appendJsonKV(std::string &out, const char *k, V &&v, Rest &&...rest)
+    static void appendJsonKV(fmt::memory_buffer &out, const char *k, V &&v, Rest &&...rest)
     {
-      out += ",";
+      out.push_back(',');
       appendJsonKey(out, k);
       appendJsonValue(out, std::forward<V>(v));
 
@@ -1059,44 +1913,130 @@ namespace vix::utils
     }
 
     /**
-     * @brief Wrap a string with an ANSI color code when enabled.
+     * @brief Per-thread formatting arena reused by logModule and logf.
+     *
+     * A lease hands out the thread-local buffer, cleared. If the buffer is
+     * already leased (a formatted argument logs from its formatter), the
+     * lease falls back to a private buffer so the outer line is not
+     * clobbered. Oversized arenas are dropped on release to bound memory.
      */
-    static std::string ansi_wrap(std::string_view code, std::string_view s, bool on)
+    class BufferLease
     {
-      if (!on)
-        return std::string(s);
+    public:
+      BufferLease() noexcept
+          : own_(!arena_busy())
+      {
+        if (own_)
+        {
+          arena_busy() = true;
+          arena().clear();
+        }
+      }
 
-      std::string out;
-      out.reserve(code.size() + s.size() + 8);
-      out += code;
-      out.append(s.data(), s.size());
-      out += "\033[0m";
-      return out;
-    }
+      ~BufferLease()
+      {
+        if (!own_)
+          return;
+
+        if (arena().capacity() > kMaxRetained)
+          arena() = fmt::memory_buffer();
+        arena_busy() = false;
+      }
+
+      BufferLease(const BufferLease &) = delete;
+      BufferLease &operator=(const BufferLease &) = delete;
+
+      fmt::memory_buffer &get() noexcept { return own_ ? arena() : local_; }
 
-    static std::string c_key(std::string_view s, bool on) { return ansi_wrap("\033[36m", s, on); }
-    static std::string c_str(std::string_view s, bool on) { return ansi_wrap("\033[32m", s, on); }
-    static std::string c_num(std::string_view s, bool on) { return ansi_wrap("\033[33m", s, on); }
-    static std::string c_bool(std::string_view s, bool on) { return ansi_wrap("\033[35m", s, on); }
-    static std::string c_punc(std::string_view s, bool on) { return ansi_wrap("\033[90m", s, on); }
+    private:
+      static constexpr std::size_t kMaxRetained = 64 * 1024;
+
+      static fmt::memory_buffer &arena() noexcept
+      {
+        thread_local fmt::memory_buffer buf;
+        return buf;
+      }
+
+      static bool &arena_busy() noexcept
+      {
+        thread_local bool busy = false;
+        return busy;
+      }
+
+      bool own_;
+      fmt::memory_buffer local_;
+    };
 
     /**
      * @brief Whether console synchronization is enabled.
      *
-     * Controlled by VIX_CONSOLE_SYNC:
+     * Controlled by VIX_CONSOLE_SYNC, read from env_snapshot():
      * - unset or 0/false: disabled
      * - otherwise: enabled
+     *
+     * Read when a pipeline is built (construction, setAsync, setFile), which
+     * also picks the matching console sink; log calls use the pipeline's
+     * copy. setAsync refreshes the snapshot first, so a change made with
+     * setenv takes effect at the next setAsync.
      */
     static bool console_sync_enabled()
     {
-      if (const char *v = vix::utils::vix_getenv("VIX_CONSOLE_SYNC"); v && *v)
-        return std::string_view(v) != "0" && std::string_view(v) != "false";
-      return false;
+      const std::string_view v = vix::utils::env_snapshot().view_or("VIX_CONSOLE_SYNC");
+      return !v.empty() && v != "0" && v != "false";
     }
   };
 
 } // namespace vix::utils
 
+/**
+ * @brief Level-gated logging macros.
+ *
+ * Below VIX_LOG_ACTIVE_LEVEL the whole statement, including argument
+ * evaluation, is discarded at compile time. Above it, arguments are only
+ * evaluated when the runtime level (setLevel) enables the call.
+ *
+ * `level` must be a constant Logger::Level.
+ */
+#define VIX_LOG(level, ...)                                                \
+  do                                                                       \
+  {                                                                        \
+    if constexpr (::vix::utils::Logger::compiled(level))                   \
+    {                                                                      \
+      auto &vix_logger_ = ::vix::utils::Logger::getInstance();             \
+      if (vix_logger_.enabled(level))                                      \
+        vix_logger_.log(level, __VA_ARGS__);                               \
+    }                                                                      \
+  } while (0)
+
+#define VIX_LOG_MODULE(module, level, ...)                                 \
+  do                                                                       \
+  {                                                                        \
+    if constexpr (::vix::utils::Logger::compiled(level))                   \
+    {                                                                      \
+      auto &vix_logger_ = ::vix::utils::Logger::getInstance();             \
+      if (vix_logger_.enabled(level))                                      \
+        vix_logger_.logModule(module, level, __VA_ARGS__);                 \
+    }                                                                      \
+  } while (0)
+
+#define VIX_LOGF(level, ...)                                               \
+  do                                                                       \
+  {                                                                        \
+    if constexpr (::vix::utils::Logger::compiled(level))                   \
+    {                                                                      \
+      auto &vix_logger_ = ::vix::utils::Logger::getInstance();             \
+      if (vix_logger_.enabled(level))                                      \
+        vix_logger_.logf(level, __VA_ARGS__);                              \
+    }                                                                      \
+  } while (0)
+
+#define VIX_LOG_TRACE(...) VIX_LOG(::vix::utils::Logger::Level::Trace, __VA_ARGS__)
+#define VIX_LOG_DEBUG(...) VIX_LOG(::vix::utils::Logger::Level::Debug, __VA_ARGS__)
+#define VIX_LOG_INFO(...) VIX_LOG(::vix::utils::Logger::Level::Info, __VA_ARGS__)
+#define VIX_LOG_WARN(...) VIX_LOG(::vix::utils::Logger::Level::Warn, __VA_ARGS__)
+#define VIX_LOG_ERROR(...) VIX_LOG(::vix::utils::Logger::Level::Error, __VA_ARGS__)
+#define VIX_LOG_CRITICAL(...) VIX_LOG(::vix::utils::Logger::Level::Critical, __VA_ARGS__)
+
 #if defined(_WIN32)
 
 #if defined(VIX_UTILS_RESTORE_MAX_MACRO)
@@ -0,0 +1,425 @@
+/**
+ *
+ *  @file Metrics.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_UTILS_METRICS_HPP
+#define VIX_UTILS_METRICS_HPP
+
+/**
+ * @brief In-process counters, gauges and latency histograms.
+ *
+ * Writers touch only their own shard: each thread is assigned one of
+ * kMetricShards cache-line-sized slots on first use, so 64 threads bumping
+ * the same Counter do not share a cache line. Reads walk the shards and
+ * merge them, which makes reads the (rare) expensive side.
+ *
+ * Histograms are HDR-style log-linear: values below 32 are exact, larger
+ * values fall in one of 16 sub-buckets per power of two (at most 6.25%
+ * relative bucket width). Shard bucket arrays are allocated on the first
+ * record from that shard.
+ *
+ * `MetricsRegistry` names metrics for export; `metrics_to_text` and
+ * `metrics_to_json` render a snapshot, and `Logger::logMetrics` writes one
+ * through the configured log format.
+ *
+ * @code
+ * using namespace vix::utils;
+ *
+ * auto &reg = MetricsRegistry::instance();
+ * Counter &requests = reg.counter("http.requests");
+ * Histogram &latency = reg.histogram("http.latency_ns");
+ *
+ * void handle(Request &req)
+ * {
+ *   ScopedTimer t(latency);
+ *   requests.inc();
+ *   ...
+ * }
+ *
+ * std::string json = metrics_to_json(reg.snapshot());
+ * @endcode
+ */
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <vix/utils/Time.hpp>
+
+namespace vix::utils
+{
+  /**
+   * @brief Number of per-thread shards kept by each metric.
+   *
+   * Threads beyond this count share shards round-robin.
+   */
+  inline constexpr std::size_t kMetricShards = 64;
+
+  namespace detail
+  {
+    /**
+     * @brief Shard of the calling thread, assigned round-robin on first use.
+     */
+    inline std::size_t metric_shard() noexcept
+    {
+      static std::atomic<std::size_t> next{0};
+      thread_local const std::size_t shard =
+          next.fetch_add(1, std::memory_order_relaxed) % kMetricShards;
+      return shard;
+    }
+  } // namespace detail
+
+  /**
+   * @class Counter
+   * @brief Monotonic counter sharded per thread.
+   *
+   * add() is one uncontended relaxed fetch_add on the caller's shard;
+   * value() sums the shards.
+   */
+  class Counter
+  {
+  public:
+    Counter() = default;
+    Counter(const Counter &) = delete;
+    Counter &operator=(const Counter &) = delete;
+
+    void add(std::uint64_t n) noexcept
+    {
+      cells_[detail::metric_shard()].v.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    void inc() noexcept { add(1); }
+
+    /**
+     * @brief Sum over all shards (not a consistent cut under concurrent adds).
+     */
+    std::uint64_t value() const noexcept
+    {
+      std::uint64_t sum = 0;
+      for (const Cell &c : cells_)
+        sum += c.v.load(std::memory_order_relaxed);
+      return sum;
+    }
+
+    void reset() noexcept
+    {
+      for (Cell &c : cells_)
+        c.v.store(0, std::memory_order_relaxed);
+    }
+
+  private:
+    struct alignas(64) Cell
+    {
+      std::atomic<std::uint64_t> v{0};
+    };
+
+    Cell cells_[kMetricShards];
+  };
+
+  /**
+   * @class Gauge
+   * @brief Current value (queue depth, open connections, ...).
+   *
+   * Not sharded: set() has last-writer-wins semantics, which shards could
+   * not provide. Gauges are usually written by one owner.
+   */
+  class Gauge
+  {
+  public:
+    Gauge() = default;
+    Gauge(const Gauge &) = delete;
+    Gauge &operator=(const Gauge &) = delete;
+
+    void set(std::int64_t v) noexcept { v_.store(v, std::memory_order_relaxed); }
+    void add(std::int64_t n) noexcept { v_.fetch_add(n, std::memory_order_relaxed); }
+    void sub(std::int64_t n) noexcept { v_.fetch_sub(n, std::memory_order_relaxed); }
+    std::int64_t value() const noexcept { return v_.load(std::memory_order_relaxed); }
+
+  private:
+    std::atomic<std::int64_t> v_{0};
+  };
+
+  /**
+   * @brief Merged histogram contents, as returned by Histogram::snapshot().
+   */
+  struct HistogramSnapshot
+  {
+    std::uint64_t count = 0;
+    std::uint64_t sum = 0;
+    std::uint64_t min = 0;
+    std::uint64_t max = 0;
+
+    /**
+     * @brief Per-bucket counts (Histogram::kBuckets entries, or empty).
+     */
+    std::vector<std::uint64_t> buckets;
+
+    double mean() const noexcept
+    {
+      return count ? static_cast<double>(sum) / static_cast<double>(count) : 0.0;
+    }
+
+    /**
+     * @brief Value at quantile q in [0, 1]: the midpoint of the bucket that
+     * holds it, clamped to [min, max] when min <= max. 0 when empty.
+     */
+    std::uint64_t percentile(double q) const noexcept;
+
+    /**
+     * @brief Add another snapshot's samples to this one.
+     */
+    void merge(const HistogramSnapshot &other);
+  };
+
+  /**
+   * @class Histogram
+   * @brief Log-linear histogram of non-negative integers (e.g. nanoseconds).
+   *
+   * record() updates the caller's shard with relaxed atomics: one bucket
+   * increment, one sum add, and min/max only when they move. Values at or
+   * above 2^48 land in the last bucket (their sum and max stay exact).
+   */
+  class Histogram
+  {
+  public:
+    /// Sub-buckets per power of two, as a bit count.
+    static constexpr unsigned kSubBits = 4;
+    static constexpr std::size_t kSub = std::size_t{1} << kSubBits;
+
+    /// Highest power of two with its own buckets.
+    static constexpr unsigned kMaxExp = 47;
+
+    static constexpr std::size_t kBuckets = kSub + (kMaxExp - kSubBits + 1) * kSub;
+
+    Histogram() = default;
+    Histogram(const Histogram &) = delete;
+    Histogram &operator=(const Histogram &) = delete;
+
+    ~Histogram()
+    {
+      for (auto &s : shards_)
+        delete s.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Bucket index of a value.
+     */
+    static constexpr std::size_t bucket_of(std::uint64_t v) noexcept
+    {
+      if (v < kSub)
+        return static_cast<std::size_t>(v);
+      const unsigned msb = static_cast<unsigned>(std::bit_width(v)) - 1;
+      if (msb > kMaxExp)
+        return kBuckets - 1;
+      const unsigned shift = msb - kSubBits;
+      return kSub + shift * kSub + static_cast<std::size_t>((v >> shift) - kSub);
+    }
+
+    /**
+     * @brief Smallest value that maps to bucket i.
+     */
+    static constexpr std::uint64_t bucket_low(std::size_t i) noexcept
+    {
+      if (i < 2 * kSub)
+        return i;
+      const std::size_t shift = (i - kSub) / kSub;
+      return static_cast<std::uint64_t>(kSub + (i - kSub) % kSub) << shift;
+    }
+
+    /**
+     * @brief Largest value that maps to bucket i (the last bucket is open-ended).
+     */
+    static constexpr std::uint64_t bucket_high(std::size_t i) noexcept
+    {
+      if (i + 1 >= kBuckets)
+        return std::numeric_limits<std::uint64_t>::max();
+      return bucket_low(i + 1) - 1;
+    }
+
+    void record(std::uint64_t v) noexcept
+    {
+      Shard *s = shard();
+      if (!s)
+        return;
+
+      s->buckets[bucket_of(v)].fetch_add(1, std::memory_order_relaxed);
+      s->sum.fetch_add(v, std::memory_order_relaxed);
+
+      std::uint64_t lo = s->min.load(std::memory_order_relaxed);
+      while (v < lo && !s->min.compare_exchange_weak(lo, v, std::memory_order_relaxed))
+      {
+      }
+      std::uint64_t hi = s->max.load(std::memory_order_relaxed);
+      while (v > hi && !s->max.compare_exchange_weak(hi, v, std::memory_order_relaxed))
+      {
+      }
+    }
+
+    /**
+     * @brief Merge all shards.
+     */
+    HistogramSnapshot snapshot() const;
+
+    void reset() noexcept;
+
+  private:
+    struct Shard
+    {
+      std::atomic<std::uint64_t> buckets[kBuckets]{};
+      std::atomic<std::uint64_t> sum{0};
+      std::atomic<std::uint64_t> min{std::numeric_limits<std::uint64_t>::max()};
+      std::atomic<std::uint64_t> max{0};
+    };
+
+    /**
+     * @brief Caller's shard, allocated on first use (nullptr if out of memory).
+     */
+    Shard *shard() noexcept
+    {
+      std::atomic<Shard *> &slot = shards_[detail::metric_shard()];
+      if (Shard *s = slot.load(std::memory_order_acquire))
+        return s;
+      return allocShard(slot);
+    }
+
+    static Shard *allocShard(std::atomic<Shard *> &slot) noexcept;
+
+    std::atomic<Shard *> shards_[kMetricShards]{};
+  };
+
+  /**
+   * @class ScopedTimer
+   * @brief Records the lifetime of a scope, in fast_now_ns() nanoseconds.
+   */
+  class [[nodiscard]] ScopedTimer
+  {
+  public:
+    explicit ScopedTimer(Histogram &h) noexcept
+        : h_(&h), t0_(fast_now_ns())
+    {
+    }
+
+    ScopedTimer(const ScopedTimer &) = delete;
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+    ~ScopedTimer()
+    {
+      if (h_)
+        h_->record(elapsed_ns());
+    }
+
+    /**
+     * @brief Nanoseconds since construction.
+     */
+    std::uint64_t elapsed_ns() const noexcept { return fast_now_ns() - t0_; }
+
+    /**
+     * @brief Do not record on destruction.
+     */
+    void dismiss() noexcept { h_ = nullptr; }
+
+  private:
+    Histogram *h_;
+    std::uint64_t t0_;
+  };
+
+  /**
+   * @brief Point-in-time values of a set of named metrics.
+   */
+  struct MetricsSnapshot
+  {
+    std::vector<std::pair<std::string, std::uint64_t>> counters;
+    std::vector<std::pair<std::string, std::int64_t>> gauges;
+    std::vector<std::pair<std::string, HistogramSnapshot>> histograms;
+  };
+
+  /**
+   * @class MetricsRegistry
+   * @brief Named metrics for export.
+   *
+   * Lookups take a lock and are meant for setup: keep the returned
+   * reference, which stays valid for the registry's lifetime. Collectors
+   * add computed values (queue depths, component stats) to each snapshot.
+   */
+  class MetricsRegistry
+  {
+  public:
+    using Collector = std::function<void(MetricsSnapshot &)>;
+
+    MetricsRegistry() = default;
+    MetricsRegistry(const MetricsRegistry &) = delete;
+    MetricsRegistry &operator=(const MetricsRegistry &) = delete;
+
+    /**
+     * @brief Process-wide registry, never destroyed.
+     */
+    static MetricsRegistry &instance();
+
+    Counter &counter(std::string_view name);
+    Gauge &gauge(std::string_view name);
+    Histogram &histogram(std::string_view name);
+
+    /**
+     * @brief Register a collector run by snapshot(); returns its id.
+     */
+    std::uint64_t addCollector(Collector fn);
+
+    /**
+     * @brief Unregister a collector; waits for a snapshot running it.
+     */
+    void removeCollector(std::uint64_t id);
+
+    /**
+     * @brief Values of every metric, sorted by name, then collector output.
+     */
+    MetricsSnapshot snapshot() const;
+
+  private:
+    mutable std::mutex mutex_;
+    std::map<std::string, std::unique_ptr<Counter>, std::less<>> counters_;
+    std::map<std::string, std::unique_ptr<Gauge>, std::less<>> gauges_;
+    std::map<std::string, std::unique_ptr<Histogram>, std::less<>> histograms_;
+
+    mutable std::mutex collectors_mutex_;
+    std::vector<std::pair<std::uint64_t, Collector>> collectors_;
+    std::uint64_t next_collector_ = 1;
+  };
+
+  /**
+   * @brief Render a snapshot as `name=value` entries joined by `sep`.
+   *
+   * Histograms expand to name.count, .sum, .min, .max, .mean, .p50, .p90,
+   * .p99 and .p999.
+   */
+  std::string metrics_to_text(const MetricsSnapshot &snap, char sep = '\n');
+
+  /**
+   * @brief Render a snapshot as one JSON object:
+   * `{"counters":{..},"gauges":{..},"histograms":{"name":{"count":..,..}}}`.
+   */
+  std::string metrics_to_json(const MetricsSnapshot &snap);
+
+} // namespace vix::utils
+
+#endif // VIX_UTILS_METRICS_HPP
@@ -0,0 +1,512 @@
+/**
+ *
+ *  @file Multipart.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_UTILS_MULTIPART_HPP
+#define VIX_UTILS_MULTIPART_HPP
+
+/**
+ * @brief Streaming multipart/form-data parser.
+ *
+ * The body is fed in chunks of any size; part bodies are handed back as
+ * views into the chunk being fed, so an upload is never buffered as a
+ * whole. Only part headers and a delimiter-sized carry between chunks are
+ * copied.
+ *
+ * The boundary is precompiled into a Boyer-Moore-Horspool matcher: body
+ * bytes that cannot end a delimiter are skipped up to a delimiter length
+ * at a time.
+ *
+ * @code{.cpp}
+ * struct Upload
+ * {
+ *   void on_part_begin(const vix::utils::MultipartParser::PartHeaders &h) { ... }
+ *   void on_part_data(std::string_view bytes) { file.write(bytes); }
+ *   void on_part_end() { ... }
+ * } upload;
+ *
+ * vix::utils::MultipartParser parser = vix::utils::MultipartParser::fromContentType(ct);
+ * while (read(chunk))
+ *   if (!parser.feed(chunk, upload))
+ *     return bad_request(parser.error());
+ * if (!parser.done())
+ *   return bad_request("truncated body");
+ * @endcode
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include <vix/utils/String.hpp>
+
+namespace vix::utils
+{
+  /**
+   * @brief Precompiled "\r\n--<boundary>" delimiter search (Boyer-Moore-Horspool).
+   */
+  class BoundaryMatcher
+  {
+  public:
+    /**
+     * @brief Longest accepted boundary (RFC 2046 allows 70).
+     */
+    static constexpr std::size_t kMaxBoundary = 200;
+
+    BoundaryMatcher() = default;
+
+    explicit BoundaryMatcher(std::string_view boundary)
+        : delim_("\r\n--")
+    {
+      delim_.append(boundary.substr(0, kMaxBoundary));
+
+      const std::size_t n = delim_.size();
+      for (auto &s : skip_)
+        s = static_cast<std::uint8_t>(n);
+      for (std::size_t i = 0; i + 1 < n; ++i)
+        skip_[static_cast<unsigned char>(delim_[i])] = static_cast<std::uint8_t>(n - 1 - i);
+    }
+
+    /**
+     * @brief Full delimiter, CRLF included.
+     */
+    std::string_view delimiter() const noexcept { return delim_; }
+
+    /**
+     * @brief Offset of the first full delimiter in hay, or npos.
+     */
+    std::size_t find(std::string_view hay) const noexcept
+    {
+      const std::size_t n = delim_.size();
+      if (n == 0 || hay.size() < n)
+        return std::string_view::npos;
+
+      const char *const d = delim_.data();
+      const char *const h = hay.data();
+      const std::size_t last = n - 1;
+      const char tail = d[last];
+
+      for (std::size_t i = 0; i + n <= hay.size();)
+      {
+        const char c = h[i + last];
+        if (c == tail && std::memcmp(h + i, d, last) == 0)
+          return i;
+        i += skip_[static_cast<unsigned char>(c)];
+      }
+      return std::string_view::npos;
+    }
+
+    /**
+     * @brief Length of the longest suffix of hay that is a proper prefix of the delimiter.
+     *
+     * Those bytes may be the start of a delimiter split across chunks.
+     */
+    std::size_t partialSuffix(std::string_view hay) const noexcept
+    {
+      const std::size_t n = delim_.size();
+      std::size_t k = hay.size() < n ? hay.size() : n - 1;
+      for (; k > 0; --k)
+      {
+        if (std::memcmp(hay.data() + hay.size() - k, delim_.data(), k) == 0)
+          return k;
+      }
+      return 0;
+    }
+
+  private:
+    std::string delim_;
+    std::uint8_t skip_[256] = {};
+  };
+
+  /**
+   * @brief Incremental multipart body parser.
+   *
+   * Handlers are duck-typed: any object with
+   * `on_part_begin(const PartHeaders&)`, `on_part_data(std::string_view)`
+   * and `on_part_end()`. One part may produce any number of data calls;
+   * the views are only valid during the call.
+   */
+  class MultipartParser
+  {
+  public:
+    /**
+     * @brief Headers of one part.
+     *
+     * All views point into the parser and stay valid until the part ends.
+     */
+    struct PartHeaders
+    {
+      /**
+       * @brief Header block, lines separated by CRLF, without the blank line.
+       */
+      std::string_view raw;
+
+      /**
+       * @brief Content-Disposition name parameter (form field).
+       */
+      std::string_view name;
+
+      /**
+       * @brief Content-Disposition filename parameter (empty if not a file).
+       */
+      std::string_view filename;
+
+      /**
+       * @brief Content-Type of the part (empty if absent).
+       */
+      std::string_view content_type;
+
+      /**
+       * @brief Value of a header (case-insensitive name), empty if absent.
+       */
+      std::string_view header(std::string_view field) const noexcept
+      {
+        for (std::string_view line : split_view(raw, "\r\n"))
+        {
+          const std::size_t colon = line.find(':');
+          if (colon == std::string_view::npos || colon != field.size() ||
+              !starts_with_icase(line, field))
+            continue;
+
+          std::string_view v = line.substr(colon + 1);
+          while (!v.empty() && (v.front() == ' ' || v.front() == '\t'))
+            v.remove_prefix(1);
+          while (!v.empty() && (v.back() == ' ' || v.back() == '\t'))
+            v.remove_suffix(1);
+          return v;
+        }
+        return {};
+      }
+    };
+
+    /**
+     * @brief Limits guarding against hostile input.
+     */
+    struct Options
+    {
+      /**
+       * @brief Maximum size of one part's header block.
+       */
+      std::size_t max_header_bytes;
+
+      Options() : max_header_bytes(16 * 1024) {}
+    };
+
+    /**
+     * @brief Build a parser for a boundary (without the leading "--").
+     */
+    explicit MultipartParser(std::string_view boundary, Options options = Options())
+        : matcher_(boundary), options_(options)
+    {
+      if (boundary.empty() || boundary.size() > BoundaryMatcher::kMaxBoundary)
+        fail("invalid multipart boundary");
+
+      // The first delimiter may open the body without a preceding CRLF:
+      // pretend one was seen.
+      carry_.reserve(matcher_.delimiter().size());
+      carry_.assign("\r\n");
+    }
+
+    /**
+     * @brief Build a parser from a Content-Type header value.
+     */
+    static MultipartParser fromContentType(std::string_view content_type, Options options = Options())
+    {
+      return MultipartParser(extract_boundary(content_type), options);
+    }
+
+    /**
+     * @brief Whether the closing delimiter has been seen.
+     */
+    bool done() const noexcept { return state_ == State::Done; }
+
+    /**
+     * @brief Whether parsing failed; see error().
+     */
+    bool failed() const noexcept { return state_ == State::Error; }
+
+    /**
+     * @brief Reason of the failure (empty if none).
+     */
+    std::string_view error() const noexcept { return error_; }
+
+    /**
+     * @brief Consume the next chunk of the body.
+     *
+     * @return False once the input is malformed (the parser then stays failed).
+     */
+    template <typename Handler>
+    bool feed(std::string_view data, Handler &handler)
+    {
+      while (!data.empty())
+      {
+        switch (state_)
+        {
+        case State::Preamble:
+        case State::Body:
+          scanBody(data, handler);
+          break;
+
+        case State::AfterDelimiter:
+          afterDelimiter(data, handler);
+          break;
+
+        case State::Headers:
+          readHeaders(data, handler);
+          break;
+
+        case State::Done:
+          return true; // epilogue is ignored
+
+        case State::Error:
+          return false;
+        }
+      }
+      return state_ != State::Error;
+    }
+
+  private:
+    enum class State
+    {
+      Preamble,
+      Body,
+      AfterDelimiter,
+      Headers,
+      Done,
+      Error
+    };
+
+    void fail(std::string_view why)
+    {
+      state_ = State::Error;
+      error_ = why;
+    }
+
+    /**
+     * @brief Body bytes are only delivered inside a part (the preamble is dropped).
+     */
+    template <typename Handler>
+    void emit(std::string_view bytes, Handler &handler)
+    {
+      if (state_ == State::Body && !bytes.empty())
+        handler.on_part_data(bytes);
+    }
+
+    template <typename Handler>
+    void delimiterFound(Handler &handler)
+    {
+      if (state_ == State::Body)
+        handler.on_part_end();
+      state_ = State::AfterDelimiter;
+      trailer_ = 0;
+    }
+
+    /**
+     * @brief Deliver body bytes up to the next delimiter.
+     *
+     * Bytes held back in carry_ from the previous chunk are resolved first
+     * (they are a delimiter prefix, possibly a false start).
+     */
+    template <typename Handler>
+    void scanBody(std::string_view &data, Handler &handler)
+    {
+      const std::string_view delim = matcher_.delimiter();
+
+      while (!carry_.empty())
+      {
+        const std::size_t k = carry_.size();
+        const std::size_t m = std::min(delim.size() - k, data.size());
+
+        if (std::memcmp(delim.data() + k, data.data(), m) == 0)
+        {
+          if (k + m == delim.size())
+          {
+            carry_.clear();
+            data.remove_prefix(m);
+            delimiterFound(handler);
+            return;
+          }
+
+          // Still a delimiter prefix; wait for more input.
+          carry_.append(data.data(), m);
+          data.remove_prefix(m);
+          return;
+        }
+
+        // False start: release bytes until the rest is a delimiter prefix again.
+        std::size_t s = 1;
+        while (s < k && std::memcmp(carry_.data() + s, delim.data(), k - s) != 0)
+          ++s;
+        emit(std::string_view(carry_.data(), s), handler);
+        carry_.erase(0, s);
+      }
+
+      const std::size_t pos = matcher_.find(data);
+      if (pos != std::string_view::npos)
+      {
+        emit(data.substr(0, pos), handler);
+        data.remove_prefix(pos + delim.size());
+        delimiterFound(handler);
+        return;
+      }
+
+      const std::size_t hold = matcher_.partialSuffix(data);
+      emit(data.substr(0, data.size() - hold), handler);
+      carry_.assign(data.data() + data.size() - hold, hold);
+      data = {};
+    }
+
+    /**
+     * @brief After a delimiter: "--" closes the body, CRLF opens a part.
+     *
+     * Transport padding (spaces, tabs) before the CRLF is skipped.
+     */
+    template <typename Handler>
+    void afterDelimiter(std::string_view &data, Handler &)
+    {
+      while (!data.empty())
+      {
+        const char c = data.front();
+        data.remove_prefix(1);
+
+        if (trailer_ == '-')
+        {
+          if (c != '-')
+            return fail("malformed multipart delimiter");
+          state_ = State::Done;
+          return;
+        }
+        if (trailer_ == '\r')
+        {
+          if (c != '\n')
+            return fail("malformed multipart delimiter");
+          state_ = State::Headers;
+          // Seeded with the CRLF just read, so an empty header block is
+          // found by the same "\r\n\r\n" search.
+          headers_.assign("\r\n");
+          return;
+        }
+
+        if (c == '-' || c == '\r')
+          trailer_ = c;
+        else if (c != ' ' && c != '\t')
+          return fail("malformed multipart delimiter");
+      }
+    }
+
+    template <typename Handler>
+    void readHeaders(std::string_view &data, Handler &handler)
+    {
+      const std::size_t before = headers_.size();
+      const std::size_t room = options_.max_header_bytes + 4 - std::min(before, options_.max_header_bytes + 4);
+      const std::size_t take = std::min(data.size(), room);
+      headers_.append(data.data(), take);
+
+      const std::size_t from = before >= 3 ? before - 3 : 0;
+      const std::size_t end = headers_.find("\r\n\r\n", from);
+      if (end == std::string::npos)
+      {
+        if (take < data.size())
+          return fail("multipart part headers too large");
+        data = {};
+        return;
+      }
+
+      // Only the bytes up to the blank line belong to the headers.
+      data.remove_prefix(end + 4 - before);
+      headers_.resize(end);
+
+      // end == 0: no header lines, the seed CRLF was the block's first half.
+      part_ = PartHeaders{};
+      if (end > 2)
+        part_.raw = std::string_view(headers_).substr(2);
+      part_.content_type = part_.header("Content-Type");
+      const std::string_view disposition = part_.header("Content-Disposition");
+      part_.name = param(disposition, "name");
+      part_.filename = param(disposition, "filename");
+
+      state_ = State::Body;
+      handler.on_part_begin(part_);
+    }
+
+    /**
+     * @brief Parameter value of a header like `form-data; name="a"; filename=b`.
+     *
+     * Quotes are stripped; escapes inside quoted strings are not processed.
+     * Tokens without a value (`form-data; foo; name="x"`) are skipped.
+     */
+    static std::string_view param(std::string_view value, std::string_view key) noexcept
+    {
+      std::size_t i = value.find(';');
+      while (i != std::string_view::npos)
+      {
+        ++i;
+        while (i < value.size() && (value[i] == ' ' || value[i] == '\t'))
+          ++i;
+
+        const std::string_view rest = value.substr(i);
+        const bool match = rest.size() > key.size() && rest[key.size()] == '=' &&
+                           starts_with_icase(rest, key);
+
+        std::size_t j = rest.find_first_of("=;");
+        if (j == std::string_view::npos)
+          return {};
+        if (rest[j] == ';')
+        {
+          i += j;
+          continue;
+        }
+        ++j;
+
+        std::string_view v;
+        std::size_t next;
+        if (j < rest.size() && rest[j] == '"')
+        {
+          const std::size_t close = rest.find('"', j + 1);
+          v = rest.substr(j + 1, close == std::string_view::npos ? std::string_view::npos : close - j - 1);
+          next = close == std::string_view::npos ? std::string_view::npos : rest.find(';', close);
+        }
+        else
+        {
+          next = rest.find(';', j);
+          v = rest.substr(j, next == std::string_view::npos ? std::string_view::npos : next - j);
+          while (!v.empty() && (v.back() == ' ' || v.back() == '\t'))
+            v.remove_suffix(1);
+        }
+
+        if (match)
+          return v;
+        if (next == std::string_view::npos)
+          return {};
+        i += next;
+      }
+      return {};
+    }
+
+    BoundaryMatcher matcher_;
+    Options options_;
+    State state_ = State::Preamble;
+    std::string_view error_;
+    std::string carry_;
+    std::string headers_;
+    PartHeaders part_;
+    char trailer_ = 0;
+  };
+
+} // namespace vix::utils
+
+#endif // VIX_UTILS_MULTIPART_HPP
@@ -68,66 +68,252 @@ namespace vix::utils
     return false;
   }
 
-  inline bool is_normal_network_disconnect_message(std::string_view message) noexcept
+  namespace detail
   {
-    return contains_token_icase(message, "broken pipe") ||
-           contains_token_icase(message, "connection reset") ||
-           contains_token_icase(message, "connection reset by peer") ||
-           contains_token_icase(message, "operation canceled") ||
-           contains_token_icase(message, "operation cancelled") ||
-           contains_token_icase(message, "canceled") ||
-           contains_token_icase(message, "cancelled") ||
-           contains_token_icase(message, "end of file") ||
-           contains_token_icase(message, "eof");
-  }
+    /*
+     * Phrases that mark a normal peer disconnect in an error message.
+     * Matched case-insensitively anywhere in the text.
+     */
+    inline constexpr std::string_view kDisconnectTokens[] = {
+        "broken pipe",
+        "connection reset",
+        "connection reset by peer",
+        "operation canceled",
+        "operation cancelled",
+        "canceled",
+        "cancelled",
+        "end of file",
+        "eof",
+    };
 
-  inline bool is_normal_network_disconnect(const std::system_error &e) noexcept
-  {
-    const auto code = e.code();
+    /*
+     * Aho-Corasick automaton over ASCII letters and space, built at compile
+     * time and flattened into a full transition table: matching is one
+     * table lookup per input byte and a single pass over the text,
+     * whatever the number of tokens.
+     *
+     * Byte classes: 0 = anything else, 1..26 = letters (either case),
+     * 27 = space.
+     */
+    template <std::size_t MaxStates>
+    struct IcaseMatcher
+    {
+      static constexpr std::size_t kClasses = 28;
+
+      unsigned char cls[256]{};
+      unsigned char next[MaxStates][kClasses]{};
+      bool accept[MaxStates]{};
+      std::size_t states = 1;
+
+      constexpr bool search(std::string_view text) const noexcept
+      {
+        unsigned state = 0;
+
+        for (const char c : text)
+        {
+          state = next[state][cls[static_cast<unsigned char>(c)]];
+
+          if (accept[state])
+          {
+            return true;
+          }
+        }
+
+        return false;
+      }
+    };
 
-    if (code == std::errc::operation_canceled ||
-        code == std::errc::broken_pipe ||
-        code == std::errc::connection_reset ||
-        code == std::errc::connection_aborted ||
-        code == std::errc::timed_out)
+    template <std::size_t MaxStates, std::size_t N>
+    constexpr IcaseMatcher<MaxStates> build_icase_matcher(const std::string_view (&tokens)[N])
     {
-      return true;
+      IcaseMatcher<MaxStates> m{};
+      constexpr std::size_t K = IcaseMatcher<MaxStates>::kClasses;
+
+      for (int c = 'a'; c <= 'z'; ++c)
+      {
+        m.cls[c] = static_cast<unsigned char>(c - 'a' + 1);
+        m.cls[c - 'a' + 'A'] = static_cast<unsigned char>(c - 'a' + 1);
+      }
+      m.cls[static_cast<unsigned char>(' ')] = 27;
+
+      // Trie; 0 in next[][] means "no edge" until the failure pass fills it.
+      for (const std::string_view token : tokens)
+      {
+        std::size_t state = 0;
+
+        for (const char c : token)
+        {
+          const unsigned char k = m.cls[static_cast<unsigned char>(c)];
+
+          if (m.next[state][k] == 0)
+          {
+            m.next[state][k] = static_cast<unsigned char>(m.states++);
+          }
+
+          state = m.next[state][k];
+        }
+
+        m.accept[state] = true;
+      }
+
+      // Breadth-first failure links, folded into the transition table.
+      std::size_t fail[MaxStates]{};
+      std::size_t queue[MaxStates]{};
+      std::size_t head = 0;
+      std::size_t tail = 0;
+
+      for (std::size_t k = 0; k < K; ++k)
+      {
+        if (m.next[0][k] != 0)
+        {
+          queue[tail++] = m.next[0][k];
+        }
+      }
+
+      while (head < tail)
+      {
+        const std::size_t s = queue[head++];
+        m.accept[s] = m.accept[s] || m.accept[fail[s]];
+
+        for (std::size_t k = 0; k < K; ++k)
+        {
+          const std::size_t t = m.next[s][k];
+
+          if (t != 0)
+          {
+            fail[t] = m.next[fail[s]][k];
+            queue[tail++] = t;
+          }
+          else
+          {
+            m.next[s][k] = m.next[fail[s]][k];
+          }
+        }
+      }
+
+      return m;
     }
 
-#ifdef ECANCELED
-    if (code.value() == ECANCELED)
+    inline constexpr auto kDisconnectMatcher = build_icase_matcher<96>(kDisconnectTokens);
+
+    static_assert(kDisconnectMatcher.states <= 96, "raise the matcher state budget");
+    static_assert(kDisconnectMatcher.search("write: Broken Pipe"));
+    static_assert(!kDisconnectMatcher.search("connection refused"));
+
+    /*
+     * errno values that mean the peer went away or the operation was
+     * cancelled, as a bitmap indexed by value.
+     */
+    struct DisconnectErrnos
     {
-      return true;
+      static constexpr int kMax = 256;
+
+      bool set[kMax]{};
+
+      constexpr DisconnectErrnos()
+      {
+        const int values[] = {
+            static_cast<int>(std::errc::operation_canceled),
+            static_cast<int>(std::errc::broken_pipe),
+            static_cast<int>(std::errc::connection_reset),
+            static_cast<int>(std::errc::connection_aborted),
+            static_cast<int>(std::errc::timed_out),
+        };
+
+        for (const int v : values)
+        {
+          if (v >= 0 && v < kMax)
+          {
+            set[v] = true;
+          }
+        }
+      }
+
+      constexpr bool contains(int value) const noexcept
+      {
+        return value >= 0 && value < kMax && set[value];
+      }
+    };
+
+    inline constexpr DisconnectErrnos kDisconnectErrnos{};
+
+    inline bool is_system_or_generic(const std::error_category &cat) noexcept
+    {
+      return cat == std::system_category() || cat == std::generic_category();
     }
-#endif
 
-#ifdef EPIPE
-    if (code.value() == EPIPE)
+    /*
+     * Code-only part of the classification: the raw value against the errno
+     * table (any category, as the message-free check always did), then the
+     * generic condition of any non-generic category. The second step keeps
+     * system codes whose value is not an errno (WSAECONNRESET on Windows)
+     * equivalent to their std::errc.
+     */
+    inline bool is_disconnect_code(const std::error_code &code) noexcept
     {
-      return true;
+      if (!code)
+      {
+        return false;
+      }
+
+      if (kDisconnectErrnos.contains(code.value()))
+      {
+        return true;
+      }
+
+      const std::error_category &cat = code.category();
+
+      if (cat == std::generic_category())
+      {
+        return false;
+      }
+
+      const std::error_condition cond = cat.default_error_condition(code.value());
+
+      return cond.category() == std::generic_category() &&
+             kDisconnectErrnos.contains(cond.value());
     }
-#endif
+  }
+
+  inline bool is_normal_network_disconnect_message(std::string_view message) noexcept
+  {
+    return detail::kDisconnectMatcher.search(message);
+  }
 
-#ifdef ECONNRESET
-    if (code.value() == ECONNRESET)
+  /*
+   * Classify a raw error code without building an exception. The errno
+   * table answers system and generic codes; codes from other categories
+   * (asio's misc "End of file", TLS libraries, ...) also have their message
+   * checked, which may allocate.
+   */
+  inline bool is_normal_network_disconnect(const std::error_code &code) noexcept
+  {
+    if (detail::is_disconnect_code(code))
     {
       return true;
     }
-#endif
 
-#ifdef ECONNABORTED
-    if (code.value() == ECONNABORTED)
+    if (!code || detail::is_system_or_generic(code.category()))
     {
-      return true;
+      return false;
     }
-#endif
 
-#ifdef ETIMEDOUT
-    if (code.value() == ETIMEDOUT)
+    try
+    {
+      return is_normal_network_disconnect_message(code.message());
+    }
+    catch (...)
+    {
+      return false;
+    }
+  }
+
+  inline bool is_normal_network_disconnect(const std::system_error &e) noexcept
+  {
+    if (detail::is_disconnect_code(e.code()))
     {
       return true;
     }
-#endif
 
     return is_normal_network_disconnect_message(e.what());
   }
@@ -0,0 +1,776 @@
+/**
+ *
+ *  @file Pattern.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_UTILS_PATTERN_HPP
+#define VIX_UTILS_PATTERN_HPP
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Full-match patterns compiled to a DFA, with a std::regex fallback.
+ *
+ * `Pattern` accepts ECMAScript syntax. The common validation subset is
+ * compiled once into a byte-class DFA, so a match is one table lookup per
+ * input byte with no allocation and no backtracking:
+ *
+ * - literals and identity escapes, `.`, `\d \w \s \D \W \S`, `\t \n \r \f \v \0`
+ * - bracket classes with ranges and negation (`[a-z_]`, `[^@\s]`)
+ * - groups `( )` and `(?: )`, alternation `|`
+ * - quantifiers `* + ? {m} {m,} {m,n}` (lazy forms match the same language)
+ * - `^` at the start and `$` at the end (implied by full matching)
+ *
+ * Anything else (back-references, lookaround, `\b`, `\x`/`\u` escapes,
+ * POSIX classes), or a pattern whose DFA would exceed `kMaxStates`, keeps
+ * using `std::regex_match`, so results are the same either way.
+ *
+ * The DFA's `\d \w \s` are the ASCII sets `[0-9]`, `[A-Za-z0-9_]` and
+ * `[ \t\n\v\f\r]`, which is what std::regex yields under the classic "C"
+ * locale. A different global locale can widen std::regex's classes for
+ * bytes >= 0x80; the DFA ignores it.
+ *
+ * @code
+ * vix::utils::Pattern email(R"(^[^@\s]+@[^@\s]+\.[^@\s]+$)");
+ * bool ok = email.matches("ada@example.com"); // DFA path
+ * @endcode
+ */
+
+namespace vix::utils
+{
+  class Pattern
+  {
+  public:
+    /**
+     * @brief Upper bound on DFA states before falling back to std::regex.
+     */
+    static constexpr std::size_t kMaxStates = 1024;
+
+    Pattern() = default;
+
+    /**
+     * @brief Compile `source` (ECMAScript grammar).
+     *
+     * @throws std::regex_error if the pattern is invalid and needs std::regex.
+     */
+    explicit Pattern(std::string_view source) : source_(source)
+    {
+      if (!compileDfa())
+        regex_ = std::make_shared<const std::regex>(source_);
+    }
+
+    /**
+     * @brief Wrap an existing std::regex (flags are kept).
+     */
+    explicit Pattern(std::regex re, std::string_view source = {})
+        : source_(source), regex_(std::make_shared<const std::regex>(std::move(re)))
+    {
+    }
+
+    /**
+     * @brief Whether the whole input matches.
+     */
+    bool matches(std::string_view s) const
+    {
+      if (!trans_.empty())
+        return runDfa(s);
+      if (regex_)
+        return std::regex_match(s.begin(), s.end(), *regex_);
+      return s.empty();
+    }
+
+    /**
+     * @brief Whether the DFA path is used.
+     */
+    bool compiled() const noexcept { return !trans_.empty(); }
+
+    const std::string &source() const noexcept { return source_; }
+
+    /**
+     * @brief Number of DFA states (0 on the std::regex path).
+     */
+    std::size_t states() const noexcept { return accept_.size(); }
+
+  private:
+    using ByteSet = std::bitset<256>;
+
+    // ---- AST ---------------------------------------------------------------
+
+    struct Node
+    {
+      enum Kind : std::uint8_t
+      {
+        Set,
+        Concat,
+        Alt,
+        Repeat,
+        Empty
+      };
+
+      Kind kind = Empty;
+      int set = -1;          // Set
+      std::vector<int> kids; // Concat / Alt / Repeat (one child)
+      int min = 0;           // Repeat
+      int max = -1;          // Repeat, -1 = unbounded
+    };
+
+    /**
+     * @brief Recursive-descent parser for the supported subset.
+     *
+     * Every method returns -1 (or false) on syntax it does not handle, which
+     * sends the whole pattern to std::regex.
+     */
+    struct Parser
+    {
+      std::string_view p;
+      std::size_t i = 0;
+      std::vector<Node> nodes;
+      std::vector<ByteSet> sets;
+      int depth = 0;
+
+      static constexpr int kMaxRepeat = 1000;
+
+      int add(Node n)
+      {
+        nodes.push_back(std::move(n));
+        return static_cast<int>(nodes.size()) - 1;
+      }
+
+      int addSet(const ByteSet &b)
+      {
+        sets.push_back(b);
+        Node n;
+        n.kind = Node::Set;
+        n.set = static_cast<int>(sets.size()) - 1;
+        return add(std::move(n));
+      }
+
+      bool eof() const noexcept { return i >= p.size(); }
+
+      static ByteSet range(unsigned char a, unsigned char b)
+      {
+        ByteSet s;
+        for (unsigned c = a; c <= b; ++c)
+          s.set(c);
+        return s;
+      }
+
+      static ByteSet digit() { return range('0', '9'); }
+
+      static ByteSet word()
+      {
+        ByteSet s = range('a', 'z') | range('A', 'Z') | digit();
+        s.set('_');
+        return s;
+      }
+
+      static ByteSet space()
+      {
+        ByteSet s;
+        for (const char c : {' ', '\t', '\n', '\v', '\f', '\r'})
+          s.set(static_cast<unsigned char>(c));
+        return s;
+      }
+
+      /**
+       * @brief Class escapes (`\d` etc.); false if `c` is not one.
+       */
+      static bool classEscape(char c, ByteSet &out)
+      {
+        switch (c)
+        {
+        case 'd':
+          out = digit();
+          return true;
+        case 'D':
+          out = ~digit();
+          return true;
+        case 'w':
+          out = word();
+          return true;
+        case 'W':
+          out = ~word();
+          return true;
+        case 's':
+          out = space();
+          return true;
+        case 'S':
+          out = ~space();
+          return true;
+        default:
+          return false;
+        }
+      }
+
+      /**
+       * @brief Single-character escapes; -1 if unsupported.
+       */
+      int charEscape(char c, bool in_class) const
+      {
+        switch (c)
+        {
+        case 't':
+          return '\t';
+        case 'n':
+          return '\n';
+        case 'r':
+          return '\r';
+        case 'f':
+          return '\f';
+        case 'v':
+          return '\v';
+        case '0':
+          return (i < p.size() && p[i] >= '0' && p[i] <= '9') ? -1 : 0;
+        case 'b':
+          return in_class ? '\b' : -1;
+        default:
+          break;
+        }
+        const auto u = static_cast<unsigned char>(c);
+        const bool alnum = (u >= '0' && u <= '9') || (u >= 'a' && u <= 'z') || (u >= 'A' && u <= 'Z');
+        if (alnum || u >= 0x80)
+          return -1;
+        return u;
+      }
+
+      int parseAlt()
+      {
+        Node alt;
+        alt.kind = Node::Alt;
+        for (;;)
+        {
+          const int c = parseConcat();
+          if (c < 0)
+            return -1;
+          alt.kids.push_back(c);
+          if (eof() || p[i] != '|')
+            break;
+          ++i;
+        }
+        return alt.kids.size() == 1 ? alt.kids[0] : add(std::move(alt));
+      }
+
+      int parseConcat()
+      {
+        Node cat;
+        cat.kind = Node::Concat;
+        while (!eof() && p[i] != '|' && p[i] != ')')
+        {
+          const int r = parseRepeat();
+          if (r == kSkip)
+            continue;
+          if (r < 0)
+            return -1;
+          cat.kids.push_back(r);
+        }
+        if (cat.kids.empty())
+          return add(Node{});
+        return cat.kids.size() == 1 ? cat.kids[0] : add(std::move(cat));
+      }
+
+      static constexpr int kSkip = -2;
+
+      bool parseInt(int &out)
+      {
+        const std::size_t start = i;
+        long v = 0;
+        while (!eof() && p[i] >= '0' && p[i] <= '9')
+        {
+          v = v * 10 + (p[i] - '0');
+          if (v > kMaxRepeat)
+            return false;
+          ++i;
+        }
+        out = static_cast<int>(v);
+        return i != start;
+      }
+
+      int parseRepeat()
+      {
+        const int atom = parseAtom();
+        if (atom < 0 || atom == kSkip)
+          return atom;
+
+        if (eof())
+          return atom;
+
+        int min = 0;
+        int max = -1;
+        switch (p[i])
+        {
+        case '*':
+          ++i;
+          break;
+        case '+':
+          min = 1;
+          ++i;
+          break;
+        case '?':
+          max = 1;
+          ++i;
+          break;
+        case '{':
+        {
+          ++i;
+          if (!parseInt(min))
+            return -1;
+          max = min;
+          if (!eof() && p[i] == ',')
+          {
+            ++i;
+            max = -1;
+            if (!eof() && p[i] != '}' && (!parseInt(max) || max < min))
+              return -1;
+          }
+          if (eof() || p[i] != '}')
+            return -1;
+          ++i;
+          break;
+        }
+        default:
+          return atom;
+        }
+
+        if (!eof() && p[i] == '?')
+          ++i; // lazy: same language under full matching
+        if (!eof() && (p[i] == '*' || p[i] == '+' || p[i] == '?' || p[i] == '{'))
+          return -1;
+
+        Node rep;
+        rep.kind = Node::Repeat;
+        rep.kids.push_back(atom);
+        rep.min = min;
+        rep.max = max;
+        return add(std::move(rep));
+      }
+
+      int parseAtom()
+      {
+        const char c = p[i++];
+        switch (c)
+        {
+        case '^':
+          return i == 1 ? kSkip : -1;
+        case '$':
+          return (i == p.size() && depth == 0) ? kSkip : -1;
+        case '.':
+        {
+          ByteSet s;
+          s.set();
+          s.reset('\n');
+          s.reset('\r');
+          return addSet(s);
+        }
+        case '(':
+        {
+          if (!eof() && p[i] == '?')
+          {
+            if (i + 1 >= p.size() || p[i + 1] != ':')
+              return -1;
+            i += 2;
+          }
+          ++depth;
+          const int inner = parseAlt();
+          --depth;
+          if (inner < 0 || eof() || p[i] != ')')
+            return -1;
+          ++i;
+          return inner;
+        }
+        case '[':
+          return parseClass();
+        case '\\':
+        {
+          if (eof())
+            return -1;
+          const char e = p[i++];
+          ByteSet s;
+          if (classEscape(e, s))
+            return addSet(s);
+          const int ch = charEscape(e, false);
+          if (ch < 0)
+            return -1;
+          s.set(static_cast<unsigned char>(ch));
+          return addSet(s);
+        }
+        case ')':
+        case '*':
+        case '+':
+        case '?':
+        case '{':
+        case '}':
+        case ']':
+        case '|':
+          return -1;
+        default:
+        {
+          ByteSet s;
+          s.set(static_cast<unsigned char>(c));
+          return addSet(s);
+        }
+        }
+      }
+
+      /**
+       * @brief One class member: a single byte (returned) or a class escape (in `set`).
+       */
+      int classAtom(ByteSet &set, bool &is_set)
+      {
+        is_set = false;
+        if (eof())
+          return -1;
+        const char c = p[i++];
+        if (c == '\\')
+        {
+          if (eof())
+            return -1;
+          const char e = p[i++];
+          if (classEscape(e, set))
+          {
+            is_set = true;
+            return 0;
+          }
+          return charEscape(e, true);
+        }
+        if (c == '[' && !eof() && (p[i] == ':' || p[i] == '.' || p[i] == '='))
+          return -1;
+        return static_cast<unsigned char>(c);
+      }
+
+      int parseClass()
+      {
+        bool negate = false;
+        if (!eof() && p[i] == '^')
+        {
+          negate = true;
+          ++i;
+        }
+        if (eof() || p[i] == ']')
+          return -1;
+
+        ByteSet set;
+        while (!eof() && p[i] != ']')
+        {
+          ByteSet esc;
+          bool is_set = false;
+          const int lo = classAtom(esc, is_set);
+          if (lo < 0)
+            return -1;
+          if (is_set)
+          {
+            if (i + 1 < p.size() && p[i] == '-' && p[i + 1] != ']')
+              return -1; // range from a class escape
+            set |= esc;
+            continue;
+          }
+
+          if (i + 1 < p.size() && p[i] == '-' && p[i + 1] != ']')
+          {
+            ++i;
+            const int hi = classAtom(esc, is_set);
+            if (hi < 0 || is_set || hi < lo)
+              return -1;
+            set |= range(static_cast<unsigned char>(lo), static_cast<unsigned char>(hi));
+          }
+          else
+          {
+            set.set(static_cast<unsigned char>(lo));
+          }
+        }
+        if (eof())
+          return -1;
+        ++i; // ']'
+        return addSet(negate ? ~set : set);
+      }
+    };
+
+    // ---- NFA ---------------------------------------------------------------
+
+    struct NfaState
+    {
+      int set = -1; // byte transition to next, or -1
+      int next = -1;
+      std::vector<int> eps;
+    };
+
+    struct Nfa
+    {
+      std::vector<NfaState> states;
+      const Parser *ast = nullptr;
+
+      static constexpr std::size_t kMaxNfaStates = 8192;
+
+      int fresh()
+      {
+        states.emplace_back();
+        return static_cast<int>(states.size()) - 1;
+      }
+
+      /**
+       * @brief Thompson construction; returns {entry, exit} or {-1, -1}.
+       */
+      std::pair<int, int> build(int id)
+      {
+        if (states.size() > kMaxNfaStates)
+          return {-1, -1};
+
+        const Node &n = ast->nodes[static_cast<std::size_t>(id)];
+        switch (n.kind)
+        {
+        case Node::Empty:
+        {
+          const int s = fresh();
+          return {s, s};
+        }
+        case Node::Set:
+        {
+          const int a = fresh();
+          const int b = fresh();
+          states[static_cast<std::size_t>(a)].set = n.set;
+          states[static_cast<std::size_t>(a)].next = b;
+          return {a, b};
+        }
+        case Node::Concat:
+        {
+          int in = -1;
+          int out = -1;
+          for (const int k : n.kids)
+          {
+            const auto [a, b] = build(k);
+            if (a < 0)
+              return {-1, -1};
+            if (in < 0)
+              in = a;
+            else
+              states[static_cast<std::size_t>(out)].eps.push_back(a);
+            out = b;
+          }
+          return {in, out};
+        }
+        case Node::Alt:
+        {
+          const int in = fresh();
+          const int out = fresh();
+          for (const int k : n.kids)
+          {
+            const auto [a, b] = build(k);
+            if (a < 0)
+              return {-1, -1};
+            states[static_cast<std::size_t>(in)].eps.push_back(a);
+            states[static_cast<std::size_t>(b)].eps.push_back(out);
+          }
+          return {in, out};
+        }
+        case Node::Repeat:
+        {
+          const int child = n.kids[0];
+          const int in = fresh();
+          int cur = in;
+          for (int r = 0; r < n.min; ++r)
+          {
+            const auto [a, b] = build(child);
+            if (a < 0)
+              return {-1, -1};
+            states[static_cast<std::size_t>(cur)].eps.push_back(a);
+            cur = b;
+          }
+          const int out = fresh();
+          if (n.max < 0)
+          {
+            const auto [a, b] = build(child);
+            if (a < 0)
+              return {-1, -1};
+            states[static_cast<std::size_t>(cur)].eps.push_back(a);
+            states[static_cast<std::size_t>(b)].eps.push_back(cur);
+            states[static_cast<std::size_t>(cur)].eps.push_back(out);
+          }
+          else
+          {
+            for (int r = n.min; r < n.max; ++r)
+            {
+              const auto [a, b] = build(child);
+              if (a < 0)
+                return {-1, -1};
+              states[static_cast<std::size_t>(cur)].eps.push_back(a);
+              states[static_cast<std::size_t>(cur)].eps.push_back(out);
+              cur = b;
+            }
+            states[static_cast<std::size_t>(cur)].eps.push_back(out);
+          }
+          return {in, out};
+        }
+        }
+        return {-1, -1};
+      }
+
+      void closure(std::vector<int> &set, std::vector<char> &seen) const
+      {
+        std::vector<int> stack(set.begin(), set.end());
+        for (const int s : set)
+          seen[static_cast<std::size_t>(s)] = 1;
+        while (!stack.empty())
+        {
+          const int s = stack.back();
+          stack.pop_back();
+          for (const int e : states[static_cast<std::size_t>(s)].eps)
+          {
+            if (!seen[static_cast<std::size_t>(e)])
+            {
+              seen[static_cast<std::size_t>(e)] = 1;
+              set.push_back(e);
+              stack.push_back(e);
+            }
+          }
+        }
+        std::sort(set.begin(), set.end());
+        for (const int s : set)
+          seen[static_cast<std::size_t>(s)] = 0;
+      }
+    };
+
+    // ---- DFA ---------------------------------------------------------------
+
+    bool compileDfa()
+    {
+      Parser ps;
+      ps.p = source_;
+      const int root = ps.parseAlt();
+      if (root < 0 || !ps.eof())
+        return false;
+
+      Nfa nfa;
+      nfa.ast = &ps;
+      const auto [start, accept] = nfa.build(root);
+      if (start < 0)
+        return false;
+
+      // Byte equivalence classes: bytes no set tells apart share a column.
+      std::array<std::uint16_t, 256> cls{};
+      std::size_t ncls = 1;
+      for (const ByteSet &s : ps.sets)
+      {
+        std::vector<int> remap(ncls * 2, -1);
+        std::size_t next = 0;
+        for (std::size_t b = 0; b < 256; ++b)
+        {
+          const std::size_t key = cls[b] * 2u + (s.test(b) ? 1u : 0u);
+          if (remap[key] < 0)
+            remap[key] = static_cast<int>(next++);
+          cls[b] = static_cast<std::uint16_t>(remap[key]);
+        }
+        ncls = next;
+      }
+      std::vector<std::size_t> rep(ncls);
+      for (std::size_t b = 256; b-- > 0;)
+        rep[cls[b]] = b;
+
+      std::vector<char> seen(nfa.states.size(), 0);
+      std::map<std::vector<int>, std::uint16_t> ids;
+      std::vector<std::vector<int>> sets;
+      std::vector<std::uint16_t> trans;
+      std::vector<char> acc;
+
+      auto intern = [&](std::vector<int> &&st) -> int
+      {
+        const auto it = ids.find(st);
+        if (it != ids.end())
+          return it->second;
+        if (sets.size() >= kMaxStates)
+          return -1;
+        const auto id = static_cast<std::uint16_t>(sets.size());
+        acc.push_back(std::binary_search(st.begin(), st.end(), accept) ? 1 : 0);
+        ids.emplace(st, id);
+        sets.push_back(std::move(st));
+        trans.resize(sets.size() * ncls, 0);
+        return id;
+      };
+
+      intern({}); // 0 = dead state
+      std::vector<int> init{start};
+      nfa.closure(init, seen);
+      if (intern(std::move(init)) != 1)
+        return false;
+
+      for (std::size_t d = 1; d < sets.size(); ++d)
+      {
+        for (std::size_t c = 0; c < ncls; ++c)
+        {
+          std::vector<int> move;
+          for (const int s : sets[d])
+          {
+            const NfaState &ns = nfa.states[static_cast<std::size_t>(s)];
+            if (ns.set >= 0 && ps.sets[static_cast<std::size_t>(ns.set)].test(rep[c]))
+            {
+              if (!seen[static_cast<std::size_t>(ns.next)])
+              {
+                seen[static_cast<std::size_t>(ns.next)] = 1;
+                move.push_back(ns.next);
+              }
+            }
+          }
+          for (const int s : move)
+            seen[static_cast<std::size_t>(s)] = 0;
+
+          int to = 0;
+          if (!move.empty())
+          {
+            nfa.closure(move, seen);
+            to = intern(std::move(move));
+            if (to < 0)
+              return false;
+          }
+          trans[d * ncls + c] = static_cast<std::uint16_t>(to);
+        }
+      }
+
+      cls_ = cls;
+      ncls_ = ncls;
+      accept_ = std::move(acc);
+      trans_ = std::move(trans);
+      return true;
+    }
+
+    bool runDfa(std::string_view s) const noexcept
+    {
+      std::size_t st = 1;
+      const std::uint16_t *t = trans_.data();
+      for (const char ch : s)
+      {
+        st = t[st * ncls_ + cls_[static_cast<unsigned char>(ch)]];
+        if (st == 0)
+          return false;
+      }
+      return accept_[st] != 0;
+    }
+
+    std::string source_;
+    std::array<std::uint16_t, 256> cls_{};
+    std::size_t ncls_ = 0;
+    std::vector<std::uint16_t> trans_;
+    std::vector<char> accept_;
+    std::shared_ptr<const std::regex> regex_;
+  };
+
+} // namespace vix::utils
+
+#endif // VIX_UTILS_PATTERN_HPP
@@ -16,11 +16,14 @@
 #ifndef VIX_UTILS_RESULT_HPP
 #define VIX_UTILS_RESULT_HPP
 
+#include <cassert>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
 #include <string>
-#include <utility>
 #include <type_traits>
-#include <new>
-#include <cassert>
+#include <utility>
 
 /**
  * @brief Generic Result<T, E> type for error handling without exceptions.
@@ -85,205 +88,431 @@ namespace vix::utils
    */
   inline constexpr ErrTag ErrTag_v{};
 
+  template <typename T, typename E>
+  class Result;
+
   /**
-   * @class Result
-   * @brief Represents either a success (Ok) containing T or a failure (Err) containing E.
+   * @brief Opt-in niche for the error type of `Result<void, E>`.
    *
-   * Storage:
-   * - Uses a union to store either the value `T` or the error `E`.
-   * - No dynamic allocation is performed by Result itself.
+   * When specialized with `enabled = true`, `Result<void, E>` stores only an
+   * `E` and encodes the Ok state as a reserved value of `E`, so no separate
+   * discriminant is needed. A specialization must provide:
+   * - `static E ok_value() noexcept`: the reserved value,
+   * - `static bool is_ok(const E &) noexcept`: recognizes it.
    *
-   * Semantics:
-   * - Copyable and movable (if T/E support it).
-   * - Accessors assert if you access the inactive variant.
+   * No type is enabled by default: only opt in when `E` can never carry the
+   * reserved value as an error. Creating an Err from the reserved value
+   * throws `std::invalid_argument` rather than yielding an Ok result.
    *
-   * @tparam T Success type.
-   * @tparam E Error type (defaults to std::string).
+   * @code
+   * template <>
+   * struct vix::utils::ResultNiche<MyErrno>
+   * {
+   *   static constexpr bool enabled = true;
+   *   static MyErrno ok_value() noexcept { return MyErrno{0}; }
+   *   static bool is_ok(const MyErrno &e) noexcept { return e.value == 0; }
+   * };
+   * @endcode
+   *
+   * @tparam E Error type.
    */
-  template <typename T, typename E = std::string>
-  class Result
+  template <typename E>
+  struct ResultNiche
+  {
+    static constexpr bool enabled = false;
+  };
+
+  namespace detail
   {
-    bool ok_;
-    union
+    /// Placeholder value stored by `Result<void, E>` on success.
+    struct ResultUnit
     {
-      T val_;
-      E err_;
     };
 
-    /**
-     * @brief Construct an Ok result from a const reference.
-     */
-    explicit Result(OkTag, const T &v) : ok_(true), val_(v) {}
-
-    /**
-     * @brief Construct an Ok result from an rvalue.
-     */
-    explicit Result(OkTag, T &&v) : ok_(true), val_(std::move(v)) {}
-
-    /**
-     * @brief Construct an Err result from a const reference.
-     */
-    explicit Result(ErrTag, const E &e) : ok_(false), err_(e) {}
-
-    /**
-     * @brief Construct an Err result from an rvalue.
-     */
-    explicit Result(ErrTag, E &&e) : ok_(false), err_(std::move(e)) {}
+    /// Tag: construct the Ok member from `std::invoke(f, args...)`.
+    struct InvokeOkTag
+    {
+      explicit InvokeOkTag() = default;
+    };
 
-  public:
-    /**
-     * @brief Create a success result (Ok) by value.
-     *
-     * @param v Success value.
-     * @return Ok result containing the value.
-     */
-    static Result Ok(T v) { return Result(OkTag_v, std::move(v)); }
+    /// Tag: construct the Err member from `std::invoke(f, args...)`.
+    struct InvokeErrTag
+    {
+      explicit InvokeErrTag() = default;
+    };
 
-    /**
-     * @brief Create an error result (Err) by value.
-     *
-     * @param e Error value.
-     * @return Err result containing the error.
-     */
-    static Result Err(E e) { return Result(ErrTag_v, std::move(e)); }
+    inline constexpr InvokeOkTag InvokeOkTag_v{};
+    inline constexpr InvokeErrTag InvokeErrTag_v{};
 
-    /**
-     * @brief Copy constructor.
-     *
-     * Copies either the success value or the error value depending on the state.
-     *
-     * @param o Source result.
-     */
-    Result(const Result &o) : ok_(o.ok_)
+    template <typename R>
+    struct IsResult : std::false_type
     {
-      if (ok_)
-        ::new (std::addressof(val_)) T(o.val_);
-      else
-        ::new (std::addressof(err_)) E(o.err_);
-    }
+    };
 
-    /**
-     * @brief Move constructor.
-     *
-     * Moves either the success value or the error value depending on the state.
-     *
-     * @param o Source result.
-     */
-    Result(Result &&o) noexcept(
-        std::is_nothrow_move_constructible_v<T> &&
-        std::is_nothrow_move_constructible_v<E>)
-        : ok_(o.ok_)
+    template <typename T, typename E>
+    struct IsResult<Result<T, E>> : std::true_type
     {
-      if (ok_)
-        ::new (std::addressof(val_)) T(std::move(o.val_));
-      else
-        ::new (std::addressof(err_)) E(std::move(o.err_));
-    }
+    };
 
     /**
-     * @brief Destructor.
+     * @brief Discriminated union backing Result.
      *
-     * Destroys the active union member.
+     * Each special member is defaulted (and therefore trivial) when both
+     * alternatives are trivial for that operation, and hand-written
+     * otherwise. Result itself declares none, so it inherits exactly the
+     * triviality of this storage: `Result<int, int>` is trivially copyable
+     * and is passed in registers.
      */
-    ~Result()
+    template <typename T, typename E>
+    struct ResultStorage
     {
-      if (ok_)
-        val_.~T();
-      else
-        err_.~E();
-    }
+      static constexpr bool trivial_dtor =
+          std::is_trivially_destructible_v<T> &&
+          std::is_trivially_destructible_v<E>;
 
-    /**
-     * @brief Copy assignment.
-     *
-     * Assigns the underlying value/error, properly switching active union
-     * member when needed.
-     *
-     * @param o Source result.
-     * @return *this
-     */
-    Result &operator=(const Result &o)
-    {
-      if (this == &o)
-        return *this;
+      static constexpr bool trivial_copy =
+          std::is_trivially_copy_constructible_v<T> &&
+          std::is_trivially_copy_constructible_v<E>;
+
+      static constexpr bool trivial_move =
+          std::is_trivially_move_constructible_v<T> &&
+          std::is_trivially_move_constructible_v<E>;
+
+      static constexpr bool trivial_copy_assign =
+          trivial_copy && trivial_dtor &&
+          std::is_trivially_copy_assignable_v<T> &&
+          std::is_trivially_copy_assignable_v<E>;
+
+      static constexpr bool trivial_move_assign =
+          trivial_move && trivial_dtor &&
+          std::is_trivially_move_assignable_v<T> &&
+          std::is_trivially_move_assignable_v<E>;
+
+      static constexpr bool can_copy =
+          std::is_copy_constructible_v<T> && std::is_copy_constructible_v<E>;
 
-      if (ok_ && o.ok_)
+      static constexpr bool can_move =
+          std::is_move_constructible_v<T> && std::is_move_constructible_v<E>;
+
+      static constexpr bool can_copy_assign =
+          can_copy &&
+          std::is_copy_assignable_v<T> && std::is_copy_assignable_v<E>;
+
+      static constexpr bool can_move_assign =
+          can_move &&
+          std::is_move_assignable_v<T> && std::is_move_assignable_v<E>;
+
+      static constexpr bool nothrow_move =
+          std::is_nothrow_move_constructible_v<T> &&
+          std::is_nothrow_move_constructible_v<E>;
+
+      static constexpr bool nothrow_move_assign =
+          nothrow_move &&
+          std::is_nothrow_move_assignable_v<T> &&
+          std::is_nothrow_move_assignable_v<E>;
+
+      union
+      {
+        T val_;
+        E err_;
+      };
+      bool ok_;
+
+      template <typename... Args>
+      constexpr explicit ResultStorage(OkTag, Args &&...args)
+          : val_(std::forward<Args>(args)...), ok_(true)
       {
-        val_ = o.val_;
       }
-      else if (!ok_ && !o.ok_)
+
+      template <typename... Args>
+      constexpr explicit ResultStorage(ErrTag, Args &&...args)
+          : err_(std::forward<Args>(args)...), ok_(false)
       {
-        err_ = o.err_;
       }
-      else if (ok_ && !o.ok_)
+
+      template <typename F, typename... Args>
+      constexpr explicit ResultStorage(InvokeOkTag, F &&f, Args &&...args)
+          : val_(std::invoke(std::forward<F>(f), std::forward<Args>(args)...)),
+            ok_(true)
       {
-        val_.~T();
-        ::new (std::addressof(err_)) E(o.err_);
-        ok_ = false;
       }
-      else
+
+      template <typename F, typename... Args>
+      constexpr explicit ResultStorage(InvokeErrTag, F &&f, Args &&...args)
+          : err_(std::invoke(std::forward<F>(f), std::forward<Args>(args)...)),
+            ok_(false)
       {
-        err_.~E();
-        ::new (std::addressof(val_)) T(o.val_);
-        ok_ = true;
       }
-      return *this;
-    }
+
+      constexpr ResultStorage(const ResultStorage &) requires trivial_copy = default;
+
+      constexpr ResultStorage(const ResultStorage &o) requires(!trivial_copy && can_copy)
+          : ok_(o.ok_)
+      {
+        if (ok_)
+          std::construct_at(std::addressof(val_), o.val_);
+        else
+          std::construct_at(std::addressof(err_), o.err_);
+      }
+
+      constexpr ResultStorage(ResultStorage &&) requires trivial_move = default;
+
+      constexpr ResultStorage(ResultStorage &&o) noexcept(nothrow_move)
+        requires(!trivial_move && can_move)
+          : ok_(o.ok_)
+      {
+        if (ok_)
+          std::construct_at(std::addressof(val_), std::move(o.val_));
+        else
+          std::construct_at(std::addressof(err_), std::move(o.err_));
+      }
+
+      constexpr ResultStorage &operator=(const ResultStorage &) requires trivial_copy_assign = default;
+
+      constexpr ResultStorage &operator=(const ResultStorage &o)
+        requires(!trivial_copy_assign && can_copy_assign)
+      {
+        if (this == &o)
+          return *this;
+
+        if (ok_ && o.ok_)
+          val_ = o.val_;
+        else if (!ok_ && !o.ok_)
+          err_ = o.err_;
+        else if (ok_)
+        {
+          std::destroy_at(std::addressof(val_));
+          std::construct_at(std::addressof(err_), o.err_);
+          ok_ = false;
+        }
+        else
+        {
+          std::destroy_at(std::addressof(err_));
+          std::construct_at(std::addressof(val_), o.val_);
+          ok_ = true;
+        }
+        return *this;
+      }
+
+      constexpr ResultStorage &operator=(ResultStorage &&) requires trivial_move_assign = default;
+
+      constexpr ResultStorage &operator=(ResultStorage &&o) noexcept(nothrow_move_assign)
+        requires(!trivial_move_assign && can_move_assign)
+      {
+        if (this == &o)
+          return *this;
+
+        if (ok_ && o.ok_)
+          val_ = std::move(o.val_);
+        else if (!ok_ && !o.ok_)
+          err_ = std::move(o.err_);
+        else if (ok_)
+        {
+          std::destroy_at(std::addressof(val_));
+          std::construct_at(std::addressof(err_), std::move(o.err_));
+          ok_ = false;
+        }
+        else
+        {
+          std::destroy_at(std::addressof(err_));
+          std::construct_at(std::addressof(val_), std::move(o.val_));
+          ok_ = true;
+        }
+        return *this;
+      }
+
+      constexpr ~ResultStorage() requires trivial_dtor = default;
+
+      constexpr ~ResultStorage() requires(!trivial_dtor)
+      {
+        if (ok_)
+          std::destroy_at(std::addressof(val_));
+        else
+          std::destroy_at(std::addressof(err_));
+      }
+
+      constexpr bool has_value() const noexcept { return ok_; }
+    };
 
     /**
-     * @brief Move assignment.
-     *
-     * Moves the underlying value/error, properly switching active union member
-     * when needed.
+     * @brief Niche storage for `Result<void, E>`: only an `E` is stored and
+     * the Ok state is `ResultNiche<E>::ok_value()`.
      *
-     * @param o Source result.
-     * @return *this
-     */
-    Result &operator=(Result &&o) noexcept(
-        std::is_nothrow_move_assignable_v<T> &&
-        std::is_nothrow_move_assignable_v<E> &&
-        std::is_nothrow_move_constructible_v<T> &&
-        std::is_nothrow_move_constructible_v<E>)
+     * Special members are the implicit ones of `E`.
+     */
+    template <typename E>
+    struct NicheStorage
     {
-      if (this == &o)
-        return *this;
+      E err_;
 
-      if (ok_ && o.ok_)
+      constexpr explicit NicheStorage(OkTag)
+          : err_(ResultNiche<E>::ok_value())
       {
-        val_ = std::move(o.val_);
       }
-      else if (!ok_ && !o.ok_)
+
+      template <typename... Args>
+      constexpr explicit NicheStorage(ErrTag, Args &&...args)
+          : err_(std::forward<Args>(args)...)
       {
-        err_ = std::move(o.err_);
+        check_err();
       }
-      else if (ok_ && !o.ok_)
+
+      template <typename F, typename... Args>
+      constexpr explicit NicheStorage(InvokeErrTag, F &&f, Args &&...args)
+          : err_(std::invoke(std::forward<F>(f), std::forward<Args>(args)...))
       {
-        val_.~T();
-        ::new (std::addressof(err_)) E(std::move(o.err_));
-        ok_ = false;
+        check_err();
+      }
+
+      /// An Err holding the reserved value would read back as Ok.
+      constexpr void check_err() const
+      {
+        if (ResultNiche<E>::is_ok(err_))
+          throw std::invalid_argument("Result: Err built from the niche's Ok value");
+      }
+
+      constexpr bool has_value() const noexcept { return ResultNiche<E>::is_ok(err_); }
+    };
+
+    template <typename E>
+    using VoidResultStorage =
+        std::conditional_t<ResultNiche<E>::enabled,
+                           NicheStorage<E>,
+                           ResultStorage<ResultUnit, E>>;
+  } // namespace detail
+
+  /**
+   * @class Result
+   * @brief Represents either a success (Ok) containing T or a failure (Err) containing E.
+   *
+   * Storage:
+   * - Uses a union to store either the value `T` or the error `E`.
+   * - No dynamic allocation is performed by Result itself.
+   *
+   * Semantics:
+   * - Copyable and movable (if T/E support it); each copy/move/destroy
+   *   operation is trivial when it is trivial for both T and E.
+   * - Accessors assert if you access the inactive variant.
+   * - `map`, `and_then`, `or_else` and `map_error` move out of rvalue
+   *   results and build the new value in place.
+   *
+   * @tparam T Success type.
+   * @tparam E Error type (defaults to std::string).
+   */
+  template <typename T, typename E = std::string>
+  class Result
+  {
+    template <typename, typename>
+    friend class Result;
+
+    detail::ResultStorage<T, E> s_;
+
+    template <typename Tag, typename... Args>
+    constexpr explicit Result(Tag tag, Args &&...args)
+        : s_(tag, std::forward<Args>(args)...)
+    {
+    }
+
+    template <typename Self, typename F>
+    static constexpr auto map_impl(Self &&self, F &&f)
+    {
+      using U = std::remove_cvref_t<
+          std::invoke_result_t<F, decltype((std::forward<Self>(self).s_.val_))>>;
+
+      if constexpr (std::is_void_v<U>)
+      {
+        if (!self.s_.ok_)
+          return Result<void, E>(ErrTag_v, std::forward<Self>(self).s_.err_);
+        std::invoke(std::forward<F>(f), std::forward<Self>(self).s_.val_);
+        return Result<void, E>(OkTag_v);
       }
       else
       {
-        err_.~E();
-        ::new (std::addressof(val_)) T(std::move(o.val_));
-        ok_ = true;
+        if (!self.s_.ok_)
+          return Result<U, E>(ErrTag_v, std::forward<Self>(self).s_.err_);
+        return Result<U, E>(detail::InvokeOkTag_v, std::forward<F>(f),
+                            std::forward<Self>(self).s_.val_);
       }
-      return *this;
     }
 
+    template <typename Self, typename F>
+    static constexpr auto map_error_impl(Self &&self, F &&f)
+    {
+      using G = std::remove_cvref_t<
+          std::invoke_result_t<F, decltype((std::forward<Self>(self).s_.err_))>>;
+
+      if (self.s_.ok_)
+        return Result<T, G>(OkTag_v, std::forward<Self>(self).s_.val_);
+      return Result<T, G>(detail::InvokeErrTag_v, std::forward<F>(f),
+                          std::forward<Self>(self).s_.err_);
+    }
+
+    template <typename Self, typename F>
+    static constexpr auto and_then_impl(Self &&self, F &&f)
+    {
+      using R = std::remove_cvref_t<
+          std::invoke_result_t<F, decltype((std::forward<Self>(self).s_.val_))>>;
+      static_assert(detail::IsResult<R>::value, "and_then: callable must return a Result");
+      static_assert(std::is_same_v<typename R::error_type, E>,
+                    "and_then: callable must keep the error type");
+
+      if (self.s_.ok_)
+        return std::invoke(std::forward<F>(f), std::forward<Self>(self).s_.val_);
+      return R(ErrTag_v, std::forward<Self>(self).s_.err_);
+    }
+
+    template <typename Self, typename F>
+    static constexpr auto or_else_impl(Self &&self, F &&f)
+    {
+      using R = std::remove_cvref_t<
+          std::invoke_result_t<F, decltype((std::forward<Self>(self).s_.err_))>>;
+      static_assert(detail::IsResult<R>::value, "or_else: callable must return a Result");
+      static_assert(std::is_same_v<typename R::value_type, T>,
+                    "or_else: callable must keep the value type");
+
+      if (!self.s_.ok_)
+        return std::invoke(std::forward<F>(f), std::forward<Self>(self).s_.err_);
+      return R(OkTag_v, std::forward<Self>(self).s_.val_);
+    }
+
+  public:
+    using value_type = T;
+    using error_type = E;
+
+    /**
+     * @brief Create a success result (Ok) by value.
+     *
+     * @param v Success value.
+     * @return Ok result containing the value.
+     */
+    static constexpr Result Ok(T v) { return Result(OkTag_v, std::move(v)); }
+
+    /**
+     * @brief Create an error result (Err) by value.
+     *
+     * @param e Error value.
+     * @return Err result containing the error.
+     */
+    static constexpr Result Err(E e) { return Result(ErrTag_v, std::move(e)); }
+
     /**
      * @brief Check whether this result is Ok.
      *
      * @return True if Ok, false if Err.
      */
-    bool is_ok() const noexcept { return ok_; }
+    [[nodiscard]] constexpr bool is_ok() const noexcept { return s_.ok_; }
 
     /**
      * @brief Check whether this result is Err.
      *
      * @return True if Err, false if Ok.
      */
-    bool is_err() const noexcept { return !ok_; }
+    [[nodiscard]] constexpr bool is_err() const noexcept { return !s_.ok_; }
+
+    /**
+     * @brief True if Ok.
+     */
+    constexpr explicit operator bool() const noexcept { return s_.ok_; }
 
     /**
      * @brief Access the success value (const).
@@ -291,10 +520,10 @@ namespace vix::utils
      * @return Const reference to the success value.
      * @warning Asserts if the result is Err.
      */
-    const T &value() const
+    constexpr const T &value() const &
     {
-      assert(ok_);
-      return val_;
+      assert(s_.ok_);
+      return s_.val_;
     }
 
     /**
@@ -303,10 +532,21 @@ namespace vix::utils
      * @return Reference to the success value.
      * @warning Asserts if the result is Err.
      */
-    T &value()
+    constexpr T &value() &
+    {
+      assert(s_.ok_);
+      return s_.val_;
+    }
+
+    /**
+     * @brief Move the success value out of an rvalue result.
+     *
+     * @warning Asserts if the result is Err.
+     */
+    constexpr T &&value() &&
     {
-      assert(ok_);
-      return val_;
+      assert(s_.ok_);
+      return std::move(s_.val_);
     }
 
     /**
@@ -315,10 +555,10 @@ namespace vix::utils
      * @return Const reference to the error value.
      * @warning Asserts if the result is Ok.
      */
-    const E &error() const
+    constexpr const E &error() const &
     {
-      assert(!ok_);
-      return err_;
+      assert(!s_.ok_);
+      return s_.err_;
     }
 
     /**
@@ -327,19 +567,100 @@ namespace vix::utils
      * @return Reference to the error value.
      * @warning Asserts if the result is Ok.
      */
-    E &error()
+    constexpr E &error() &
+    {
+      assert(!s_.ok_);
+      return s_.err_;
+    }
+
+    /**
+     * @brief Move the error value out of an rvalue result.
+     *
+     * @warning Asserts if the result is Ok.
+     */
+    constexpr E &&error() &&
+    {
+      assert(!s_.ok_);
+      return std::move(s_.err_);
+    }
+
+    /**
+     * @brief Return the value if Ok, otherwise `fallback`.
+     */
+    template <typename U>
+    [[nodiscard]] constexpr T value_or(U &&fallback) const &
     {
-      assert(!ok_);
-      return err_;
+      return s_.ok_ ? s_.val_ : static_cast<T>(std::forward<U>(fallback));
+    }
+
+    template <typename U>
+    [[nodiscard]] constexpr T value_or(U &&fallback) &&
+    {
+      return s_.ok_ ? std::move(s_.val_) : static_cast<T>(std::forward<U>(fallback));
     }
 
+    /**
+     * @brief Transform the value: `f(T) -> U` gives `Result<U, E>`.
+     *
+     * The error is forwarded unchanged. A callable returning void yields
+     * `Result<void, E>`.
+     */
+    template <typename F>
+    [[nodiscard]] constexpr auto map(F &&f) & { return map_impl(*this, std::forward<F>(f)); }
+
+    template <typename F>
+    [[nodiscard]] constexpr auto map(F &&f) const & { return map_impl(*this, std::forward<F>(f)); }
+
+    template <typename F>
+    [[nodiscard]] constexpr auto map(F &&f) && { return map_impl(std::move(*this), std::forward<F>(f)); }
+
+    /**
+     * @brief Transform the error: `f(E) -> G` gives `Result<T, G>`.
+     */
+    template <typename F>
+    [[nodiscard]] constexpr auto map_error(F &&f) & { return map_error_impl(*this, std::forward<F>(f)); }
+
+    template <typename F>
+    [[nodiscard]] constexpr auto map_error(F &&f) const & { return map_error_impl(*this, std::forward<F>(f)); }
+
+    template <typename F>
+    [[nodiscard]] constexpr auto map_error(F &&f) && { return map_error_impl(std::move(*this), std::forward<F>(f)); }
+
+    /**
+     * @brief Chain a fallible step: `f(T) -> Result<U, E>`.
+     *
+     * Only invoked when Ok; an Err is forwarded unchanged.
+     */
+    template <typename F>
+    [[nodiscard]] constexpr auto and_then(F &&f) & { return and_then_impl(*this, std::forward<F>(f)); }
+
+    template <typename F>
+    [[nodiscard]] constexpr auto and_then(F &&f) const & { return and_then_impl(*this, std::forward<F>(f)); }
+
+    template <typename F>
+    [[nodiscard]] constexpr auto and_then(F &&f) && { return and_then_impl(std::move(*this), std::forward<F>(f)); }
+
+    /**
+     * @brief Recover from an error: `f(E) -> Result<T, G>`.
+     *
+     * Only invoked when Err; an Ok is forwarded unchanged.
+     */
+    template <typename F>
+    [[nodiscard]] constexpr auto or_else(F &&f) & { return or_else_impl(*this, std::forward<F>(f)); }
+
+    template <typename F>
+    [[nodiscard]] constexpr auto or_else(F &&f) const & { return or_else_impl(*this, std::forward<F>(f)); }
+
+    template <typename F>
+    [[nodiscard]] constexpr auto or_else(F &&f) && { return or_else_impl(std::move(*this), std::forward<F>(f)); }
+
     /**
      * @brief Construct an Ok from a const reference.
      *
      * @param v Success value.
      * @return Ok result.
      */
-    static Result FromOk(const T &v) { return Result(OkTag_v, v); }
+    static constexpr Result FromOk(const T &v) { return Result(OkTag_v, v); }
 
     /**
      * @brief Construct an Ok from an rvalue.
@@ -347,7 +668,7 @@ namespace vix::utils
      * @param v Success value.
      * @return Ok result.
      */
-    static Result FromOk(T &&v) { return Result(OkTag_v, std::move(v)); }
+    static constexpr Result FromOk(T &&v) { return Result(OkTag_v, std::move(v)); }
 
     /**
      * @brief Construct an Err from a const reference.
@@ -355,7 +676,7 @@ namespace vix::utils
      * @param e Error value.
      * @return Err result.
      */
-    static Result FromErr(const E &e) { return Result(ErrTag_v, e); }
+    static constexpr Result FromErr(const E &e) { return Result(ErrTag_v, e); }
 
     /**
      * @brief Construct an Err from an rvalue.
@@ -363,7 +684,7 @@ namespace vix::utils
      * @param e Error value.
      * @return Err result.
      */
-    static Result FromErr(E &&e) { return Result(ErrTag_v, std::move(e)); }
+    static constexpr Result FromErr(E &&e) { return Result(ErrTag_v, std::move(e)); }
 
     /**
      * @brief Default construction is disabled.
@@ -377,7 +698,9 @@ namespace vix::utils
    * @class Result<void, E>
    * @brief Specialization for operations that return void on success.
    *
-   * On success, no value is stored. On error, an `E` is stored.
+   * On success, no value is stored. On error, an `E` is stored. When
+   * `ResultNiche<E>` is enabled the discriminant is folded into `E` and
+   * `sizeof(Result<void, E>) == sizeof(E)`.
    *
    * @tparam E Error type.
    *
@@ -393,35 +716,86 @@ namespace vix::utils
   template <typename E>
   class Result<void, E>
   {
-    bool ok_;
-    union
+    template <typename, typename>
+    friend class Result;
+
+    detail::VoidResultStorage<E> s_;
+
+    template <typename Tag, typename... Args>
+    constexpr explicit Result(Tag tag, Args &&...args)
+        : s_(tag, std::forward<Args>(args)...)
     {
-      char dummy_; // Active when ok_ == true
-      E err_;
-    };
+    }
 
-    /**
-     * @brief Construct an Ok result (no value stored).
-     */
-    explicit Result(OkTag) : ok_(true), dummy_(0) {}
+    template <typename Self, typename F>
+    static constexpr auto map_impl(Self &&self, F &&f)
+    {
+      using U = std::remove_cvref_t<std::invoke_result_t<F>>;
 
-    /**
-     * @brief Construct an Err result from a const reference.
-     */
-    explicit Result(ErrTag, const E &e) : ok_(false), err_(e) {}
+      if constexpr (std::is_void_v<U>)
+      {
+        if (!self.s_.has_value())
+          return Result<void, E>(ErrTag_v, std::forward<Self>(self).s_.err_);
+        std::invoke(std::forward<F>(f));
+        return Result<void, E>(OkTag_v);
+      }
+      else
+      {
+        if (!self.s_.has_value())
+          return Result<U, E>(ErrTag_v, std::forward<Self>(self).s_.err_);
+        return Result<U, E>(detail::InvokeOkTag_v, std::forward<F>(f));
+      }
+    }
 
-    /**
-     * @brief Construct an Err result from an rvalue.
-     */
-    explicit Result(ErrTag, E &&e) : ok_(false), err_(std::move(e)) {}
+    template <typename Self, typename F>
+    static constexpr auto map_error_impl(Self &&self, F &&f)
+    {
+      using G = std::remove_cvref_t<
+          std::invoke_result_t<F, decltype((std::forward<Self>(self).s_.err_))>>;
+
+      if (self.s_.has_value())
+        return Result<void, G>(OkTag_v);
+      return Result<void, G>(detail::InvokeErrTag_v, std::forward<F>(f),
+                             std::forward<Self>(self).s_.err_);
+    }
+
+    template <typename Self, typename F>
+    static constexpr auto and_then_impl(Self &&self, F &&f)
+    {
+      using R = std::remove_cvref_t<std::invoke_result_t<F>>;
+      static_assert(detail::IsResult<R>::value, "and_then: callable must return a Result");
+      static_assert(std::is_same_v<typename R::error_type, E>,
+                    "and_then: callable must keep the error type");
+
+      if (self.s_.has_value())
+        return std::invoke(std::forward<F>(f));
+      return R(ErrTag_v, std::forward<Self>(self).s_.err_);
+    }
+
+    template <typename Self, typename F>
+    static constexpr auto or_else_impl(Self &&self, F &&f)
+    {
+      using R = std::remove_cvref_t<
+          std::invoke_result_t<F, decltype((std::forward<Self>(self).s_.err_))>>;
+      static_assert(detail::IsResult<R>::value, "or_else: callable must return a Result");
+      static_assert(std::is_void_v<typename R::value_type>,
+                    "or_else: callable must keep the value type");
+
+      if (!self.s_.has_value())
+        return std::invoke(std::forward<F>(f), std::forward<Self>(self).s_.err_);
+      return R(OkTag_v);
+    }
 
   public:
+    using value_type = void;
+    using error_type = E;
+
     /**
      * @brief Create an Ok result.
      *
      * @return Ok result.
      */
-    static Result Ok() { return Result(OkTag_v); }
+    static constexpr Result Ok() { return Result(OkTag_v); }
 
     /**
      * @brief Create an Err result by value.
@@ -429,151 +803,109 @@ namespace vix::utils
      * @param e Error value.
      * @return Err result.
      */
-    static Result Err(E e) { return Result(ErrTag_v, std::move(e)); }
+    static constexpr Result Err(E e) { return Result(ErrTag_v, std::move(e)); }
 
     /**
-     * @brief Copy constructor.
+     * @brief Check whether this result is Ok.
      *
-     * @param o Source result.
+     * @return True if Ok, false if Err.
      */
-    Result(const Result &o) : ok_(o.ok_)
-    {
-      if (ok_)
-        ::new (std::addressof(dummy_)) char(0);
-      else
-        ::new (std::addressof(err_)) E(o.err_);
-    }
+    [[nodiscard]] constexpr bool is_ok() const noexcept { return s_.has_value(); }
 
     /**
-     * @brief Move constructor.
+     * @brief Check whether this result is Err.
      *
-     * @param o Source result.
+     * @return True if Err, false if Ok.
      */
-    Result(Result &&o) noexcept(std::is_nothrow_move_constructible_v<E>)
-        : ok_(o.ok_)
-    {
-      if (ok_)
-        ::new (std::addressof(dummy_)) char(0);
-      else
-        ::new (std::addressof(err_)) E(std::move(o.err_));
-    }
+    [[nodiscard]] constexpr bool is_err() const noexcept { return !s_.has_value(); }
+
+    /**
+     * @brief True if Ok.
+     */
+    constexpr explicit operator bool() const noexcept { return s_.has_value(); }
 
     /**
-     * @brief Destructor.
+     * @brief Access the error value (const).
      *
-     * Destroys the error value if present.
+     * @return Const reference to the error value.
+     * @warning Asserts if the result is Ok.
      */
-    ~Result()
+    constexpr const E &error() const &
     {
-      if (!ok_)
-        err_.~E();
+      assert(!s_.has_value());
+      return s_.err_;
     }
 
     /**
-     * @brief Copy assignment.
+     * @brief Access the error value (mutable).
      *
-     * @param o Source result.
-     * @return *this
+     * @return Reference to the error value.
+     * @warning Asserts if the result is Ok.
      */
-    Result &operator=(const Result &o)
+    constexpr E &error() &
     {
-      if (this == &o)
-        return *this;
-
-      if (ok_ && o.ok_)
-      {
-        // both ok: nothing to do
-      }
-      else if (!ok_ && !o.ok_)
-      {
-        err_ = o.err_;
-      }
-      else if (ok_ && !o.ok_)
-      {
-        ::new (std::addressof(err_)) E(o.err_);
-        ok_ = false;
-      }
-      else
-      {
-        err_.~E();
-        ::new (std::addressof(dummy_)) char(0);
-        ok_ = true;
-      }
-      return *this;
+      assert(!s_.has_value());
+      return s_.err_;
     }
 
     /**
-     * @brief Move assignment.
+     * @brief Move the error value out of an rvalue result.
      *
-     * @param o Source result.
-     * @return *this
+     * @warning Asserts if the result is Ok.
      */
-    Result &operator=(Result &&o) noexcept(
-        std::is_nothrow_move_assignable_v<E> &&
-        std::is_nothrow_move_constructible_v<E>)
+    constexpr E &&error() &&
     {
-      if (this == &o)
-        return *this;
-
-      if (ok_ && o.ok_)
-      {
-        // both ok: nothing to do
-      }
-      else if (!ok_ && !o.ok_)
-      {
-        err_ = std::move(o.err_);
-      }
-      else if (ok_ && !o.ok_)
-      {
-        ::new (std::addressof(err_)) E(std::move(o.err_));
-        ok_ = false;
-      }
-      else
-      {
-        err_.~E();
-        ::new (std::addressof(dummy_)) char(0);
-        ok_ = true;
-      }
-      return *this;
+      assert(!s_.has_value());
+      return std::move(s_.err_);
     }
 
     /**
-     * @brief Check whether this result is Ok.
-     *
-     * @return True if Ok, false if Err.
+     * @brief Produce a value on success: `f() -> U` gives `Result<U, E>`.
      */
-    bool is_ok() const noexcept { return ok_; }
+    template <typename F>
+    [[nodiscard]] constexpr auto map(F &&f) & { return map_impl(*this, std::forward<F>(f)); }
+
+    template <typename F>
+    [[nodiscard]] constexpr auto map(F &&f) const & { return map_impl(*this, std::forward<F>(f)); }
+
+    template <typename F>
+    [[nodiscard]] constexpr auto map(F &&f) && { return map_impl(std::move(*this), std::forward<F>(f)); }
 
     /**
-     * @brief Check whether this result is Err.
-     *
-     * @return True if Err, false if Ok.
+     * @brief Transform the error: `f(E) -> G` gives `Result<void, G>`.
      */
-    bool is_err() const noexcept { return !ok_; }
+    template <typename F>
+    [[nodiscard]] constexpr auto map_error(F &&f) & { return map_error_impl(*this, std::forward<F>(f)); }
+
+    template <typename F>
+    [[nodiscard]] constexpr auto map_error(F &&f) const & { return map_error_impl(*this, std::forward<F>(f)); }
+
+    template <typename F>
+    [[nodiscard]] constexpr auto map_error(F &&f) && { return map_error_impl(std::move(*this), std::forward<F>(f)); }
 
     /**
-     * @brief Access the error value (const).
-     *
-     * @return Const reference to the error value.
-     * @warning Asserts if the result is Ok.
+     * @brief Chain a fallible step: `f() -> Result<U, E>`.
      */
-    const E &error() const
-    {
-      assert(!ok_);
-      return err_;
-    }
+    template <typename F>
+    [[nodiscard]] constexpr auto and_then(F &&f) & { return and_then_impl(*this, std::forward<F>(f)); }
+
+    template <typename F>
+    [[nodiscard]] constexpr auto and_then(F &&f) const & { return and_then_impl(*this, std::forward<F>(f)); }
+
+    template <typename F>
+    [[nodiscard]] constexpr auto and_then(F &&f) && { return and_then_impl(std::move(*this), std::forward<F>(f)); }
 
     /**
-     * @brief Access the error value (mutable).
-     *
-     * @return Reference to the error value.
-     * @warning Asserts if the result is Ok.
+     * @brief Recover from an error: `f(E) -> Result<void, G>`.
      */
-    E &error()
-    {
-      assert(!ok_);
-      return err_;
-    }
+    template <typename F>
+    [[nodiscard]] constexpr auto or_else(F &&f) & { return or_else_impl(*this, std::forward<F>(f)); }
+
+    template <typename F>
+    [[nodiscard]] constexpr auto or_else(F &&f) const & { return or_else_impl(*this, std::forward<F>(f)); }
+
+    template <typename F>
+    [[nodiscard]] constexpr auto or_else(F &&f) && { return or_else_impl(std::move(*this), std::forward<F>(f)); }
 
     /**
      * @brief Default construction is disabled.
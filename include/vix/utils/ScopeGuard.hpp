@@ -16,15 +16,25 @@
 #ifndef VIX_SCOPE_GUARD_HPP
 #define VIX_SCOPE_GUARD_HPP
 
-#include <utility>
+#include <cstddef>
+#include <exception>
+#include <new>
 #include <type_traits>
+#include <utility>
 
 /**
  * @brief Minimal scope guard (RAII) to run a callback at scope exit.
  *
- * A `ScopeGuard` executes a user-provided callable when the guard goes out of
+ * A scope guard executes a user-provided callable when the guard goes out of
  * scope, unless explicitly dismissed via dismiss().
  *
+ * Two flavours are provided:
+ * - `ScopeGuardT<F>`: stores the callable inline, no allocation and a direct
+ *   call. Returned by make_scope_guard() and used by the SCOPE_* macros.
+ * - `ScopeGuard`: type-erased, for when a uniform type is needed (members,
+ *   containers). Small callables live in an inline buffer; larger ones are
+ *   heap-allocated.
+ *
  * - RAII: guarantees cleanup even on exceptions or early returns
  * - Movable: transfer ownership safely; non-copyable
  * - Noexcept destructor: destructor never throws
@@ -49,11 +59,138 @@
  *   committed = true;
  *   g.dismiss(); // prevent rollback()
  * }
+ *
+ * void locked()
+ * {
+ *   mtx.lock();
+ *   VIX_SCOPE_EXIT { mtx.unlock(); };
+ *   VIX_SCOPE_FAIL { log_failure(); }; // only while unwinding
+ *   do_work();
+ * }
  * @endcode
  */
 
 namespace vix::utils
 {
+  /**
+   * @brief When a scope guard runs its callable.
+   */
+  enum class ScopeExitMode
+  {
+    Always,   ///< On every scope exit.
+    OnFail,   ///< Only when the scope is left by an exception.
+    OnSuccess ///< Only when the scope is left normally.
+  };
+
+  namespace detail
+  {
+    /// Snapshot of std::uncaught_exceptions() for the conditional modes.
+    template <ScopeExitMode Mode>
+    struct UncaughtCount
+    {
+      int count = std::uncaught_exceptions();
+
+      bool should_run() const noexcept
+      {
+        const bool unwinding = std::uncaught_exceptions() > count;
+        return Mode == ScopeExitMode::OnFail ? unwinding : !unwinding;
+      }
+    };
+
+    template <>
+    struct UncaughtCount<ScopeExitMode::Always>
+    {
+      static constexpr bool should_run() noexcept { return true; }
+    };
+  } // namespace detail
+
+  /**
+   * @class ScopeGuardT
+   * @brief Scope guard that stores its callable inline.
+   *
+   * No allocation and no type erasure: the destructor is a direct call to
+   * `F`, which the compiler usually inlines. Movable (the moved-from guard is
+   * dismissed), non-copyable and non-assignable. Exceptions thrown by the
+   * callable are caught and suppressed.
+   *
+   * @tparam F    Callable type invocable as `f()`; stored by value.
+   * @tparam Mode When the callable runs (see ScopeExitMode).
+   */
+  template <class F, ScopeExitMode Mode = ScopeExitMode::Always>
+  class [[nodiscard]] ScopeGuardT
+  {
+    static_assert(std::is_invocable_v<F &>, "ScopeGuardT requires a callable invocable as f()");
+    static_assert(!std::is_reference_v<F>, "ScopeGuardT stores the callable by value");
+
+    F f_;
+    [[no_unique_address]] detail::UncaughtCount<Mode> uncaught_;
+    bool active_;
+
+  public:
+    /**
+     * @brief Construct a guard from a callable (copied or moved in).
+     */
+    template <class G,
+              typename = std::enable_if_t<!std::is_same_v<std::remove_cvref_t<G>, ScopeGuardT> &&
+                                          std::is_constructible_v<F, G>>>
+    explicit ScopeGuardT(G &&f) noexcept(std::is_nothrow_constructible_v<F, G>)
+        : f_(std::forward<G>(f)), uncaught_(), active_(true)
+    {
+    }
+
+    ScopeGuardT(const ScopeGuardT &) = delete;
+    ScopeGuardT &operator=(const ScopeGuardT &) = delete;
+    ScopeGuardT &operator=(ScopeGuardT &&) = delete;
+
+    /**
+     * @brief Move-construct; the moved-from guard will not run.
+     */
+    ScopeGuardT(ScopeGuardT &&other) noexcept(std::is_nothrow_move_constructible_v<F>)
+        : f_(std::move(other.f_)), uncaught_(other.uncaught_), active_(other.active_)
+    {
+      other.active_ = false;
+    }
+
+    /**
+     * @brief Run the callable if still active (and the mode allows it).
+     */
+    ~ScopeGuardT() noexcept
+    {
+      if (active_ && uncaught_.should_run())
+      {
+        try
+        {
+          f_();
+        }
+        catch (...)
+        {
+        }
+      }
+    }
+
+    /**
+     * @brief Disable callback execution at scope exit.
+     */
+    void dismiss() noexcept { active_ = false; }
+
+    /**
+     * @brief True if the callable will still run at scope exit.
+     */
+    bool active() const noexcept { return active_; }
+
+  private:
+    friend class ScopeGuard;
+
+    F &&release() noexcept
+    {
+      active_ = false;
+      return std::move(f_);
+    }
+  };
+
+  template <class F>
+  ScopeGuardT(F) -> ScopeGuardT<F>;
+
   /**
    * @class ScopeGuard
    * @brief Executes a stored callable at scope exit unless dismissed.
@@ -62,23 +199,131 @@ namespace vix::utils
    * if still active, the callable is executed. Any exception thrown by the
    * callable is caught and suppressed (destructor is noexcept).
    *
-   * @note The callable is type-erased and heap-allocated internally.
+   * @note The callable is type-erased. Callables up to kInlineSize bytes that
+   * are nothrow-movable are stored in an inline buffer; only larger ones are
+   * heap-allocated. Prefer ScopeGuardT when the type does not need to be
+   * uniform.
    * @note Thread-safety: do not share the same instance across threads without
    * external synchronization.
    */
   class ScopeGuard
   {
-    bool (*invoke_)(void *) noexcept;
-    void (*destroy_)(void *) noexcept;
-    void *data_;
+  public:
+    /// Inline buffer size for small callables.
+    static constexpr std::size_t kInlineSize = 4 * sizeof(void *);
+
+  private:
+    union Storage
+    {
+      void *heap;
+      alignas(std::max_align_t) unsigned char buf[kInlineSize];
+    };
+
+    struct Ops
+    {
+      void (*invoke)(Storage &) noexcept;
+      void (*relocate)(Storage &dst, Storage &src) noexcept;
+      void (*destroy)(Storage &) noexcept;
+    };
+
+    template <class D>
+    static constexpr bool fits_inline =
+        sizeof(D) <= kInlineSize &&
+        alignof(D) <= alignof(std::max_align_t) &&
+        std::is_nothrow_move_constructible_v<D>;
+
+    template <class D>
+    static D *get(Storage &s) noexcept
+    {
+      if constexpr (fits_inline<D>)
+        return std::launder(reinterpret_cast<D *>(s.buf));
+      else
+        return static_cast<D *>(s.heap);
+    }
+
+    template <class D>
+    static void invokeImpl(Storage &s) noexcept
+    {
+      try
+      {
+        (*get<D>(s))();
+      }
+      catch (...)
+      {
+      }
+    }
+
+    template <class D>
+    static void relocateImpl(Storage &dst, Storage &src) noexcept
+    {
+      if constexpr (fits_inline<D>)
+      {
+        D *p = get<D>(src);
+        ::new (static_cast<void *>(dst.buf)) D(std::move(*p));
+        p->~D();
+      }
+      else
+      {
+        dst.heap = src.heap;
+      }
+    }
+
+    template <class D>
+    static void destroyImpl(Storage &s) noexcept
+    {
+      if constexpr (fits_inline<D>)
+        get<D>(s)->~D();
+      else
+        delete get<D>(s);
+    }
+
+    template <class D>
+    static constexpr Ops kOps{&invokeImpl<D>, &relocateImpl<D>, &destroyImpl<D>};
+
+    template <class G>
+    void emplace(G &&f)
+    {
+      using D = std::decay_t<G>;
+      if constexpr (fits_inline<D>)
+        ::new (static_cast<void *>(storage_.buf)) D(std::forward<G>(f));
+      else
+        storage_.heap = new D(std::forward<G>(f));
+      ops_ = &kOps<D>;
+    }
+
+    void reset() noexcept
+    {
+      if (ops_)
+      {
+        if (active_)
+          ops_->invoke(storage_);
+        ops_->destroy(storage_);
+        ops_ = nullptr;
+      }
+      active_ = false;
+    }
+
+    void take(ScopeGuard &other) noexcept
+    {
+      ops_ = other.ops_;
+      active_ = other.active_;
+      if (ops_)
+        ops_->relocate(storage_, other.storage_);
+      other.ops_ = nullptr;
+      other.active_ = false;
+    }
+
+    Storage storage_;
+    const Ops *ops_;
     bool active_;
 
   public:
     /**
      * @brief Construct a guard from a callable.
      *
-     * The callable is copied/moved into heap storage and will be invoked on
-     * destruction unless dismiss() is called or the guard is moved-from.
+     * The callable is decay-copied (or moved) into the guard and will be
+     * invoked on destruction unless dismiss() is called or the guard is
+     * moved-from. Lvalue callables are copied, never referenced.
      *
      * @tparam F Callable type; must be invocable as `f()`.
      * @param f The callable to store.
@@ -87,23 +332,25 @@ namespace vix::utils
      * @note SFINAE prevents accidental construction from another ScopeGuard.
      */
     template <class F,
-              typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, ScopeGuard>>>
+              typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, ScopeGuard> &&
+                                          std::is_invocable_v<std::decay_t<F> &>>>
     explicit ScopeGuard(F &&f)
-        : invoke_([](void *p) noexcept -> bool
-                  {
-                    try
-                    {
-                      (*static_cast<F *>(p))();
-                      return true;
-                    }
-                    catch (...)
-                    {
-                      return false;
-                    } }),
-          destroy_([](void *p) noexcept
-                   { delete static_cast<F *>(p); }),
-          data_(static_cast<void *>(new F(std::forward<F>(f)))), active_(true)
+        : ops_(nullptr), active_(true)
     {
+      emplace(std::forward<F>(f));
+    }
+
+    /**
+     * @brief Take over the callable of an inline guard.
+     *
+     * The source guard is dismissed; its callable now runs when this guard
+     * exits.
+     */
+    template <class F>
+    ScopeGuard(ScopeGuardT<F> &&g)
+        : ops_(nullptr), active_(g.active())
+    {
+      emplace(g.release());
     }
 
     ScopeGuard(const ScopeGuard &) = delete;
@@ -118,10 +365,9 @@ namespace vix::utils
      * @param other Guard to move from.
      */
     ScopeGuard(ScopeGuard &&other) noexcept
-        : invoke_(other.invoke_), destroy_(other.destroy_), data_(other.data_), active_(other.active_)
+        : ops_(nullptr), active_(false)
     {
-      other.data_ = nullptr;
-      other.active_ = false;
+      take(other);
     }
 
     /**
@@ -137,21 +383,8 @@ namespace vix::utils
     {
       if (this != &other)
       {
-        if (data_)
-        {
-          if (active_ && invoke_)
-            (void)invoke_(data_);
-          if (destroy_)
-            destroy_(data_);
-        }
-
-        invoke_ = other.invoke_;
-        destroy_ = other.destroy_;
-        data_ = other.data_;
-        active_ = other.active_;
-
-        other.data_ = nullptr;
-        other.active_ = false;
+        reset();
+        take(other);
       }
       return *this;
     }
@@ -162,16 +395,7 @@ namespace vix::utils
      * The destructor never throws. If the callback throws, the exception is
      * swallowed.
      */
-    ~ScopeGuard() noexcept
-    {
-      if (data_)
-      {
-        if (active_ && invoke_)
-          (void)invoke_(data_);
-        if (destroy_)
-          destroy_(data_);
-      }
-    }
+    ~ScopeGuard() noexcept { reset(); }
 
     /**
      * @brief Disable callback execution at scope exit.
@@ -184,22 +408,95 @@ namespace vix::utils
   /**
    * @brief Helper function for type deduction.
    *
-   * Creates a ScopeGuard from a callable.
+   * Creates an inline ScopeGuardT from a callable. The result converts to
+   * the type-erased ScopeGuard when a uniform type is needed.
    *
    * @tparam F Callable type.
    * @param f Callable to run on scope exit.
-   * @return A ScopeGuard holding `f`.
+   * @return A ScopeGuardT holding a decayed copy of `f`.
    *
    * @code
    * auto g = vix::utils::make_scope_guard([&] { close(fd); });
    * @endcode
    */
   template <class F>
-  inline ScopeGuard make_scope_guard(F &&f)
+  [[nodiscard]] inline ScopeGuardT<std::decay_t<F>> make_scope_guard(F &&f)
+  {
+    return ScopeGuardT<std::decay_t<F>>(std::forward<F>(f));
+  }
+
+  /**
+   * @brief Guard that runs only if the scope is left by an exception.
+   */
+  template <class F>
+  [[nodiscard]] inline ScopeGuardT<std::decay_t<F>, ScopeExitMode::OnFail> make_scope_fail(F &&f)
+  {
+    return ScopeGuardT<std::decay_t<F>, ScopeExitMode::OnFail>(std::forward<F>(f));
+  }
+
+  /**
+   * @brief Guard that runs only if the scope is left normally.
+   */
+  template <class F>
+  [[nodiscard]] inline ScopeGuardT<std::decay_t<F>, ScopeExitMode::OnSuccess> make_scope_success(F &&f)
   {
-    return ScopeGuard(std::forward<F>(f));
+    return ScopeGuardT<std::decay_t<F>, ScopeExitMode::OnSuccess>(std::forward<F>(f));
   }
 
+  namespace detail
+  {
+    template <ScopeExitMode Mode>
+    struct ScopeGuardMaker
+    {
+    };
+
+    template <class F, ScopeExitMode Mode>
+    ScopeGuardT<std::decay_t<F>, Mode> operator+(ScopeGuardMaker<Mode>, F &&f)
+    {
+      return ScopeGuardT<std::decay_t<F>, Mode>(std::forward<F>(f));
+    }
+  } // namespace detail
+
 } // namespace vix::utils
 
+#define VIX_SCOPE_GUARD_CONCAT_IMPL(a, b) a##b
+#define VIX_SCOPE_GUARD_CONCAT(a, b) VIX_SCOPE_GUARD_CONCAT_IMPL(a, b)
+#define VIX_SCOPE_GUARD_VAR VIX_SCOPE_GUARD_CONCAT(vix_scope_guard_, __COUNTER__)
+
+/**
+ * @brief Run the following block at scope exit: `VIX_SCOPE_EXIT { ... };`
+ *
+ * The block captures by reference.
+ */
+#define VIX_SCOPE_EXIT                     \
+  auto VIX_SCOPE_GUARD_VAR =               \
+      ::vix::utils::detail::ScopeGuardMaker< \
+          ::vix::utils::ScopeExitMode::Always>{} + [&]()
+
+/**
+ * @brief Run the following block only when unwinding: `VIX_SCOPE_FAIL { ... };`
+ */
+#define VIX_SCOPE_FAIL                     \
+  auto VIX_SCOPE_GUARD_VAR =               \
+      ::vix::utils::detail::ScopeGuardMaker< \
+          ::vix::utils::ScopeExitMode::OnFail>{} + [&]()
+
+/**
+ * @brief Run the following block only on normal exit: `VIX_SCOPE_SUCCESS { ... };`
+ */
+#define VIX_SCOPE_SUCCESS                  \
+  auto VIX_SCOPE_GUARD_VAR =               \
+      ::vix::utils::detail::ScopeGuardMaker< \
+          ::vix::utils::ScopeExitMode::OnSuccess>{} + [&]()
+
+#ifndef SCOPE_EXIT
+#define SCOPE_EXIT VIX_SCOPE_EXIT
+#endif
+#ifndef SCOPE_FAIL
+#define SCOPE_FAIL VIX_SCOPE_FAIL
+#endif
+#ifndef SCOPE_SUCCESS
+#define SCOPE_SUCCESS VIX_SCOPE_SUCCESS
+#endif
+
 #endif // VIX_SCOPE_GUARD_HPP
@@ -16,21 +16,25 @@
 #ifndef VIX_SERVER_PRETTY_LOGS_HPP
 #define VIX_SERVER_PRETTY_LOGS_HPP
 
+#include <cctype>
+#include <charconv>
 #include <chrono>
+#include <cstdio>
 #include <cstdlib>
 #include <ctime>
-#include <cctype>
-#include <iomanip>
-#include <iostream>
-#include <sstream>
+#include <mutex>
 #include <string>
+#include <string_view>
 
 #include <vix/utils/ConsoleMutex.hpp>
+#if !defined(VIX_HEADER_ONLY)
+#include <vix/utils/ConsoleWriter.hpp>
+#endif
 #include <vix/utils/Env.hpp>
+#include <vix/utils/String.hpp>
 
 #if !defined(_WIN32)
 #include <unistd.h>
-#include <cstdio>
 #endif
 
 namespace vix::utils
@@ -118,6 +122,13 @@ namespace vix::utils
 
     /// Maximum thread count (optional).
     std::size_t max_threads = 0;
+
+    /**
+     * @brief Quiet/fast startup: skip animations and their timing.
+     *
+     * Also enabled by a truthy VIX_QUIET_STARTUP.
+     */
+    bool quiet = false;
   };
 
   /**
@@ -130,8 +141,10 @@ namespace vix::utils
    * - a single entry point RuntimeBanner::emit_server_ready()
    *
    * Threading:
-   * - Uses vix::utils::console_mutex() to serialize output so banner lines do not
-   *   interleave across threads.
+   * - Composes the banner off to the side and hands it to ConsoleWriter as
+   *   one write, so banner lines do not interleave with log lines. Header-only
+   *   builds (VIX_HEADER_ONLY) have no ConsoleWriter and write it directly
+   *   under console_mutex() instead.
    * - Uses vix::utils::console_reset_banner(), console_mark_banner_done(), and
    *   related primitives for banner synchronization.
    */
@@ -176,22 +189,21 @@ namespace vix::utils
      *   - "always|1|true" enables colors
      * - Otherwise: enabled by default.
      *
+     * Read from env_snapshot(), which emit_server_ready() refreshes first;
+     * call env_reload() after changing the variables at other times.
+     *
      * @return True if ANSI colors should be used.
      */
     static bool colors_enabled()
     {
-      if (const char *no = vix_getenv("NO_COLOR"); no && *no)
+      if (!env_snapshot().view_or("NO_COLOR").empty())
         return false;
 
-      if (const char *v = vix_getenv("VIX_COLOR"); v && *v)
+      if (const std::string_view v = env_snapshot().view_or("VIX_COLOR"); !v.empty())
       {
-        std::string s(v);
-        for (auto &c : s)
-          c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
-
-        if (s == "never" || s == "0" || s == "false")
+        if (iequals(v, "never") || iequals(v, "0") || iequals(v, "false"))
           return false;
-        if (s == "always" || s == "1" || s == "true")
+        if (iequals(v, "always") || iequals(v, "1") || iequals(v, "true"))
           return true;
       }
 
@@ -205,19 +217,18 @@ namespace vix::utils
      * - "dev|watch|reload" -> "dev"
      * - anything else -> "run"
      *
+     * Read from env_snapshot(), which emit_server_ready() refreshes first;
+     * call env_reload() after changing the variables at other times.
+     *
      * @return Mode string ("dev" or "run").
      */
     static std::string mode_from_env()
     {
-      const char *v = vix_getenv("VIX_MODE");
-      if (!v || !*v)
+      const std::string_view v = env_snapshot().view_or("VIX_MODE");
+      if (v.empty())
         return "run";
 
-      std::string s(v);
-      for (auto &c : s)
-        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
-
-      if (s == "dev" || s == "watch" || s == "reload")
+      if (iequals(v, "dev") || iequals(v, "watch") || iequals(v, "reload"))
         return "dev";
       return "run";
     }
@@ -231,39 +242,42 @@ namespace vix::utils
      * - Enabled for a conservative allowlist of terminals.
      * - Typically disabled for tmux/screen.
      *
+     * Read from env_snapshot(), which emit_server_ready() refreshes first;
+     * call env_reload() after changing the variables at other times.
+     *
      * @return True if OSC 8 links can be emitted.
      */
     static bool hyperlinks_enabled()
     {
-      if (const char *no = vix_getenv("VIX_NO_HYPERLINK"); no && *no)
+      if (!env_snapshot().view_or("VIX_NO_HYPERLINK").empty())
         return false;
 
       if (!stderr_is_tty())
         return false;
 
-      if (vix_getenv("VSCODE_PID"))
+      if (env_snapshot().contains("VSCODE_PID"))
         return true;
-      if (vix_getenv("WT_SESSION"))
+      if (env_snapshot().contains("WT_SESSION"))
         return true;
-      if (vix_getenv("WEZTERM_EXECUTABLE"))
+      if (env_snapshot().contains("WEZTERM_EXECUTABLE"))
         return true;
 
-      if (const char *tp = vix_getenv("TERM_PROGRAM"))
+      if (const auto tp = env_snapshot().get("TERM_PROGRAM"))
       {
-        std::string s(tp);
+        std::string s(*tp);
         if (s == "iTerm.app" || s == "Apple_Terminal" || s == "WezTerm" || s == "vscode")
           return true;
       }
 
-      if (vix_getenv("KITTY_WINDOW_ID"))
+      if (env_snapshot().contains("KITTY_WINDOW_ID"))
         return true;
 
-      if (vix_getenv("VTE_VERSION"))
+      if (env_snapshot().contains("VTE_VERSION"))
         return true;
 
-      if (const char *term = vix_getenv("TERM"))
+      if (const auto term = env_snapshot().get("TERM"))
       {
-        std::string t(term);
+        std::string t(*term);
         if (t.find("screen") != std::string::npos)
           return false;
       }
@@ -311,89 +325,187 @@ namespace vix::utils
     }
 
     /**
-     * @brief Print the runtime "ready" banner to stderr.
+     * @brief Terminal decisions used while rendering the banner.
+     */
+    struct Terminal
+    {
+      bool color = false;
+      bool hyperlinks = false;
+      bool animations = false;
+    };
+
+    /**
+     * @brief Colors, hyperlinks and animations for the current environment.
      *
-     * This function:
-     * - resets the banner state (for coordination with other threads)
-     * - serializes output using vix::utils::console_mutex()
-     * - prints time, identity, status, URLs, config, threads, mode/status, hints
-     * - marks the banner as done and notifies waiting threads
+     * Computed once per env snapshot (so TTY checks and env lookups run
+     * once, not per fragment) and refreshed after env_reload(). Quiet mode
+     * turns animations off without probing for them.
      *
-     * @param info Banner information (endpoints, labels, timing, etc.).
+     * @param quiet Skip animations.
      */
-    static void emit_server_ready(const ServerReadyInfo &info)
+    static Terminal terminal(bool quiet = false)
     {
-      vix::utils::console_reset_banner();
-
-      const bool color = colors_enabled();
-      const std::string http_url = make_http_url(info);
-      const std::string ws_url = (info.show_ws ? make_ws_url(info) : std::string());
+      static std::mutex m;
+      static const EnvSnapshot *seen = nullptr;
+      static Terminal cached;
 
+      const EnvSnapshot *env = &env_snapshot();
+      Terminal t;
       {
-        std::lock_guard<std::mutex> lk(vix::utils::console_mutex());
-
+        std::lock_guard<std::mutex> lk(m);
+        if (seen != env)
         {
-          const std::string t = format_local_time_12h();
-
-          if (color)
-            std::cerr << "\033[0m";
-
-          std::cerr
-              << (color ? gray(t, true) : t) << "  "
-              << runtime_identity(info.app, info.mode, color) << "  "
-              << status_pill(to_upper_copy(info.status), color);
-
-          if (!info.version.empty())
-          {
-            if (color)
-              std::cerr << "  " << bold(white_bright(info.version, true), true);
-            else
-              std::cerr << "  " << info.version;
-          }
-
-          if (info.ready_ms >= 0)
-          {
-            const std::string ms = " (" + std::to_string(info.ready_ms) + " ms)";
-            std::cerr << (color ? subtle_info(ms, true) : ms);
-          }
-
-          if (!info.mode.empty())
-            std::cerr << "  " << mode_tag(info.mode, color);
-
-          std::cerr << "\n";
+          cached.color = colors_enabled();
+          cached.hyperlinks = hyperlinks_enabled();
+          cached.animations = animations_enabled();
+          seen = env;
         }
+        t = cached;
+      }
+      if (quiet)
+        t.animations = false;
+      return t;
+    }
 
-        std::cerr << "\n";
+    /**
+     * @brief Whether quiet/fast startup is requested.
+     *
+     * True if `info.quiet` is set or VIX_QUIET_STARTUP is truthy. Quiet mode
+     * keeps the banner content but skips animations and their timing.
+     */
+    static bool quiet_startup(const ServerReadyInfo &info)
+    {
+      return info.quiet || env_snapshot().get_bool("VIX_QUIET_STARTUP", false);
+    }
 
-        const std::string http_label =
-            (info.scheme == "https") ? "HTTPS:" : "HTTP:";
+    /**
+     * @brief Append the complete "ready" banner to `out`.
+     *
+     * Everything is composed into `out` (reserved up front) with no
+     * temporary strings; emit_server_ready() then writes it in one go.
+     *
+     * @param out Destination buffer (appended to).
+     * @param info Banner information.
+     * @param term Terminal decisions (see terminal()).
+     */
+    static void render_server_ready(std::string &out,
+                                    const ServerReadyInfo &info,
+                                    const Terminal &term)
+    {
+      const bool color = term.color;
+      out.reserve(out.size() + 640 +
+                  info.app.size() + info.version.size() + info.mode.size() +
+                  info.status.size() + info.config_path.size() +
+                  3 * (info.host.size() + info.base_path.size() +
+                       info.ws_host.size() + info.ws_path.size()));
 
-        row(bullet(color), http_label, http_url, false, color);
+      // Header: time, identity, status pill, version, startup time, mode tag.
+      if (color)
+        out += kReset;
 
-        if (info.show_ws)
-          row(bullet(color), "WS:", ws_url, false, color);
+      styled(out, kGray, local_time_12h(), color);
+      out += "  ";
+      append_identity(out, info.app, info.mode, color);
+      out += "  ";
+      append_status_pill(out, info.status, color);
 
-        if (!info.config_path.empty())
-          row(info_mark(color), "Config:", info.config_path, true, color);
+      if (!info.version.empty())
+      {
+        out += "  ";
+        if (color)
+          out += "\033[1m";
+        styled(out, kWhiteBright, info.version, color);
+        if (color)
+          out += kReset;
+      }
 
-        if (info.threads > 0)
-        {
-          std::string v = std::to_string(info.threads);
-          if (info.max_threads > 0)
-            v += "/" + std::to_string(info.max_threads);
+      if (info.ready_ms >= 0)
+      {
+        if (color)
+          out += "\033[38;5;110m";
+        out += " (";
+        append_int(out, info.ready_ms);
+        out += " ms)";
+        if (color)
+          out += kReset;
+      }
 
-          row(info_mark(color), "Threads:", v, true, color);
+      if (!info.mode.empty())
+      {
+        out += "  ";
+        append_mode_tag(out, info.mode, color, term.animations);
+      }
+
+      out += "\n\n";
+
+      // Rows.
+      const std::string_view bullet = color ? std::string_view("\033[36m›\033[0m") : std::string_view(">");
+      const std::string_view info_mark = color ? std::string_view("\033[90mi\033[0m") : std::string_view("i");
+
+      append_row_link(out, bullet, info.scheme == "https" ? "HTTPS:" : "HTTP:", term,
+                      [&info](std::string &o)
+                      { append_http_url(o, info); });
+
+      if (info.show_ws)
+        append_row_link(out, bullet, "WS:", term,
+                        [&info](std::string &o)
+                        { append_ws_url(o, info); });
+
+      if (!info.config_path.empty())
+        append_row_dim(out, info_mark, "Config:", info.config_path, color);
+
+      if (info.threads > 0)
+      {
+        char buf[48];
+        char *p = std::to_chars(buf, buf + 20, info.threads).ptr;
+        if (info.max_threads > 0)
+        {
+          *p++ = '/';
+          p = std::to_chars(p, buf + sizeof(buf), info.max_threads).ptr;
         }
+        append_row_dim(out, info_mark, "Threads:", std::string_view(buf, static_cast<std::size_t>(p - buf)), color);
+      }
 
-        row(info_mark(color), "Mode:", pretty_mode(info.mode), true, color);
-        row(info_mark(color), "Status:", pretty_status(info.status), true, color);
+      append_row_dim(out, info_mark, "Mode:", pretty_mode(info.mode), color);
+      append_row_dim(out, info_mark, "Status:", info.status.empty() ? std::string_view("ready") : std::string_view(info.status), color);
 
-        if (info.show_hints)
-          row(info_mark(color), "Hint:", "Ctrl+C to stop the server", true, color);
+      if (info.show_hints)
+        append_row_dim(out, info_mark, "Hint:", "Ctrl+C to stop the server", color);
 
-        std::cerr << "\n";
-        std::cerr.flush();
+      out += "\n";
+    }
+
+    /**
+     * @brief Print the runtime "ready" banner to stderr.
+     *
+     * This function:
+     * - refreshes env_snapshot() (env_reload()), so NO_COLOR, VIX_MODE and
+     *   friends set since the first read take effect
+     * - resets the banner state (for coordination with other threads)
+     * - decides colors/hyperlinks/animations once (see terminal())
+     * - renders the banner into one buffer (see render_server_ready())
+     * - queues it on ConsoleWriter as a single write (a locked fwrite in
+     *   header-only builds)
+     * - marks the banner as done and notifies waiting threads
+     *
+     * @param info Banner information (endpoints, labels, timing, etc.).
+     */
+    static void emit_server_ready(const ServerReadyInfo &info)
+    {
+      vix::utils::env_reload();
+      vix::utils::console_reset_banner();
+
+      std::string out;
+      render_server_ready(out, info, terminal(quiet_startup(info)));
+#if defined(VIX_HEADER_ONLY)
+      {
+        std::lock_guard<std::mutex> lock(vix::utils::console_mutex());
+        std::fwrite(out.data(), 1, out.size(), stderr);
+        std::fflush(stderr);
       }
+#else
+      vix::utils::console_write(vix::utils::ConsoleStream::Err, out);
+#endif
 
       vix::utils::console_mark_banner_done();
     }
@@ -404,19 +516,12 @@ namespace vix::utils
      */
     static constexpr std::size_t LABEL_WIDTH = 8;
 
-    /**
-     * @brief Apply a subtle accent color to informational text.
-     *
-     * @param s Input string.
-     * @param on Whether coloring is enabled.
-     * @return Styled or raw string.
-     */
-    static std::string subtle_info(const std::string &s, bool on)
-    {
-      if (!on)
-        return s;
-      return "\033[38;5;110m" + s + "\033[0m";
-    }
+    static constexpr std::string_view kReset = "\033[0m";
+    static constexpr std::string_view kGray = "\033[90m";
+    static constexpr std::string_view kGreen = "\033[32m";
+    static constexpr std::string_view kCyan = "\033[36m";
+    static constexpr std::string_view kDim = "\033[2m";
+    static constexpr std::string_view kWhiteBright = "\033[97m";
 
     /**
      * @brief Determine whether banner animations are enabled.
@@ -430,13 +535,13 @@ namespace vix::utils
      */
     static bool animations_enabled()
     {
-      if (const char *no = vix_getenv("VIX_NO_ANIM"); no && *no)
+      if (!env_snapshot().view_or("VIX_NO_ANIM").empty())
         return false;
 
       if (!stderr_is_tty())
         return false;
 
-      if (const char *nc = vix_getenv("NO_COLOR"); nc && *nc)
+      if (!env_snapshot().view_or("NO_COLOR").empty())
         return false;
 
       return true;
@@ -445,7 +550,8 @@ namespace vix::utils
     /**
      * @brief Compute a repeating phase value in range [0..2].
      *
-     * Used to animate the "dev" tag background color.
+     * Used to animate the "dev" tag background color. Only called when
+     * animations are enabled.
      *
      * @return Phase 0, 1, or 2.
      */
@@ -458,225 +564,235 @@ namespace vix::utils
     }
 
     /**
-     * @brief Build an animated "[dev]" tag when color and animations are enabled.
-     *
-     * @param color Whether color output is enabled.
-     * @return Styled dev tag.
+     * @brief Append `s`, wrapped in `code` ... reset when `on`.
      */
-    static std::string dev_tag_animated(bool color)
+    static void styled(std::string &out, std::string_view code, std::string_view s, bool on)
     {
-      if (!color || !animations_enabled())
-        return "[dev]";
-
-      const int p = pulse_phase_0_2();
-      const int bg = (p == 0 ? 28 : (p == 1 ? 34 : 40));
-      std::string out;
-      out.reserve(48);
-
-      out += "\033[1m";
-      out += "\033[48;5;";
-      out += std::to_string(bg);
-      out += "m";
-      out += "\033[30m";
-      out += " dev ";
-      out += "\033[0m";
-
-      return out;
+      if (on)
+        out += code;
+      out += s;
+      if (on)
+        out += kReset;
     }
 
     /**
-     * @brief Build a "[run]" tag.
-     *
-     * @param color Whether color output is enabled.
-     * @return Styled run tag.
+     * @brief Append a decimal integer.
      */
-    static std::string run_tag(bool color)
+    template <typename Int>
+    static void append_int(std::string &out, Int v)
     {
-      if (!color)
-        return "[run]";
-
-      std::string out;
-      out.reserve(32);
-      out += "\033[1m";
-      out += "\033[48;5;238m";
-      out += "\033[97m";
-      out += " run ";
-      out += "\033[0m";
-      return out;
+      char buf[24];
+      const auto r = std::to_chars(buf, buf + sizeof(buf), v);
+      out.append(buf, r.ptr);
     }
 
     /**
-     * @brief Select the correct mode tag for the given mode.
-     *
-     * @param mode Mode string (typically "dev" or "run").
-     * @param color Whether color output is enabled.
-     * @return Styled mode tag.
+     * @brief Append a 256-color "pill": bold, background `bg`, `fg`, padded text.
      */
-    static std::string mode_tag(const std::string &mode, bool color)
+    static void append_pill(std::string &out, int bg, std::string_view fg, std::string_view text, bool upper)
     {
-      if (mode == "dev")
-        return dev_tag_animated(color);
-      return run_tag(color);
+      out += "\033[1m\033[48;5;";
+      append_int(out, bg);
+      out += 'm';
+      out += fg;
+      out += ' ';
+      if (upper)
+      {
+        for (char c : text)
+          out += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+      }
+      else
+      {
+        out += text;
+      }
+      out += ' ';
+      out += kReset;
     }
 
     /**
-     * @brief Return true if the given mode is considered "dev".
+     * @brief Append "[dev]"/"[run]" or their colored tags.
      *
-     * @param mode Mode string.
-     * @return True if dev.
+     * The dev tag pulses (one clock read) only when animations are on.
      */
-    static bool is_dev_mode(const std::string &mode)
+    static void append_mode_tag(std::string &out, const std::string &mode, bool color, bool animations)
     {
-      return mode == "dev";
-    }
+      if (mode == "dev")
+      {
+        if (!color || !animations)
+        {
+          out += "[dev]";
+          return;
+        }
+        const int p = pulse_phase_0_2();
+        append_pill(out, p == 0 ? 28 : (p == 1 ? 34 : 40), "\033[30m", "dev", false);
+        return;
+      }
 
-    /**
-     * @brief Select the runtime icon based on the mode.
-     *
-     * Dev uses a diamond "◆", run uses a dot "●".
-     *
-     * @param mode Mode string.
-     * @param color Whether color output is enabled.
-     * @return Styled icon string.
-     */
-    static std::string runtime_icon(const std::string &mode, bool color)
-    {
-      const bool dev = is_dev_mode(mode);
-      const std::string icon = dev ? "◆" : "●";
       if (!color)
-        return icon;
-      return wrap("\033[32m", icon, true);
+      {
+        out += "[run]";
+        return;
+      }
+      append_pill(out, 238, "\033[97m", "run", false);
     }
 
     /**
-     * @brief Build the application identity string.
+     * @brief Append the application identity.
      *
      * Normalizes common variants of "Vix.cpp" to the canonical display name.
-     *
-     * @param app Application name.
-     * @param mode Mode string.
-     * @param color Whether color output is enabled.
-     * @return Styled identity string.
+     * Dev mode uses a diamond "◆", run mode a dot "●".
      */
-    static std::string runtime_identity(const std::string &app, const std::string &mode, bool color)
+    static void append_identity(std::string &out, const std::string &app, const std::string &mode, bool color)
     {
       if (!color)
-        return "[" + app + "]";
+      {
+        out += '[';
+        out += app;
+        out += ']';
+        return;
+      }
 
-      std::string name = app;
+      std::string_view name = app;
       if (name == "vix.cpp" || name == "VIX.cpp" || name == "Vix.cpp")
         name = "Vix.cpp";
 
-      const std::string icon = runtime_icon(mode, true);
-      const std::string styled = bold(wrap("\033[32m", name, true), true);
-      return icon + " " + styled;
+      styled(out, kGreen, mode == "dev" ? "◆" : "●", true);
+      out += " \033[1m";
+      styled(out, kGreen, name, true);
+      out += kReset;
     }
 
     /**
-     * @brief Render a colored pill for the given status.
-     *
-     * @param status_upper Uppercase status label (e.g. "READY").
-     * @param color Whether color output is enabled.
-     * @return Styled pill string.
+     * @brief Append the uppercase status, as a colored pill when enabled.
      */
-    static std::string status_pill(const std::string &status_upper, bool color)
+    static void append_status_pill(std::string &out, const std::string &status, bool color)
     {
       if (!color)
-        return status_upper;
-
-      int bg = status_bg_color_code(status_upper);
-
-      std::string out;
-      out.reserve(status_upper.size() + 32);
-
-      out += "\033[1m";
-      out += "\033[48;5;";
-      out += std::to_string(bg);
-      out += "m";
-      out += "\033[30m";
-
-      out += " ";
-      out += status_upper;
-      out += " ";
-
-      out += "\033[0m";
-      return out;
+      {
+        for (char c : status)
+          out += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        return;
+      }
+      append_pill(out, status_bg_color_code(status), "\033[30m", status, true);
     }
 
     /**
      * @brief Choose a background color code for the status pill.
      *
-     * @param status_upper Uppercase status string.
+     * @param status Status string (compared case-insensitively).
      * @return ANSI 256-color background code.
      */
-    static int status_bg_color_code(const std::string &status_upper)
+    static int status_bg_color_code(std::string_view status)
     {
-      if (status_upper == "READY")
+      auto is = [status](std::string_view upper)
+      {
+        if (status.size() != upper.size())
+          return false;
+        for (std::size_t i = 0; i < upper.size(); ++i)
+          if (std::toupper(static_cast<unsigned char>(status[i])) != upper[i])
+            return false;
+        return true;
+      };
+
+      if (is("READY"))
         return 34;
 
-      if (status_upper == "RUNNING" || status_upper == "LISTENING")
+      if (is("RUNNING") || is("LISTENING"))
         return 35;
 
-      if (status_upper == "WARN" || status_upper == "WARNING")
+      if (is("WARN") || is("WARNING"))
         return 214;
 
-      if (status_upper == "ERROR" || status_upper == "FAILED")
+      if (is("ERROR") || is("FAILED"))
         return 196;
 
       return 34;
     }
 
     /**
-     * @brief Emit one aligned row in the banner.
-     *
-     * @param icon Left icon (bullet or info mark).
-     * @param label Row label (e.g. "HTTP:").
-     * @param value Row value (e.g. URL).
-     * @param dim_value Whether to dim the value (instead of making it a link).
-     * @param color Whether color output is enabled.
+     * @brief Append the row prefix: indent, icon and the padded bold label.
      */
-    static void row(
-        const std::string &icon,
-        const std::string &label,
-        const std::string &value,
-        bool dim_value,
-        bool color)
+    static void append_row_head(std::string &out, std::string_view icon, std::string_view label, bool color)
     {
-      const std::string lbl = pad_label(label);
-
-      std::cerr << "  "
-                << reset_style(icon, color) << " "
-                << (color ? bold(white_bright(lbl, true), true) : lbl)
-                << " "
-                << (dim_value ? dim(value, color) : link(value, color))
-                << "\n";
+      out += "  ";
+      if (color)
+        out += kReset;
+      out += icon;
+      out += ' ';
+      if (color)
+        out += "\033[1m\033[97m";
+      out += label;
+      if (label.size() < LABEL_WIDTH)
+        out.append(LABEL_WIDTH - label.size(), ' ');
+      if (color)
+      {
+        out += kReset;
+        out += kReset;
+      }
+      out += ' ';
+    }
+
+    /**
+     * @brief Append one aligned row whose value is dimmed.
+     */
+    static void append_row_dim(std::string &out, std::string_view icon, std::string_view label,
+                               std::string_view value, bool color)
+    {
+      append_row_head(out, icon, label, color);
+      styled(out, kDim, value, color);
+      out += '\n';
     }
 
     /**
-     * @brief Pad a label to a fixed width for alignment.
+     * @brief Append one aligned row whose value is a URL.
      *
-     * @param s Label string.
-     * @return Padded label string.
+     * The URL is wrapped as an OSC 8 hyperlink when supported, while the
+     * visible label remains the (optionally colored) URL text. `url`
+     * appends the URL to its argument; it runs once per occurrence so no
+     * intermediate string is built.
      */
-    static std::string pad_label(const std::string &s)
+    template <typename UrlFn>
+    static void append_row_link(std::string &out, std::string_view icon, std::string_view label,
+                                const Terminal &term, UrlFn &&url)
     {
-      if (s.size() >= LABEL_WIDTH)
-        return s;
-      return s + std::string(LABEL_WIDTH - s.size(), ' ');
+      append_row_head(out, icon, label, term.color);
+      if (term.hyperlinks)
+      {
+        out += "\033]8;;";
+        url(out);
+        out += "\033\\";
+      }
+      if (term.color)
+        out += kCyan;
+      url(out);
+      if (term.color)
+        out += kReset;
+      if (term.hyperlinks)
+        out += "\033]8;;\033\\";
+      out += '\n';
     }
 
+    /**
+     * @brief Small fixed buffer holding a formatted local time.
+     */
+    struct Clock12h
+    {
+      char buf[16];
+      std::size_t len;
+
+      operator std::string_view() const noexcept { return std::string_view(buf, len); }
+    };
+
     /**
      * @brief Format the local time in 12-hour format with seconds.
      *
      * Output example: "11:07:57 PM"
      *
-     * @return Local time string.
+     * @return Local time, in a small fixed buffer.
      */
-    static std::string format_local_time_12h()
+    static Clock12h local_time_12h()
     {
-      using clock = std::chrono::system_clock;
-      const auto now = clock::now();
-      const std::time_t t = clock::to_time_t(now);
+      const std::time_t t = std::time(nullptr);
 
       std::tm tm{};
 #if defined(_WIN32)
@@ -691,73 +807,61 @@ namespace vix::utils
       if (hour == 0)
         hour = 12;
 
-      std::ostringstream oss;
-      oss << hour << ":"
-          << std::setw(2) << std::setfill('0') << tm.tm_min << ":"
-          << std::setw(2) << std::setfill('0') << tm.tm_sec << " "
-          << (pm ? "PM" : "AM");
-      return oss.str();
+      Clock12h c{};
+      char *p = c.buf;
+      if (hour >= 10)
+        *p++ = static_cast<char>('0' + hour / 10);
+      *p++ = static_cast<char>('0' + hour % 10);
+      *p++ = ':';
+      *p++ = static_cast<char>('0' + tm.tm_min / 10);
+      *p++ = static_cast<char>('0' + tm.tm_min % 10);
+      *p++ = ':';
+      *p++ = static_cast<char>('0' + tm.tm_sec / 10);
+      *p++ = static_cast<char>('0' + tm.tm_sec % 10);
+      *p++ = ' ';
+      *p++ = pm ? 'P' : 'A';
+      *p++ = 'M';
+      c.len = static_cast<std::size_t>(p - c.buf);
+      return c;
     }
 
     /**
-     * @brief Build the HTTP URL from the provided ServerReadyInfo.
+     * @brief Append the HTTP URL from the provided ServerReadyInfo.
      *
      * Ensures the base path is prefixed with '/'.
-     *
-     * @param i ServerReadyInfo.
-     * @return HTTP URL string.
      */
-    static std::string make_http_url(const ServerReadyInfo &i)
+    static void append_http_url(std::string &out, const ServerReadyInfo &i)
     {
-      std::ostringstream oss;
-      oss << i.scheme << "://" << i.host << ":" << i.port;
+      out += i.scheme;
+      out += "://";
+      out += i.host;
+      out += ':';
+      append_int(out, i.port);
 
-      if (i.base_path.empty())
-      {
-        oss << "/";
-      }
-      else
-      {
-        if (i.base_path.front() != '/')
-          oss << "/";
-        oss << i.base_path;
-      }
-      return oss.str();
+      if (i.base_path.empty() || i.base_path.front() != '/')
+        out += '/';
+      out += i.base_path;
     }
 
     /**
-     * @brief Build the WebSocket URL from the provided ServerReadyInfo.
+     * @brief Append the WebSocket URL from the provided ServerReadyInfo.
      *
      * Ensures the path is prefixed with '/' when non-empty.
-     *
-     * @param i ServerReadyInfo.
-     * @return WebSocket URL string.
      */
-    static std::string make_ws_url(const ServerReadyInfo &i)
+    static void append_ws_url(std::string &out, const ServerReadyInfo &i)
     {
-      std::ostringstream oss;
-      oss << i.ws_scheme << "://" << i.ws_host << ":" << i.ws_port;
+      out += i.ws_scheme;
+      out += "://";
+      out += i.ws_host;
+      out += ':';
+      append_int(out, i.ws_port);
 
       if (!i.ws_path.empty())
       {
         if (i.ws_path.front() != '/')
-          oss << "/";
-        oss << i.ws_path;
+          out += '/';
+        out += i.ws_path;
       }
-      return oss.str();
-    }
-
-    /**
-     * @brief Convert a string to uppercase (ASCII).
-     *
-     * @param s Input string.
-     * @return Uppercased copy.
-     */
-    static std::string to_upper_copy(std::string s)
-    {
-      for (auto &c : s)
-        c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
-      return s;
     }
 
     /**
@@ -766,7 +870,7 @@ namespace vix::utils
      * @param mode Mode string.
      * @return Pretty mode text.
      */
-    static std::string pretty_mode(const std::string &mode)
+    static std::string_view pretty_mode(const std::string &mode)
     {
       if (mode == "dev")
         return "dev (watch/reload)";
@@ -774,148 +878,6 @@ namespace vix::utils
         return "run";
       return mode;
     }
-
-    /**
-     * @brief Human-friendly status label shown in the banner.
-     *
-     * @param status Status string.
-     * @return Pretty status text.
-     */
-    static std::string pretty_status(const std::string &status)
-    {
-      if (status.empty())
-        return "ready";
-      return status;
-    }
-
-    /**
-     * @brief Build a small mode tag like "[run]" or "[dev]".
-     *
-     * @param mode Mode string.
-     * @param color Whether color output is enabled.
-     * @return Styled tag string.
-     */
-    static std::string mode_tag_small(const std::string &mode, bool color)
-    {
-      const std::string m = mode.empty() ? "run" : mode;
-      if (!color)
-        return "[" + m + "]";
-      return cyan("[" + m + "]", true);
-    }
-
-    /**
-     * @brief Apply bright-white styling.
-     *
-     * @param s Input string.
-     * @param on Whether enabled.
-     * @return Styled or raw string.
-     */
-    static std::string white_bright(const std::string &s, bool on) { return wrap("\033[97m", s, on); }
-
-    /**
-     * @brief Reset the terminal style before printing a fragment.
-     *
-     * @param s Fragment.
-     * @param on Whether enabled.
-     * @return Styled or raw fragment.
-     */
-    static std::string reset_style(const std::string &s, bool on)
-    {
-      if (!on)
-        return s;
-      return std::string("\033[0m") + s;
-    }
-
-    /**
-     * @brief Wrap a string with an ANSI code and reset.
-     *
-     * @param code ANSI prefix code.
-     * @param s Input string.
-     * @param on Whether enabled.
-     * @return Styled or raw string.
-     */
-    static std::string wrap(const char *code, const std::string &s, bool on)
-    {
-      if (!on)
-        return s;
-      return std::string(code) + s + "\033[0m";
-    }
-
-    /**
-     * @brief Apply gray styling.
-     */
-    static std::string gray(const std::string &s, bool on) { return wrap("\033[90m", s, on); }
-
-    /**
-     * @brief Apply green styling.
-     */
-    static std::string green(const std::string &s, bool on) { return wrap("\033[32m", s, on); }
-
-    /**
-     * @brief Apply cyan styling.
-     */
-    static std::string cyan(const std::string &s, bool on) { return wrap("\033[36m", s, on); }
-
-    /**
-     * @brief Apply dim styling.
-     */
-    static std::string dim(const std::string &s, bool on) { return wrap("\033[2m", s, on); }
-
-    /**
-     * @brief Apply bold styling.
-     */
-    static std::string bold(const std::string &s, bool on) { return wrap("\033[1m", s, on); }
-
-    /**
-     * @brief A small green dot used as an OK indicator.
-     */
-    static std::string ok_dot(bool color)
-    {
-      return color ? green("●", true) : "●";
-    }
-
-    /**
-     * @brief Render a bracket badge such as "[text]".
-     */
-    static std::string badge(const std::string &text, bool color)
-    {
-      if (!color)
-        return "[" + text + "]";
-      return bold(gray("[" + text + "]", true), true);
-    }
-
-    /**
-     * @brief Render the bullet icon used for main rows.
-     */
-    static std::string bullet(bool color)
-    {
-      return color ? cyan("›", true) : std::string(">");
-    }
-
-    /**
-     * @brief Render the small info mark used for secondary rows.
-     */
-    static std::string info_mark(bool color)
-    {
-      return color ? gray("i", true) : "i";
-    }
-
-    /**
-     * @brief Render a URL as a clickable terminal link when supported.
-     *
-     * If OSC 8 hyperlinks are supported, the URL is wrapped as a link, while
-     * the visible label remains the (optionally colored) URL text.
-     *
-     * @param url URL to display.
-     * @param color Whether color output is enabled.
-     * @return Styled URL string.
-     */
-    static std::string link(const std::string &url, bool color)
-    {
-      const bool hl = hyperlinks_enabled();
-      const std::string label = color ? cyan(url, true) : url;
-      return osc8_link(url, label, hl);
-    }
   };
 
 } // namespace vix::utils
@@ -0,0 +1,515 @@
+/**
+ *
+ *  @file Simd.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#ifndef VIX_UTILS_SIMD_HPP
+#define VIX_UTILS_SIMD_HPP
+
+/**
+ * @brief Vectorized byte-scanning kernels shared by the string helpers.
+ *
+ * Each kernel has a scalar reference version plus SSE2 (x86-64 baseline),
+ * AVX2 (selected at runtime on GCC/Clang) and NEON (AArch64) paths. Inputs
+ * shorter than one vector go straight to the scalar loop, except the ASCII
+ * case kernels, which handle 8..15 bytes with 64-bit word operations since
+ * header names and env values are mostly that short.
+ *
+ * Define VIX_UTILS_NO_SIMD to force the scalar paths.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+#if !defined(VIX_UTILS_NO_SIMD)
+#if defined(__x86_64__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define VIX_UTILS_SIMD_SSE2 1
+#include <emmintrin.h>
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(_MSC_VER)
+#define VIX_UTILS_SIMD_AVX2 1
+#include <immintrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define VIX_UTILS_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+#endif
+
+namespace vix::utils::simd
+{
+  /**
+   * @brief Whether a byte must be escaped inside a JSON string.
+   */
+  inline constexpr bool json_needs_escape(unsigned char c) noexcept
+  {
+    return c < 0x20 || c == '"' || c == '\\';
+  }
+
+  /**
+   * @brief Scalar reference for find_json_escape.
+   */
+  inline const char *find_json_escape_scalar(const char *p, const char *end) noexcept
+  {
+    for (; p != end; ++p)
+    {
+      if (json_needs_escape(static_cast<unsigned char>(*p)))
+        return p;
+    }
+    return end;
+  }
+
+  /**
+   * @brief Scalar reference for find_byte2.
+   */
+  inline const char *find_byte2_scalar(const char *p, const char *end, char a, char b) noexcept
+  {
+    for (; p != end; ++p)
+    {
+      if (*p == a || *p == b)
+        return p;
+    }
+    return end;
+  }
+
+  /**
+   * @brief ASCII lowercase of one byte; bytes outside 'A'..'Z' are unchanged.
+   */
+  inline constexpr char ascii_lower(char c) noexcept
+  {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c | 0x20) : c;
+  }
+
+  /**
+   * @brief Scalar reference for to_lower_ascii.
+   */
+  inline void to_lower_ascii_scalar(char *p, char *end) noexcept
+  {
+    for (; p != end; ++p)
+      *p = ascii_lower(*p);
+  }
+
+  /**
+   * @brief Scalar reference for iequals_ascii.
+   */
+  inline bool iequals_ascii_scalar(const char *a, const char *b, std::size_t n) noexcept
+  {
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      if (ascii_lower(a[i]) != ascii_lower(b[i]))
+        return false;
+    }
+    return true;
+  }
+
+  namespace detail
+  {
+    inline unsigned ctz32(std::uint32_t m) noexcept
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+      unsigned long i = 0;
+      _BitScanForward(&i, m);
+      return static_cast<unsigned>(i);
+#else
+      return static_cast<unsigned>(__builtin_ctz(m));
+#endif
+    }
+
+#if defined(VIX_UTILS_SIMD_SSE2)
+    inline const char *find_json_escape_sse2(const char *p, const char *end) noexcept
+    {
+      const __m128i quote = _mm_set1_epi8('"');
+      const __m128i bslash = _mm_set1_epi8('\\');
+      const __m128i ctl = _mm_set1_epi8(0x1f);
+
+      for (; end - p >= 16; p += 16)
+      {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        // v <= 0x1f (unsigned) <=> min(v, 0x1f) == v
+        const __m128i hit = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, bslash)),
+            _mm_cmpeq_epi8(_mm_min_epu8(v, ctl), v));
+        const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(hit));
+        if (mask)
+          return p + ctz32(mask);
+      }
+      return find_json_escape_scalar(p, end);
+    }
+#endif
+
+#if defined(VIX_UTILS_SIMD_AVX2)
+    __attribute__((target("avx2"))) inline const char *
+    find_json_escape_avx2(const char *p, const char *end) noexcept
+    {
+      const __m256i quote = _mm256_set1_epi8('"');
+      const __m256i bslash = _mm256_set1_epi8('\\');
+      const __m256i ctl = _mm256_set1_epi8(0x1f);
+
+      for (; end - p >= 32; p += 32)
+      {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+        const __m256i hit = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, bslash)),
+            _mm256_cmpeq_epi8(_mm256_min_epu8(v, ctl), v));
+        const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(hit));
+        if (mask)
+          return p + ctz32(mask);
+      }
+      return find_json_escape_sse2(p, end);
+    }
+
+    /**
+     * @brief CPU feature probe, evaluated once.
+     */
+    inline bool has_avx2() noexcept
+    {
+      static const bool v = []
+      {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+      }();
+      return v;
+    }
+#endif
+
+#if defined(VIX_UTILS_SIMD_NEON)
+    inline const char *find_json_escape_neon(const char *p, const char *end) noexcept
+    {
+      const uint8x16_t quote = vdupq_n_u8('"');
+      const uint8x16_t bslash = vdupq_n_u8('\\');
+      const uint8x16_t ctl = vdupq_n_u8(0x20);
+
+      for (; end - p >= 16; p += 16)
+      {
+        const uint8x16_t v = vld1q_u8(reinterpret_cast<const std::uint8_t *>(p));
+        const uint8x16_t hit = vorrq_u8(vorrq_u8(vceqq_u8(v, quote), vceqq_u8(v, bslash)),
+                                        vcltq_u8(v, ctl));
+        if (vmaxvq_u8(hit))
+          return find_json_escape_scalar(p, p + 16);
+      }
+      return find_json_escape_scalar(p, end);
+    }
+#endif
+
+#if defined(VIX_UTILS_SIMD_SSE2)
+    inline const char *find_byte2_sse2(const char *p, const char *end, char a, char b) noexcept
+    {
+      const __m128i va = _mm_set1_epi8(a);
+      const __m128i vb = _mm_set1_epi8(b);
+
+      for (; end - p >= 16; p += 16)
+      {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        const __m128i hit = _mm_or_si128(_mm_cmpeq_epi8(v, va), _mm_cmpeq_epi8(v, vb));
+        const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(hit));
+        if (mask)
+          return p + ctz32(mask);
+      }
+      return find_byte2_scalar(p, end, a, b);
+    }
+#endif
+
+#if defined(VIX_UTILS_SIMD_AVX2)
+    __attribute__((target("avx2"))) inline const char *
+    find_byte2_avx2(const char *p, const char *end, char a, char b) noexcept
+    {
+      const __m256i va = _mm256_set1_epi8(a);
+      const __m256i vb = _mm256_set1_epi8(b);
+
+      for (; end - p >= 32; p += 32)
+      {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+        const __m256i hit = _mm256_or_si256(_mm256_cmpeq_epi8(v, va), _mm256_cmpeq_epi8(v, vb));
+        const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(hit));
+        if (mask)
+          return p + ctz32(mask);
+      }
+      return find_byte2_sse2(p, end, a, b);
+    }
+#endif
+
+#if defined(VIX_UTILS_SIMD_NEON)
+    inline const char *find_byte2_neon(const char *p, const char *end, char a, char b) noexcept
+    {
+      const uint8x16_t va = vdupq_n_u8(static_cast<std::uint8_t>(a));
+      const uint8x16_t vb = vdupq_n_u8(static_cast<std::uint8_t>(b));
+
+      for (; end - p >= 16; p += 16)
+      {
+        const uint8x16_t v = vld1q_u8(reinterpret_cast<const std::uint8_t *>(p));
+        if (vmaxvq_u8(vorrq_u8(vceqq_u8(v, va), vceqq_u8(v, vb))))
+          return find_byte2_scalar(p, p + 16, a, b);
+      }
+      return find_byte2_scalar(p, end, a, b);
+    }
+#endif
+
+    /**
+     * @brief Lowercase the ASCII letters of eight packed bytes.
+     *
+     * Works on the low seven bits of each byte so no carry crosses a byte,
+     * then only touches bytes whose high bit is clear.
+     */
+    inline std::uint64_t lower_word(std::uint64_t w) noexcept
+    {
+      constexpr std::uint64_t k01 = 0x0101010101010101ull;
+      constexpr std::uint64_t k80 = 0x8080808080808080ull;
+      const std::uint64_t low7 = w & ~k80;
+      const std::uint64_t ge_a = low7 + (0x80 - 'A') * k01;
+      const std::uint64_t gt_z = low7 + (0x7f - 'Z') * k01;
+      const std::uint64_t upper = (ge_a ^ gt_z) & ~w & k80;
+      return w | (upper >> 2);
+    }
+
+    inline std::uint64_t load_word(const char *p) noexcept
+    {
+      std::uint64_t w;
+      std::memcpy(&w, p, sizeof(w));
+      return w;
+    }
+
+    inline void store_word(char *p, std::uint64_t w) noexcept
+    {
+      std::memcpy(p, &w, sizeof(w));
+    }
+
+    /// n < 16: two overlapping words from 8 bytes up, bytes below that.
+    inline void to_lower_ascii_short(char *p, std::size_t n) noexcept
+    {
+      if (n >= 8)
+      {
+        store_word(p, lower_word(load_word(p)));
+        store_word(p + n - 8, lower_word(load_word(p + n - 8)));
+        return;
+      }
+      to_lower_ascii_scalar(p, p + n);
+    }
+
+    /// n < 16, same split as to_lower_ascii_short.
+    inline bool iequals_ascii_short(const char *a, const char *b, std::size_t n) noexcept
+    {
+      if (n >= 8)
+      {
+        return lower_word(load_word(a)) == lower_word(load_word(b)) &&
+               lower_word(load_word(a + n - 8)) == lower_word(load_word(b + n - 8));
+      }
+      return iequals_ascii_scalar(a, b, n);
+    }
+
+    // The vector kernels below expect n >= one vector. Lowercasing is
+    // idempotent, so the last partial block is redone as an overlapping,
+    // full-width block ending at `end` instead of running a scalar tail.
+
+#if defined(VIX_UTILS_SIMD_SSE2)
+    inline __m128i lower_sse2(__m128i v) noexcept
+    {
+      // +0x3f maps 'A'..'Z' to -128..-103 (signed) and every other byte above.
+      const __m128i shifted = _mm_add_epi8(v, _mm_set1_epi8(0x3f));
+      const __m128i upper = _mm_cmplt_epi8(shifted, _mm_set1_epi8(-102));
+      return _mm_or_si128(v, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+    }
+
+    inline void to_lower_ascii_sse2(char *p, char *end) noexcept
+    {
+      char *const last = end - 16;
+      for (; p < last; p += 16)
+      {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(p), lower_sse2(v));
+      }
+      const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(last));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(last), lower_sse2(v));
+    }
+
+    inline bool iequals_block_sse2(const char *a, const char *b) noexcept
+    {
+      const __m128i va = lower_sse2(_mm_loadu_si128(reinterpret_cast<const __m128i *>(a)));
+      const __m128i vb = lower_sse2(_mm_loadu_si128(reinterpret_cast<const __m128i *>(b)));
+      return _mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)) == 0xffff;
+    }
+
+    inline bool iequals_ascii_sse2(const char *a, const char *b, std::size_t n) noexcept
+    {
+      for (std::size_t i = 0; i + 16 < n; i += 16)
+      {
+        if (!iequals_block_sse2(a + i, b + i))
+          return false;
+      }
+      return iequals_block_sse2(a + n - 16, b + n - 16);
+    }
+#endif
+
+#if defined(VIX_UTILS_SIMD_AVX2)
+    __attribute__((target("avx2"))) inline __m256i lower_avx2(__m256i v) noexcept
+    {
+      const __m256i shifted = _mm256_add_epi8(v, _mm256_set1_epi8(0x3f));
+      const __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(-102), shifted);
+      return _mm256_or_si256(v, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+    }
+
+    __attribute__((target("avx2"))) inline void
+    to_lower_ascii_avx2(char *p, char *end) noexcept
+    {
+      char *const last = end - 32;
+      for (; p < last; p += 32)
+      {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), lower_avx2(v));
+      }
+      const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(last));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(last), lower_avx2(v));
+    }
+
+    __attribute__((target("avx2"))) inline bool
+    iequals_block_avx2(const char *a, const char *b) noexcept
+    {
+      const __m256i va = lower_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(a)));
+      const __m256i vb = lower_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(b)));
+      return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb))) ==
+             0xffffffffu;
+    }
+
+    __attribute__((target("avx2"))) inline bool
+    iequals_ascii_avx2(const char *a, const char *b, std::size_t n) noexcept
+    {
+      for (std::size_t i = 0; i + 32 < n; i += 32)
+      {
+        if (!iequals_block_avx2(a + i, b + i))
+          return false;
+      }
+      return iequals_block_avx2(a + n - 32, b + n - 32);
+    }
+#endif
+
+#if defined(VIX_UTILS_SIMD_NEON)
+    inline uint8x16_t lower_neon(uint8x16_t v) noexcept
+    {
+      const uint8x16_t upper = vcltq_u8(vsubq_u8(v, vdupq_n_u8('A')), vdupq_n_u8(26));
+      return vorrq_u8(v, vandq_u8(upper, vdupq_n_u8(0x20)));
+    }
+
+    inline void to_lower_ascii_neon(char *p, char *end) noexcept
+    {
+      char *const last = end - 16;
+      for (; p < last; p += 16)
+      {
+        auto *u = reinterpret_cast<std::uint8_t *>(p);
+        vst1q_u8(u, lower_neon(vld1q_u8(u)));
+      }
+      auto *u = reinterpret_cast<std::uint8_t *>(last);
+      vst1q_u8(u, lower_neon(vld1q_u8(u)));
+    }
+
+    inline bool iequals_block_neon(const char *a, const char *b) noexcept
+    {
+      const uint8x16_t va = lower_neon(vld1q_u8(reinterpret_cast<const std::uint8_t *>(a)));
+      const uint8x16_t vb = lower_neon(vld1q_u8(reinterpret_cast<const std::uint8_t *>(b)));
+      return vminvq_u8(vceqq_u8(va, vb)) == 0xff;
+    }
+
+    inline bool iequals_ascii_neon(const char *a, const char *b, std::size_t n) noexcept
+    {
+      for (std::size_t i = 0; i + 16 < n; i += 16)
+      {
+        if (!iequals_block_neon(a + i, b + i))
+          return false;
+      }
+      return iequals_block_neon(a + n - 16, b + n - 16);
+    }
+#endif
+  } // namespace detail
+
+  /**
+   * @brief First byte in [p, end) that needs JSON escaping, or end.
+   */
+  inline const char *find_json_escape(const char *p, const char *end) noexcept
+  {
+#if defined(VIX_UTILS_SIMD_AVX2)
+    if (end - p >= 64 && detail::has_avx2())
+      return detail::find_json_escape_avx2(p, end);
+#endif
+#if defined(VIX_UTILS_SIMD_SSE2)
+    return detail::find_json_escape_sse2(p, end);
+#elif defined(VIX_UTILS_SIMD_NEON)
+    return detail::find_json_escape_neon(p, end);
+#else
+    return find_json_escape_scalar(p, end);
+#endif
+  }
+
+  /**
+   * @brief First byte in [p, end) equal to a or b, or end.
+   */
+  inline const char *find_byte2(const char *p, const char *end, char a, char b) noexcept
+  {
+#if defined(VIX_UTILS_SIMD_AVX2)
+    if (end - p >= 64 && detail::has_avx2())
+      return detail::find_byte2_avx2(p, end, a, b);
+#endif
+#if defined(VIX_UTILS_SIMD_SSE2)
+    return detail::find_byte2_sse2(p, end, a, b);
+#elif defined(VIX_UTILS_SIMD_NEON)
+    return detail::find_byte2_neon(p, end, a, b);
+#else
+    return find_byte2_scalar(p, end, a, b);
+#endif
+  }
+
+  /**
+   * @brief Lowercase the ASCII letters in [p, end) in place.
+   */
+  inline void to_lower_ascii(char *p, char *end) noexcept
+  {
+    const auto n = static_cast<std::size_t>(end - p);
+    if (n < 16)
+      return detail::to_lower_ascii_short(p, n);
+#if defined(VIX_UTILS_SIMD_AVX2)
+    if (n >= 64 && detail::has_avx2())
+      return detail::to_lower_ascii_avx2(p, end);
+#endif
+#if defined(VIX_UTILS_SIMD_SSE2)
+    detail::to_lower_ascii_sse2(p, end);
+#elif defined(VIX_UTILS_SIMD_NEON)
+    detail::to_lower_ascii_neon(p, end);
+#else
+    to_lower_ascii_scalar(p, end);
+#endif
+  }
+
+  /**
+   * @brief Whether the n bytes at a and b are equal ignoring ASCII case.
+   */
+  inline bool iequals_ascii(const char *a, const char *b, std::size_t n) noexcept
+  {
+    if (n < 16)
+      return detail::iequals_ascii_short(a, b, n);
+#if defined(VIX_UTILS_SIMD_AVX2)
+    if (n >= 64 && detail::has_avx2())
+      return detail::iequals_ascii_avx2(a, b, n);
+#endif
+#if defined(VIX_UTILS_SIMD_SSE2)
+    return detail::iequals_ascii_sse2(a, b, n);
+#elif defined(VIX_UTILS_SIMD_NEON)
+    return detail::iequals_ascii_neon(a, b, n);
+#else
+    return iequals_ascii_scalar(a, b, n);
+#endif
+  }
+
+} // namespace vix::utils::simd
+
+#endif // VIX_UTILS_SIMD_HPP
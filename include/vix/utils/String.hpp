@@ -20,16 +20,27 @@
 #include <algorithm>
 #include <cctype>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <span>
 #include <unordered_map>
 
+#include <vix/utils/Simd.hpp>
+
 /**
  * @brief Small string helpers (trim, case transform, prefix/suffix checks, split/join).
  *
  * Header-only utilities designed for performance and clarity:
- *  - In-place-by-value trims (return-by-value for chaining)
- *  - ASCII-only case transform (C locale)
+ *  - Allocation-free `trim_view` family, plus by-value and in-place trims
+ *  - ASCII-only case transform and `iequals` (vectorized, see Simd.hpp)
  *  - `split` without stringstream (fewer allocations)
+ *  - `split_view` / `tokenize` / `split_into` yielding views (no allocation)
  *  - `join` with pre-reservation
+ *  - `QueryView` / `DecodedQuery`: flat, lazily or arena-decoded query strings
+ *  - JSON string escaping with a vectorized scan (see Simd.hpp)
  *
  * @note Whitespace detection uses `std::isspace` in the C locale.
  * @note All functions are exception-free and `noexcept` where applicable.
@@ -44,14 +55,72 @@ namespace vix::utils
    */
   inline constexpr bool _is_space(unsigned char c) noexcept
   {
-    // ASCII whitespace: space + \t \n \v \f \r
-    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+    // ASCII whitespace: space + \t \n \v \f \r, as one bit test
+    constexpr std::uint64_t mask = (std::uint64_t{1} << ' ') | (std::uint64_t{0x1f} << '\t');
+    return c <= ' ' && ((mask >> c) & 1u) != 0;
+  }
+
+  /**
+   * @brief View of `s` without leading whitespace (C locale). No allocation.
+   *
+   * @code
+   * ltrim_view("   hello "); // -> "hello "
+   * @endcode
+   */
+  inline constexpr std::string_view ltrim_view(std::string_view s) noexcept
+  {
+    std::size_t b = 0;
+    while (b < s.size() && _is_space(static_cast<unsigned char>(s[b])))
+      ++b;
+    return s.substr(b);
+  }
+
+  /**
+   * @brief View of `s` without trailing whitespace (C locale). No allocation.
+   *
+   * @code
+   * rtrim_view("   hello "); // -> "   hello"
+   * @endcode
+   */
+  inline constexpr std::string_view rtrim_view(std::string_view s) noexcept
+  {
+    std::size_t e = s.size();
+    while (e > 0 && _is_space(static_cast<unsigned char>(s[e - 1])))
+      --e;
+    return s.substr(0, e);
+  }
+
+  /**
+   * @brief View of `s` without leading nor trailing whitespace. No allocation.
+   *
+   * The returned view points into `s`.
+   *
+   * @code
+   * trim_view("  hello  "); // -> "hello"
+   * @endcode
+   */
+  inline constexpr std::string_view trim_view(std::string_view s) noexcept
+  {
+    return rtrim_view(ltrim_view(s));
+  }
+
+  /**
+   * @brief Trim both ends of `s` in place, keeping its buffer.
+   */
+  inline void trim_inplace(std::string &s) noexcept
+  {
+    const std::string_view t = trim_view(s);
+    const auto offset = static_cast<std::size_t>(t.data() - s.data());
+    if (offset != 0)
+      std::char_traits<char>::move(s.data(), t.data(), t.size());
+    s.resize(t.size());
   }
+
   /**
    * @brief Left-trim leading whitespace (C locale).
    *
    * Returns a new string with leading spaces removed. Operates on a copy
-   * and returns by value for easy chaining.
+   * and returns by value for easy chaining; use ltrim_view() to avoid the copy.
    *
    * @param s Input string (copied).
    * @return String without leading whitespace.
@@ -62,9 +131,7 @@ namespace vix::utils
    */
   inline std::string ltrim(std::string s) noexcept
   {
-    auto it = std::find_if(s.begin(), s.end(), [](unsigned char c)
-                           { return !_is_space(c); });
-    s.erase(s.begin(), it);
+    s.erase(0, s.size() - ltrim_view(s).size());
     return s;
   }
 
@@ -72,7 +139,7 @@ namespace vix::utils
    * @brief Right-trim trailing whitespace (C locale).
    *
    * Returns a new string with trailing spaces removed. Operates on a copy
-   * and returns by value for easy chaining.
+   * and returns by value for easy chaining; use rtrim_view() to avoid the copy.
    *
    * @param s Input string (copied).
    * @return String without trailing whitespace.
@@ -83,10 +150,7 @@ namespace vix::utils
    */
   inline std::string rtrim(std::string s) noexcept
   {
-    auto it = std::find_if(s.rbegin(), s.rend(), [](unsigned char c)
-                           { return !_is_space(c); })
-                  .base();
-    s.erase(it, s.end());
+    s.resize(rtrim_view(s).size());
     return s;
   }
 
@@ -101,26 +165,49 @@ namespace vix::utils
    */
   inline std::string trim(std::string s) noexcept
   {
-    return rtrim(ltrim(std::move(s)));
+    trim_inplace(s);
+    return s;
+  }
+
+  /**
+   * @brief Lowercase the ASCII letters of `s` in place (vectorized, see Simd.hpp).
+   *
+   * Bytes outside 'A'..'Z' are left untouched (no unicode folding).
+   */
+  inline void to_lower_inplace(std::string &s) noexcept
+  {
+    simd::to_lower_ascii(s.data(), s.data() + s.size());
   }
 
   /**
    * @brief Convert to lowercase (ASCII only).
    *
-   * Uses `std::tolower` (C locale) per byte. Non-ASCII characters
-   * are transformed byte-wise (no unicode folding).
+   * Same result as `std::tolower` in the C locale, byte-wise. Non-ASCII
+   * characters are left as is (no unicode folding).
    *
    * @param s Input string (copied).
    * @return Lowercased string.
    */
   inline std::string to_lower(std::string s) noexcept
   {
-    std::transform(s.begin(), s.end(), s.begin(),
-                   [](unsigned char c)
-                   { return static_cast<char>(std::tolower(c)); });
+    to_lower_inplace(s);
     return s;
   }
 
+  /**
+   * @brief Case-insensitive equality (ASCII only).
+   *
+   * Sizes are compared first, so differing lengths never touch the bytes.
+   *
+   * @code
+   * iequals("Content-Type", "content-type"); // true
+   * @endcode
+   */
+  inline bool iequals(std::string_view a, std::string_view b) noexcept
+  {
+    return a.size() == b.size() && simd::iequals_ascii(a.data(), b.data(), a.size());
+  }
+
   /**
    * @brief Checks if `s` starts with prefix `p`.
    * @param s Full string (view).
@@ -255,6 +342,332 @@ namespace vix::utils
     return out;
   }
 
+  namespace detail
+  {
+    /**
+     * @brief Single-character separator for SplitView (memchr-backed find).
+     */
+    struct CharSep
+    {
+      char c = ',';
+
+      std::size_t find(std::string_view s) const noexcept { return s.find(c); }
+      constexpr std::size_t size() const noexcept { return 1; }
+    };
+
+    /**
+     * @brief Substring separator for SplitView; empty never matches.
+     */
+    struct StringSep
+    {
+      std::string_view s;
+
+      std::size_t find(std::string_view in) const noexcept
+      {
+        return s.empty() ? std::string_view::npos : in.find(s);
+      }
+      constexpr std::size_t size() const noexcept { return s.size(); }
+    };
+
+    /**
+     * @brief Byte membership table for TokenView delimiters.
+     *
+     * A plain bool per byte: one load per test, which is what keeps the
+     * token scan tight.
+     */
+    struct ByteSet
+    {
+      bool in[256] = {};
+
+      constexpr ByteSet() noexcept = default;
+
+      constexpr explicit ByteSet(std::string_view chars) noexcept
+      {
+        for (const char c : chars)
+          in[static_cast<unsigned char>(c)] = true;
+      }
+
+      constexpr bool contains(char c) const noexcept
+      {
+        return in[static_cast<unsigned char>(c)];
+      }
+    };
+  } // namespace detail
+
+  /**
+   * @brief Lazy range of the segments of a string, as `std::string_view` slices.
+   *
+   * Same segments as `split` (empty segments kept, an empty input yields one
+   * empty segment, an empty string separator yields the whole input), but
+   * nothing is allocated: each step is one `find` on the remaining input.
+   * Iterators hold their own state, so they stay valid after the view is
+   * gone; the slices point into the original string.
+   *
+   * Use through `split_view(s, sep)`.
+   */
+  template <typename Sep>
+  class SplitView : public std::ranges::view_interface<SplitView<Sep>>
+  {
+  public:
+    class iterator
+    {
+    public:
+      using value_type = std::string_view;
+      using difference_type = std::ptrdiff_t;
+      using reference = std::string_view;
+      using iterator_category = std::forward_iterator_tag;
+      using iterator_concept = std::forward_iterator_tag;
+
+      /**
+       * @brief End iterator.
+       */
+      iterator() noexcept = default;
+
+      iterator(std::string_view s, Sep sep) noexcept
+          : rest_(s), sep_(sep), end_(false)
+      {
+        next();
+      }
+
+      std::string_view operator*() const noexcept { return tok_; }
+
+      iterator &operator++() noexcept
+      {
+        next();
+        return *this;
+      }
+
+      iterator operator++(int) noexcept
+      {
+        iterator tmp = *this;
+        next();
+        return tmp;
+      }
+
+      friend bool operator==(const iterator &a, const iterator &b) noexcept
+      {
+        if (a.end_ || b.end_)
+          return a.end_ == b.end_;
+        return a.tok_.data() == b.tok_.data() && a.tok_.size() == b.tok_.size();
+      }
+
+    private:
+      void next() noexcept
+      {
+        if (last_)
+        {
+          end_ = true;
+          return;
+        }
+
+        const std::size_t pos = sep_.find(rest_);
+        if (pos == std::string_view::npos)
+        {
+          tok_ = rest_;
+          rest_ = {};
+          last_ = true;
+          return;
+        }
+
+        tok_ = rest_.substr(0, pos);
+        rest_.remove_prefix(pos + sep_.size());
+      }
+
+      std::string_view rest_;
+      std::string_view tok_;
+      Sep sep_{};
+      bool last_ = false;
+      bool end_ = true;
+    };
+
+    SplitView() noexcept = default;
+    SplitView(std::string_view s, Sep sep) noexcept : s_(s), sep_(sep) {}
+
+    iterator begin() const noexcept { return iterator(s_, sep_); }
+    iterator end() const noexcept { return iterator(); }
+
+  private:
+    std::string_view s_;
+    Sep sep_{};
+  };
+
+  /**
+   * @brief Lazy range of the non-empty tokens between delimiter bytes.
+   *
+   * Runs of delimiters are skipped (like `strtok`, without mutation), so
+   * `tokenize(" a, b ,,c", ", ")` yields `a`, `b`, `c`. Slices point into
+   * the original string; nothing is allocated.
+   *
+   * Use through `tokenize(s, delims)`.
+   */
+  class TokenView : public std::ranges::view_interface<TokenView>
+  {
+  public:
+    class iterator
+    {
+    public:
+      using value_type = std::string_view;
+      using difference_type = std::ptrdiff_t;
+      using reference = std::string_view;
+      using iterator_category = std::forward_iterator_tag;
+      using iterator_concept = std::forward_iterator_tag;
+
+      /**
+       * @brief End iterator.
+       */
+      iterator() noexcept = default;
+
+      iterator(std::string_view s, const detail::ByteSet &delims) noexcept
+          : rest_(s), delims_(delims)
+      {
+        next();
+      }
+
+      std::string_view operator*() const noexcept { return tok_; }
+
+      iterator &operator++() noexcept
+      {
+        next();
+        return *this;
+      }
+
+      iterator operator++(int) noexcept
+      {
+        iterator tmp = *this;
+        next();
+        return tmp;
+      }
+
+      friend bool operator==(const iterator &a, const iterator &b) noexcept
+      {
+        return a.tok_.data() == b.tok_.data() && a.tok_.size() == b.tok_.size();
+      }
+
+    private:
+      void next() noexcept
+      {
+        const detail::ByteSet &set = delims_;
+        const char *p = rest_.data();
+        const char *const end = p + rest_.size();
+
+        while (p != end && set.contains(*p))
+          ++p;
+        const char *const first = p;
+        while (p != end && !set.contains(*p))
+          ++p;
+
+        // An empty token only ever means "no more tokens": it compares
+        // equal to the default (end) iterator.
+        tok_ = p != first ? std::string_view(first, static_cast<std::size_t>(p - first))
+                          : std::string_view();
+        rest_ = std::string_view(p, static_cast<std::size_t>(end - p));
+      }
+
+      std::string_view rest_;
+      std::string_view tok_;
+      detail::ByteSet delims_;
+    };
+
+    TokenView() noexcept = default;
+    TokenView(std::string_view s, std::string_view delims) noexcept
+        : s_(s), delims_(delims)
+    {
+    }
+
+    iterator begin() const noexcept { return iterator(s_, delims_); }
+    iterator end() const noexcept { return iterator(); }
+
+  private:
+    std::string_view s_;
+    detail::ByteSet delims_;
+  };
+
+  /**
+   * @brief Lazily split by a single-character separator (no allocation).
+   *
+   * @code
+   * for (std::string_view part : split_view("a,b,,c", ','))
+   *   use(part); // "a", "b", "", "c"
+   * @endcode
+   */
+  inline SplitView<detail::CharSep> split_view(std::string_view s, char sep) noexcept
+  {
+    return SplitView<detail::CharSep>(s, detail::CharSep{sep});
+  }
+
+  /**
+   * @brief Lazily split by a multi-character separator (no allocation).
+   *
+   * The separator is viewed, not copied: it must outlive the iteration.
+   */
+  inline SplitView<detail::StringSep> split_view(std::string_view s, std::string_view sep) noexcept
+  {
+    return SplitView<detail::StringSep>(s, detail::StringSep{sep});
+  }
+
+  /**
+   * @brief Lazily iterate the non-empty tokens of `s` between any of `delims`.
+   *
+   * @code
+   * // "Accept-Encoding: gzip, deflate,br"
+   * for (std::string_view enc : tokenize(value, ", "))
+   *   use(enc); // "gzip", "deflate", "br"
+   * @endcode
+   */
+  inline TokenView tokenize(std::string_view s, std::string_view delims = " \t") noexcept
+  {
+    return TokenView(s, delims);
+  }
+
+  namespace detail
+  {
+    template <typename Sep>
+    std::size_t split_into(std::string_view s, Sep sep, std::span<std::string_view> out) noexcept
+    {
+      if (out.empty())
+        return 0;
+
+      std::size_t n = 0;
+      while (n + 1 < out.size())
+      {
+        const std::size_t pos = sep.find(s);
+        if (pos == std::string_view::npos)
+          break;
+        out[n++] = s.substr(0, pos);
+        s.remove_prefix(pos + sep.size());
+      }
+      out[n++] = s;
+      return n;
+    }
+  } // namespace detail
+
+  /**
+   * @brief Split into a caller-provided array of slices (no allocation).
+   *
+   * Fills at most `out.size()` slots; when there are more segments, the
+   * last slot receives the unsplit remainder (like a split limit).
+   *
+   * @return Number of slots written (0 only if `out` is empty).
+   *
+   * @code
+   * std::string_view kv[2];
+   * split_into("name=a=b", '=', kv); // 2: "name", "a=b"
+   * @endcode
+   */
+  inline std::size_t split_into(std::string_view s, char sep, std::span<std::string_view> out) noexcept
+  {
+    return detail::split_into(s, detail::CharSep{sep}, out);
+  }
+
+  /**
+   * @brief Multi-character separator overload of split_into.
+   */
+  inline std::size_t split_into(std::string_view s, std::string_view sep,
+                                std::span<std::string_view> out) noexcept
+  {
+    return detail::split_into(s, detail::StringSep{sep}, out);
+  }
+
   /**
    * @brief Join strings with a separator, reserving capacity upfront.
    *
@@ -288,25 +701,10 @@ namespace vix::utils
     return out;
   }
 
-  inline bool starts_with_icase(std::string_view s, std::string_view prefix)
+  inline bool starts_with_icase(std::string_view s, std::string_view prefix) noexcept
   {
-    if (s.size() < prefix.size())
-      return false;
-
-    for (std::size_t i = 0; i < prefix.size(); ++i)
-    {
-      unsigned char a = static_cast<unsigned char>(s[i]);
-      unsigned char b = static_cast<unsigned char>(prefix[i]);
-
-      if (a >= 'A' && a <= 'Z')
-        a = static_cast<unsigned char>(a - 'A' + 'a');
-      if (b >= 'A' && b <= 'Z')
-        b = static_cast<unsigned char>(b - 'A' + 'a');
-
-      if (a != b)
-        return false;
-    }
-    return true;
+    return s.size() >= prefix.size() &&
+           simd::iequals_ascii(s.data(), prefix.data(), prefix.size());
   }
 
   inline std::string extract_boundary(std::string_view ct)
@@ -345,96 +743,525 @@ namespace vix::utils
     return std::string(b);
   }
 
-  inline std::string url_decode(std::string_view in)
+  namespace detail
   {
-    std::string out;
-    out.reserve(in.size());
-
-    for (size_t i = 0; i < in.size(); ++i)
+    /**
+     * @brief Hex digit value per byte, -1 for non-hex bytes.
+     */
+    struct HexTable
     {
-      const unsigned char c = static_cast<unsigned char>(in[i]);
-      if (c == '+')
+      signed char v[256];
+
+      constexpr HexTable() noexcept : v()
       {
-        out.push_back(' ');
+        for (int c = 0; c < 256; ++c)
+          v[c] = -1;
+        for (int c = 0; c < 10; ++c)
+          v['0' + c] = static_cast<signed char>(c);
+        for (int c = 0; c < 6; ++c)
+        {
+          v['a' + c] = static_cast<signed char>(10 + c);
+          v['A' + c] = static_cast<signed char>(10 + c);
+        }
       }
-      else if (c == '%' && i + 2 < in.size())
+    };
+
+    inline constexpr HexTable kHexTable{};
+
+    /**
+     * @brief Decode [src, src + n) into dst and return the decoded size.
+     *
+     * The output is never longer than the input, so dst may alias src
+     * (in-place decoding). Clean spans between `%` / `+` are found with a
+     * vectorized scan and copied in bulk; nothing is copied while dst and
+     * the read position still coincide.
+     */
+    inline std::size_t url_decode_span(const char *src, std::size_t n, char *dst) noexcept
+    {
+      const char *p = src;
+      const char *const end = src + n;
+      char *o = dst;
+
+      for (;;)
       {
-        auto hex = [](unsigned char ch) -> int
-        {
-          if (ch >= '0' && ch <= '9')
-            return ch - '0';
-          if (ch >= 'a' && ch <= 'f')
-            return 10 + (ch - 'a');
-          if (ch >= 'A' && ch <= 'F')
-            return 10 + (ch - 'A');
-          return -1;
-        };
-
-        int hi = hex(static_cast<unsigned char>(in[i + 1]));
-        int lo = hex(static_cast<unsigned char>(in[i + 2]));
-        if (hi >= 0 && lo >= 0)
+        const char *hit = simd::find_byte2(p, end, '%', '+');
+        const auto run = static_cast<std::size_t>(hit - p);
+        if (o != p && run)
+          std::memmove(o, p, run);
+        o += run;
+
+        if (hit == end)
+          break;
+
+        if (*hit == '+')
         {
-          out.push_back(static_cast<char>((hi << 4) | lo));
-          i += 2;
+          *o++ = ' ';
+          p = hit + 1;
+          continue;
         }
-        else
+
+        if (end - hit >= 3)
         {
-          out.push_back(static_cast<char>(c));
+          const int hi = kHexTable.v[static_cast<unsigned char>(hit[1])];
+          const int lo = kHexTable.v[static_cast<unsigned char>(hit[2])];
+          if ((hi | lo) >= 0)
+          {
+            *o++ = static_cast<char>((hi << 4) | lo);
+            p = hit + 3;
+            continue;
+          }
         }
+
+        // Malformed escape: keep the '%' literally.
+        *o++ = '%';
+        p = hit + 1;
       }
-      else
-      {
-        out.push_back(static_cast<char>(c));
-      }
+
+      return static_cast<std::size_t>(o - dst);
     }
+  } // namespace detail
+
+  /**
+   * @brief Decode a URL-encoded (form/query) string into `out`.
+   *
+   * `+` becomes a space and `%XX` the byte 0xXX; malformed escapes are kept
+   * as-is. `out` is overwritten, and its capacity is reused, so a caller
+   * decoding many values can keep one buffer.
+   *
+   * `in` must not alias `out` (use url_decode_inplace for that).
+   */
+  inline void url_decode_into(std::string_view in, std::string &out)
+  {
+    out.resize(in.size());
+    out.resize(detail::url_decode_span(in.data(), in.size(), out.data()));
+  }
+
+  /**
+   * @brief Decode a URL-encoded string in place (never allocates).
+   */
+  inline void url_decode_inplace(std::string &s) noexcept
+  {
+    s.resize(detail::url_decode_span(s.data(), s.size(), s.data()));
+  }
 
+  /**
+   * @brief Decode a URL-encoded (form/query) string.
+   *
+   * @code
+   * url_decode("a+b%2Fc"); // "a b/c"
+   * @endcode
+   */
+  inline std::string url_decode(std::string_view in)
+  {
+    std::string out;
+    url_decode_into(in, out);
     return out;
   }
 
-  inline std::unordered_map<std::string, std::string>
-  parse_query_string(std::string_view qs)
+  /**
+   * @brief Lazily decoded view of a query string (`a=1&b=2&a=3`).
+   *
+   * Parsing only splits the input into raw (still encoded) key/value
+   * slices stored in a flat array, in order and with duplicate keys kept.
+   * Up to kInline parameters live inside the object, so the typical query
+   * costs no allocation at all. Values are decoded only when asked for.
+   *
+   * Lookups are a linear scan, which beats hashing for the usual handful
+   * of parameters. Keys are compared decoded (`a%62=1` matches `"ab"`).
+   * Empty pairs and pairs with an empty key are skipped, like
+   * parse_query_string.
+   *
+   * The view does not own the input: `qs` must outlive it.
+   *
+   * @code
+   * QueryView q("q=red+shoes&page=2");
+   * auto page = q.raw("page");        // "2", no decoding, no allocation
+   * std::string term;
+   * q.get_into("q", term);            // "red shoes"
+   * for (const auto &p : q) ...       // raw pairs, in order
+   * @endcode
+   */
+  class QueryView
   {
-    std::unordered_map<std::string, std::string> out;
+  public:
+    /**
+     * @brief One raw (encoded) parameter.
+     */
+    struct Param
+    {
+      std::string_view key;
+      std::string_view value;
+    };
+
+    /**
+     * @brief Parameters stored without allocating.
+     */
+    static constexpr std::size_t kInline = 16;
+
+    QueryView() noexcept = default;
 
-    size_t pos = 0;
-    while (pos < qs.size())
+    explicit QueryView(std::string_view qs)
     {
-      size_t amp = qs.find('&', pos);
-      if (amp == std::string_view::npos)
-        amp = qs.size();
+      // Upper bound on the pair count: a byte count is cheaper than a
+      // second tokenizing pass.
+      const auto n = static_cast<std::size_t>(std::count(qs.begin(), qs.end(), '&')) + 1;
 
-      std::string_view pair = qs.substr(pos, amp - pos);
-      if (!pair.empty())
+      Param *out = inline_;
+      if (n > kInline)
       {
-        size_t eq = pair.find('=');
-        std::string_view key, val;
+        heap_.resize(n);
+        out = heap_.data();
+      }
+
+      for (std::string_view pair : split_view(qs, '&'))
+      {
+        if (pair.empty() || pair.front() == '=')
+          continue;
+
+        const std::size_t eq = pair.find('=');
         if (eq == std::string_view::npos)
-        {
-          key = pair;
-          val = std::string_view{};
-        }
+          out[size_++] = Param{pair, {}};
         else
-        {
-          key = pair.substr(0, eq);
-          val = pair.substr(eq + 1);
-        }
+          out[size_++] = Param{pair.substr(0, eq), pair.substr(eq + 1)};
+      }
+    }
 
-        auto key_dec = url_decode(key);
-        auto val_dec = url_decode(val);
-        if (!key_dec.empty())
-        {
-          out[std::move(key_dec)] = std::move(val_dec);
-        }
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    const Param *begin() const noexcept { return data(); }
+    const Param *end() const noexcept { return data() + size_; }
+    const Param &operator[](std::size_t i) const noexcept { return data()[i]; }
+
+    /**
+     * @brief Whether a parameter named `key` is present.
+     */
+    bool contains(std::string_view key) const noexcept
+    {
+      return find(key) != nullptr;
+    }
+
+    /**
+     * @brief Number of parameters named `key`.
+     */
+    std::size_t count(std::string_view key) const noexcept
+    {
+      std::size_t n = 0;
+      for (const Param &p : *this)
+        n += key_equals(p.key, key) ? 1 : 0;
+      return n;
+    }
+
+    /**
+     * @brief First parameter named `key`, or nullptr.
+     */
+    const Param *find(std::string_view key) const noexcept
+    {
+      for (const Param &p : *this)
+      {
+        if (key_equals(p.key, key))
+          return &p;
       }
+      return nullptr;
+    }
+
+    /**
+     * @brief Encoded value of the first `key`, or `fallback`.
+     */
+    std::string_view raw(std::string_view key, std::string_view fallback = {}) const noexcept
+    {
+      const Param *p = find(key);
+      return p ? p->value : fallback;
+    }
+
+    /**
+     * @brief Decode the first `key` into `out` (capacity reused).
+     *
+     * @return False (and `out` untouched) if the key is absent.
+     */
+    bool get_into(std::string_view key, std::string &out) const
+    {
+      const Param *p = find(key);
+      if (!p)
+        return false;
+      url_decode_into(p->value, out);
+      return true;
+    }
+
+    /**
+     * @brief Decoded value of the first `key`.
+     */
+    std::optional<std::string> get(std::string_view key) const
+    {
+      const Param *p = find(key);
+      if (!p)
+        return std::nullopt;
+      return url_decode(p->value);
+    }
+
+    /**
+     * @brief Compare an encoded key with a decoded one.
+     */
+    static bool key_equals(std::string_view raw, std::string_view key) noexcept
+    {
+      if (raw == key)
+        return true;
+
+      // Decoding never grows the input.
+      if (raw.size() < key.size())
+        return false;
+
+      std::size_t i = 0;
+      while (i < raw.size() && raw[i] != '%' && raw[i] != '+')
+        ++i;
+
+      // No escape: the plain comparison above was final. Otherwise the
+      // clean prefix must match as-is.
+      if (i == raw.size() || key.size() < i || raw.substr(0, i) != key.substr(0, i))
+        return false;
 
-      if (amp == qs.size())
+      char small[128];
+      if (raw.size() <= sizeof(small))
+      {
+        const std::size_t n = detail::url_decode_span(raw.data(), raw.size(), small);
+        return std::string_view(small, n) == key;
+      }
+
+      std::string tmp;
+      try
+      {
+        url_decode_into(raw, tmp);
+      }
+      catch (...)
+      {
+        return false;
+      }
+      return tmp == key;
+    }
+
+  private:
+    const Param *data() const noexcept
+    {
+      return heap_.empty() ? inline_ : heap_.data();
+    }
+
+    Param inline_[kInline] = {};
+    std::vector<Param> heap_;
+    std::size_t size_ = 0;
+  };
+
+  /**
+   * @brief Fully decoded query string backed by a single arena buffer.
+   *
+   * Every key and value is decoded once into one string sized for the
+   * whole input; the parameters are string_view slices of it, in order
+   * with duplicates kept. Costs one allocation for the arena (plus one for
+   * the parameter array past QueryView::kInline), whatever the number of
+   * parameters. Use it when most values will be read; QueryView is
+   * cheaper when only a few are.
+   */
+  class DecodedQuery
+  {
+  public:
+    using Param = QueryView::Param;
+
+    DecodedQuery() = default;
+
+    explicit DecodedQuery(std::string_view qs)
+    {
+      const QueryView raw(qs);
+      params_.reserve(raw.size());
+
+      // Decoded output never exceeds the input, so the arena never
+      // reallocates and the slices stay valid.
+      arena_.resize(qs.size());
+      char *o = arena_.data();
+
+      for (const Param &p : raw)
+      {
+        const std::size_t kn = detail::url_decode_span(p.key.data(), p.key.size(), o);
+        const std::string_view key(o, kn);
+        o += kn;
+
+        const std::size_t vn = detail::url_decode_span(p.value.data(), p.value.size(), o);
+        const std::string_view value(o, vn);
+        o += vn;
+
+        params_.push_back(Param{key, value});
+      }
+    }
+
+    DecodedQuery(const DecodedQuery &) = delete;
+    DecodedQuery &operator=(const DecodedQuery &) = delete;
+
+    /**
+     * @brief Move, re-anchoring the slices on the new arena.
+     *
+     * A short arena sits in the string's inline buffer and is copied, not
+     * moved, so the slices cannot simply be kept.
+     */
+    DecodedQuery(DecodedQuery &&other) noexcept { *this = std::move(other); }
+
+    DecodedQuery &operator=(DecodedQuery &&other) noexcept
+    {
+      if (this == &other)
+        return *this;
+
+      const char *old = other.arena_.data();
+      arena_ = std::move(other.arena_);
+      params_ = std::move(other.params_);
+      for (Param &p : params_)
+      {
+        p.key = std::string_view(arena_.data() + (p.key.data() - old), p.key.size());
+        p.value = std::string_view(arena_.data() + (p.value.data() - old), p.value.size());
+      }
+      other.arena_.clear();
+      other.params_.clear();
+      return *this;
+    }
+
+    std::size_t size() const noexcept { return params_.size(); }
+    bool empty() const noexcept { return params_.empty(); }
+
+    const Param *begin() const noexcept { return params_.data(); }
+    const Param *end() const noexcept { return params_.data() + params_.size(); }
+    const Param &operator[](std::size_t i) const noexcept { return params_[i]; }
+
+    /**
+     * @brief Decoded value of the first `key`, or `fallback`.
+     */
+    std::string_view get(std::string_view key, std::string_view fallback = {}) const noexcept
+    {
+      for (const Param &p : params_)
+      {
+        if (p.key == key)
+          return p.value;
+      }
+      return fallback;
+    }
+
+    bool contains(std::string_view key) const noexcept
+    {
+      for (const Param &p : params_)
+      {
+        if (p.key == key)
+          return true;
+      }
+      return false;
+    }
+
+  private:
+    std::string arena_;
+    std::vector<Param> params_;
+  };
+
+  /**
+   * @brief Decode a query string into a map (last duplicate wins).
+   *
+   * Allocates every key and value; prefer QueryView or DecodedQuery on
+   * hot paths.
+   */
+  inline std::unordered_map<std::string, std::string>
+  parse_query_string(std::string_view qs)
+  {
+    std::unordered_map<std::string, std::string> out;
+
+    const QueryView q(qs);
+    out.reserve(q.size());
+    for (const QueryView::Param &p : q)
+      out[url_decode(p.key)] = url_decode(p.value);
+
+    return out;
+  }
+
+  /**
+   * @brief Append `s` to `out` with JSON string escaping (no surrounding quotes).
+   *
+   * Clean runs are located with a vectorized scan and appended in bulk;
+   * only `"`, `\\` and control bytes below 0x20 take the slow path.
+   * Bytes >= 0x80 are copied as-is (UTF-8 passes through).
+   *
+   * @tparam Buffer Any buffer with `append(const char*, const char*)` and
+   *         `push_back(char)` (std::string, fmt::memory_buffer).
+   *
+   * @code
+   * std::string out;
+   * json_escape_to(out, "a\"b\n"); // a\"b\n
+   * @endcode
+   */
+  template <typename Buffer>
+  inline void json_escape_to(Buffer &out, std::string_view s)
+  {
+    static constexpr char hex[] = "0123456789abcdef";
+
+    const char *p = s.data();
+    const char *const end = p + s.size();
+
+    for (;;)
+    {
+      const char *hit = simd::find_json_escape(p, end);
+      out.append(p, hit);
+      if (hit == end)
+        return;
+
+      const unsigned char uc = static_cast<unsigned char>(*hit);
+      char esc[6] = {'\\', 0, 0, 0, 0, 0};
+      std::size_t n = 2;
+      switch (uc)
+      {
+      case '"':
+        esc[1] = '"';
+        break;
+      case '\\':
+        esc[1] = '\\';
+        break;
+      case '\b':
+        esc[1] = 'b';
+        break;
+      case '\f':
+        esc[1] = 'f';
+        break;
+      case '\n':
+        esc[1] = 'n';
         break;
-      pos = amp + 1;
+      case '\r':
+        esc[1] = 'r';
+        break;
+      case '\t':
+        esc[1] = 't';
+        break;
+      default:
+        esc[1] = 'u';
+        esc[2] = '0';
+        esc[3] = '0';
+        esc[4] = hex[(uc >> 4) & 0x0F];
+        esc[5] = hex[uc & 0x0F];
+        n = 6;
+        break;
+      }
+      out.append(esc, esc + n);
+      p = hit + 1;
     }
+  }
 
+  /**
+   * @brief JSON-escape `s` into a new string (no surrounding quotes).
+   */
+  inline std::string json_escape(std::string_view s)
+  {
+    std::string out;
+    out.reserve(s.size() + s.size() / 8);
+    json_escape_to(out, s);
     return out;
   }
 
 } // namespace vix::utils
 
+// Iterators own their state, so the views are safe to consume as temporaries.
+template <typename Sep>
+inline constexpr bool std::ranges::enable_borrowed_range<vix::utils::SplitView<Sep>> = true;
+
+template <>
+inline constexpr bool std::ranges::enable_borrowed_range<vix::utils::TokenView> = true;
+
 #endif // VIX_STRING_HPP
@@ -15,20 +15,31 @@
 #define VIX_UTILS_UUID_HPP
 
 #include <string>
+#include <string_view>
 #include <array>
+#include <bit>
+#include <compare>
+#include <cstring>
+#include <functional>
+#include <optional>
 #include <random>
+#include <span>
+#include <type_traits>
 #include <cstdint>
 #include <chrono>
 #include <cstddef>
 
+#include <vix/utils/Time.hpp>
+
 /**
  * @file VIX_UUID_HPP
- * @brief UUID (version 4) generation utilities — RFC 4122 compliant.
+ * @brief UUID generation utilities: random (v4, RFC 4122) and time-ordered (v7, RFC 9562).
  *
- * Provides a lightweight, header-only UUID v4 generator using a thread-local
- * Mersenne Twister (`std::mt19937_64`) engine. The generator mixes hardware
- * entropy (`std::random_device`) with a high-resolution clock timestamp to
- * create unique seeds for each thread.
+ * Provides a header-only UUID v4 generator and a 16-byte `Uuid` value type.
+ * Random bits come from a thread-local xoshiro256** engine (128 bits per
+ * UUID, two engine steps), seeded per thread from `std::random_device`, a
+ * high-resolution clock timestamp and the thread's address. A ChaCha20
+ * engine is available for IDs that must be unguessable (session tokens).
  *
  * The resulting UUID string follows the canonical 8-4-4-4-12 hexadecimal format:
  *
@@ -38,109 +49,539 @@
  *
  * ### Features
  * - Thread-safe (thread-local RNG)
- * - Deterministic within a thread, random across threads
  * - RFC 4122-compliant version (4) and variant (10xxxxxx)
- * - No dynamic allocations except string construction
+ * - `Uuid` is a trivially copyable 16-byte value; `to_chars` formats into
+ *   a caller buffer without allocating
+ * - `uuid4_batch` fills a span of IDs in one call
+ * - `uuid7()` / `Uuid::v7()` give time-ordered IDs for database keys
  *
  * @note Uses lowercase hexadecimal letters (a–f).
+ * @note xoshiro256** is fast but not cryptographically secure; use
+ *       `Uuid::v4_secure()` when an ID doubles as a secret.
  *
  * ### Example
  * @code
- * using namespace Vix::utils;
+ * using namespace vix::utils;
  *
  * std::string id1 = uuid4();
- * std::string id2 = uuid4();
  *
- * std::cout << "Generated UUIDs:\n" << id1 << "\n" << id2 << std::endl;
- * // Example output:
- * //   550e8400-e29b-41d4-a716-446655440000
- * //   e1a6a60e-3dc3-49f2-b3fa-23b8d46f9d5f
+ * Uuid id2 = Uuid::v4();
+ * char buf[Uuid::kStringSize];
+ * id2.to_chars(buf); // no allocation
+ *
+ * std::vector<Uuid> ids(10000);
+ * uuid4_batch(ids);
+ *
+ * std::string key = uuid7(); // sorts by creation time
  * @endcode
  */
 
 namespace vix::utils
 {
   /**
-   * @brief Thread-local random number generator for UUID generation.
+   * @brief xoshiro256** engine (Blackman & Vigna), a UniformRandomBitGenerator.
+   *
+   * 256 bits of state, period 2^256 - 1. Seeded through splitmix64 so any
+   * 64-bit seed gives a well-mixed state.
+   */
+  class Xoshiro256ss
+  {
+  public:
+    using result_type = std::uint64_t;
+
+    explicit Xoshiro256ss(std::uint64_t seed) noexcept
+    {
+      for (auto &w : s_)
+      {
+        seed += 0x9e3779b97f4a7c15ull;
+        std::uint64_t z = seed;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        w = z ^ (z >> 31);
+      }
+    }
+
+    static constexpr result_type min() noexcept { return 0; }
+    static constexpr result_type max() noexcept { return ~result_type{0}; }
+
+    result_type operator()() noexcept
+    {
+      const std::uint64_t result = rotl(s_[1] * 5, 7) * 9;
+      const std::uint64_t t = s_[1] << 17;
+
+      s_[2] ^= s_[0];
+      s_[3] ^= s_[1];
+      s_[1] ^= s_[2];
+      s_[0] ^= s_[3];
+      s_[2] ^= t;
+      s_[3] = rotl(s_[3], 45);
+
+      return result;
+    }
+
+  private:
+    static constexpr std::uint64_t rotl(std::uint64_t x, int k) noexcept
+    {
+      return (x << k) | (x >> (64 - k));
+    }
+
+    std::uint64_t s_[4];
+  };
+
+  /**
+   * @brief ChaCha20 keystream engine (RFC 8439 block function), a UniformRandomBitGenerator.
    *
-   * Seeds the RNG once per thread by combining:
-   * - `std::random_device` entropy
-   * - High-resolution clock timestamp
+   * The 256-bit key comes from `std::random_device`; each 64-byte block
+   * yields eight 64-bit outputs.
+   */
+  class ChaCha20Rng
+  {
+  public:
+    using result_type = std::uint64_t;
+
+    ChaCha20Rng()
+    {
+      std::random_device rd;
+      for (std::size_t i = 0; i < 8; ++i)
+        key_[i] = static_cast<std::uint32_t>(rd());
+      for (std::size_t i = 0; i < 3; ++i)
+        nonce_[i] = static_cast<std::uint32_t>(rd());
+    }
+
+    static constexpr result_type min() noexcept { return 0; }
+    static constexpr result_type max() noexcept { return ~result_type{0}; }
+
+    result_type operator()() noexcept
+    {
+      if (pos_ >= 16)
+        refill();
+      const std::uint64_t lo = block_[pos_++];
+      const std::uint64_t hi = block_[pos_++];
+      return (hi << 32) | lo;
+    }
+
+  private:
+    static constexpr std::uint32_t rotl(std::uint32_t x, int k) noexcept
+    {
+      return (x << k) | (x >> (32 - k));
+    }
+
+    static constexpr void quarter(std::uint32_t &a, std::uint32_t &b,
+                                  std::uint32_t &c, std::uint32_t &d) noexcept
+    {
+      a += b;
+      d = rotl(d ^ a, 16);
+      c += d;
+      b = rotl(b ^ c, 12);
+      a += b;
+      d = rotl(d ^ a, 8);
+      c += d;
+      b = rotl(b ^ c, 7);
+    }
+
+    void refill() noexcept
+    {
+      std::uint32_t in[16] = {0x61707865u, 0x3320646eu, 0x79622d32u, 0x6b206574u};
+      for (std::size_t i = 0; i < 8; ++i)
+        in[4 + i] = key_[i];
+      in[12] = counter_++;
+      for (std::size_t i = 0; i < 3; ++i)
+        in[13 + i] = nonce_[i];
+
+      // Move to a fresh nonce when the 32-bit block counter wraps (every 256 GiB).
+      if (counter_ == 0)
+        ++nonce_[0];
+
+      std::uint32_t x[16];
+      for (std::size_t i = 0; i < 16; ++i)
+        x[i] = in[i];
+
+      for (int round = 0; round < 10; ++round)
+      {
+        quarter(x[0], x[4], x[8], x[12]);
+        quarter(x[1], x[5], x[9], x[13]);
+        quarter(x[2], x[6], x[10], x[14]);
+        quarter(x[3], x[7], x[11], x[15]);
+        quarter(x[0], x[5], x[10], x[15]);
+        quarter(x[1], x[6], x[11], x[12]);
+        quarter(x[2], x[7], x[8], x[13]);
+        quarter(x[3], x[4], x[9], x[14]);
+      }
+
+      for (std::size_t i = 0; i < 16; ++i)
+        block_[i] = x[i] + in[i];
+      pos_ = 0;
+    }
+
+    std::uint32_t key_[8] = {};
+    std::uint32_t nonce_[3] = {};
+    std::uint32_t counter_ = 0;
+    std::uint32_t block_[16] = {};
+    std::size_t pos_ = 16;
+  };
+
+  /**
+   * @brief Per-thread seed mixing `std::random_device`, the clock and the thread address.
    *
-   * This approach ensures unique sequences even on systems where
-   * `std::random_device` is deterministic.
+   * The last two keep seeds distinct where `std::random_device` is
+   * deterministic.
+   */
+  inline std::uint64_t uuid_thread_seed() noexcept
+  {
+    std::uint64_t seed = static_cast<std::uint64_t>(
+        std::chrono::high_resolution_clock::now().time_since_epoch().count());
+
+    thread_local char anchor = 0;
+    seed ^= static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(&anchor)) * 0x9e3779b97f4a7c15ull;
+
+    try
+    {
+      std::random_device rd;
+      seed ^= (static_cast<std::uint64_t>(rd()) << 32) ^ static_cast<std::uint64_t>(rd());
+    }
+    catch (...)
+    {
+    }
+    return seed;
+  }
+
+  /**
+   * @brief Thread-local fast engine behind `Uuid::v4()` and `uuid4()`.
+   */
+  inline Xoshiro256ss &uuid_fast_rng() noexcept
+  {
+    thread_local Xoshiro256ss rng(uuid_thread_seed());
+    return rng;
+  }
+
+  /**
+   * @brief Thread-local ChaCha20 engine behind `Uuid::v4_secure()`.
+   */
+  inline ChaCha20Rng &uuid_secure_rng()
+  {
+    thread_local ChaCha20Rng rng;
+    return rng;
+  }
+
+  /**
+   * @brief Thread-local Mersenne Twister, kept for callers that used it directly.
    *
-   * @return Reference to a thread-local `std::mt19937_64` instance.
+   * UUID generation no longer draws from it.
    */
   inline std::mt19937_64 &uuid_rng() noexcept
   {
-    thread_local std::mt19937_64 rng([]
-                                     {
-            // Mix entropy and time to strengthen seed uniqueness
-            std::random_device rd;
-            auto mix = (static_cast<std::uint64_t>(rd()) << 32)
-                       ^ static_cast<std::uint64_t>(
-                           std::chrono::high_resolution_clock::now().time_since_epoch().count());
-            return std::mt19937_64{mix}; }());
+    thread_local std::mt19937_64 rng(uuid_thread_seed());
     return rng;
   }
 
   /**
-   * @brief Generate a random UUID version 4 (RFC 4122).
+   * @brief A 16-byte UUID value (network byte order).
+   */
+  struct Uuid
+  {
+    /**
+     * @brief Length of the canonical text form (no terminator).
+     */
+    static constexpr std::size_t kStringSize = 36;
+
+    std::array<std::uint8_t, 16> bytes{};
+
+    /**
+     * @brief Build from two big-endian halves.
+     */
+    static constexpr Uuid from_u64(std::uint64_t hi, std::uint64_t lo) noexcept
+    {
+      Uuid u;
+#if defined(__GNUC__) || defined(__clang__)
+      if (!std::is_constant_evaluated() && std::endian::native == std::endian::little)
+      {
+        hi = __builtin_bswap64(hi);
+        lo = __builtin_bswap64(lo);
+        std::memcpy(u.bytes.data(), &hi, 8);
+        std::memcpy(u.bytes.data() + 8, &lo, 8);
+        return u;
+      }
+#endif
+      for (std::size_t i = 0; i < 8; ++i)
+      {
+        u.bytes[i] = static_cast<std::uint8_t>(hi >> (56 - 8 * i));
+        u.bytes[8 + i] = static_cast<std::uint8_t>(lo >> (56 - 8 * i));
+      }
+      return u;
+    }
+
+    /**
+     * @brief Random (version 4) UUID from 128 random bits.
+     */
+    template <typename Rng>
+    static Uuid v4(Rng &rng) noexcept(noexcept(rng()))
+    {
+      const std::uint64_t hi = static_cast<std::uint64_t>(rng());
+      const std::uint64_t lo = static_cast<std::uint64_t>(rng());
+      // RFC 4122: version 0100 in byte 6, variant 10 in byte 8.
+      return from_u64((hi & ~0xF000ull) | 0x4000ull,
+                      (lo & ~(0xC0ull << 56)) | (0x80ull << 56));
+    }
+
+    /**
+     * @brief Random UUID from the thread-local fast engine.
+     */
+    static Uuid v4() noexcept { return v4(uuid_fast_rng()); }
+
+    /**
+     * @brief Random UUID from the thread-local ChaCha20 engine.
+     */
+    static Uuid v4_secure() { return v4(uuid_secure_rng()); }
+
+    /**
+     * @brief Time-ordered (version 7) UUID from the thread-local sequence.
+     *
+     * See `Uuid7Sequence` for the layout and ordering guarantees.
+     */
+    static Uuid v7() noexcept;
+
+    /**
+     * @brief Parse the canonical 8-4-4-4-12 form (either case).
+     */
+    static std::optional<Uuid> parse(std::string_view s) noexcept
+    {
+      if (s.size() != kStringSize)
+        return std::nullopt;
+
+      auto nibble = [](char c) -> int
+      {
+        if (c >= '0' && c <= '9')
+          return c - '0';
+        if (c >= 'a' && c <= 'f')
+          return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F')
+          return c - 'A' + 10;
+        return -1;
+      };
+
+      Uuid u;
+      std::size_t si = 0;
+      for (std::size_t i = 0; i < 16; ++i)
+      {
+        if (si == 8 || si == 13 || si == 18 || si == 23)
+        {
+          if (s[si] != '-')
+            return std::nullopt;
+          ++si;
+        }
+        const int hi = nibble(s[si]);
+        const int lo = nibble(s[si + 1]);
+        if ((hi | lo) < 0)
+          return std::nullopt;
+        u.bytes[i] = static_cast<std::uint8_t>((hi << 4) | lo);
+        si += 2;
+      }
+      return u;
+    }
+
+    /**
+     * @brief Version field (4 for uuid4, 7 for uuid7).
+     */
+    constexpr unsigned version() const noexcept { return bytes[6] >> 4; }
+
+    /**
+     * @brief 48-bit UNIX millisecond prefix of a version 7 UUID.
+     */
+    constexpr std::uint64_t timestamp_ms() const noexcept
+    {
+      std::uint64_t ms = 0;
+      for (std::size_t i = 0; i < 6; ++i)
+        ms = (ms << 8) | bytes[i];
+      return ms;
+    }
+
+    constexpr bool is_nil() const noexcept
+    {
+      for (const auto b : bytes)
+      {
+        if (b)
+          return false;
+      }
+      return true;
+    }
+
+    /**
+     * @brief Write the 36-character lowercase form to out (no terminator).
+     *
+     * @return out + kStringSize.
+     */
+    char *to_chars(char *out) const noexcept
+    {
+      static constexpr auto pairs = []
+      {
+        constexpr char hex[] = "0123456789abcdef";
+        std::array<char, 512> t{};
+        for (std::size_t i = 0; i < 256; ++i)
+        {
+          t[2 * i] = hex[i >> 4];
+          t[2 * i + 1] = hex[i & 0x0F];
+        }
+        return t;
+      }();
+
+      char *o = out;
+      for (std::size_t i = 0; i < 16; ++i)
+      {
+        if (i == 4 || i == 6 || i == 8 || i == 10)
+          *o++ = '-';
+        const char *p = pairs.data() + 2 * bytes[i];
+        o[0] = p[0];
+        o[1] = p[1];
+        o += 2;
+      }
+      return o;
+    }
+
+    /**
+     * @brief Canonical string form.
+     */
+    std::string str() const
+    {
+      std::string s(kStringSize, '\0');
+      to_chars(s.data());
+      return s;
+    }
+
+    friend constexpr bool operator==(const Uuid &, const Uuid &) = default;
+    friend constexpr auto operator<=>(const Uuid &, const Uuid &) = default;
+  };
+
+  /**
+   * @brief Generator state for time-ordered (version 7) UUIDs, RFC 9562.
    *
-   * Fills a 16-byte array with random data, sets the version and variant bits,
-   * and returns a canonical string of the form `"xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx"`.
+   * Layout: 48-bit UNIX milliseconds, version 0111, a 12-bit counter in
+   * rand_a (RFC 9562 method 1), variant 10 and 62 random bits. The counter
+   * is reseeded with a random value below 0x800 on each new millisecond so
+   * at least 2048 IDs fit in one tick; on overflow the timestamp is
+   * advanced by one millisecond. A clock that steps backwards keeps the
+   * last timestamp, so IDs from one sequence are strictly increasing.
+   */
+  class Uuid7Sequence
+  {
+  public:
+    template <typename Rng>
+    Uuid next(std::uint64_t now_ms, Rng &rng) noexcept(noexcept(rng()))
+    {
+      if (now_ms > last_ms_)
+      {
+        last_ms_ = now_ms;
+        counter_ = static_cast<std::uint32_t>(rng()) & 0x7FFu;
+      }
+      else if (++counter_ > 0xFFFu)
+      {
+        ++last_ms_;
+        counter_ = static_cast<std::uint32_t>(rng()) & 0x7FFu;
+      }
+
+      const std::uint64_t hi = ((last_ms_ & 0xFFFFFFFFFFFFull) << 16) | 0x7000ull | counter_;
+      const std::uint64_t lo = static_cast<std::uint64_t>(rng());
+      return Uuid::from_u64(hi, (lo & ~(0xC0ull << 56)) | (0x80ull << 56));
+    }
+
+  private:
+    std::uint64_t last_ms_ = 0;
+    std::uint32_t counter_ = 0;
+  };
+
+  /**
+   * @brief Thread-local sequence behind `Uuid::v7()` and `uuid7()`.
+   */
+  inline Uuid7Sequence &uuid7_sequence() noexcept
+  {
+    thread_local Uuid7Sequence seq;
+    return seq;
+  }
+
+  inline Uuid Uuid::v7() noexcept
+  {
+    return uuid7_sequence().next(unix_ms(), uuid_fast_rng());
+  }
+
+  /**
+   * @brief Fill `out` with ascending version 7 UUIDs; reads the clock once.
+   */
+  inline void uuid7_batch(std::span<Uuid> out) noexcept
+  {
+    Uuid7Sequence &seq = uuid7_sequence();
+    Xoshiro256ss &rng = uuid_fast_rng();
+    const std::uint64_t now = unix_ms();
+    for (Uuid &u : out)
+      u = seq.next(now, rng);
+  }
+
+  /**
+   * @brief Fill `out` with random (version 4) UUIDs from the fast engine.
+   */
+  inline void uuid4_batch(std::span<Uuid> out) noexcept
+  {
+    Xoshiro256ss &rng = uuid_fast_rng();
+    for (Uuid &u : out)
+      u = Uuid::v4(rng);
+  }
+
+  /**
+   * @brief Generate a random UUID version 4 (RFC 4122).
    *
-   * ### Algorithm
-   * 1. Generate 16 random bytes.
-   * 2. Apply version (`0100` for v4) and variant (`10xxxxxx`).
-   * 3. Format into lowercase hex with dashes at positions 8, 13, 18, 23.
+   * Draws 128 bits from the thread-local xoshiro256** engine, sets the
+   * version and variant bits, and returns a canonical string of the form
+   * `"xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx"`. Use `Uuid::v4()` to avoid the
+   * string allocation.
    *
    * @return A 36-character lowercase UUID v4 string.
    *
    * @code
-   * std::string id = Vix::utils::uuid4();
+   * std::string id = vix::utils::uuid4();
    * // Example: "550e8400-e29b-41d4-a716-446655440000"
    * @endcode
    */
   inline std::string uuid4() noexcept
   {
-    // 16 random bytes
-    std::array<std::uint8_t, 16> b{};
-    auto &rng = uuid_rng();
-    std::uniform_int_distribution<std::uint32_t> dist32(0, 0xFFFFFFFFu);
+    return Uuid::v4().str();
+  }
 
-    // Fill 4 bytes per iteration
-    for (std::size_t i = 0; i < 16; i += 4)
-    {
-      std::uint32_t r = dist32(rng);
-      b[i + 0] = static_cast<std::uint8_t>((r >> 24) & 0xFF);
-      b[i + 1] = static_cast<std::uint8_t>((r >> 16) & 0xFF);
-      b[i + 2] = static_cast<std::uint8_t>((r >> 8) & 0xFF);
-      b[i + 3] = static_cast<std::uint8_t>((r >> 0) & 0xFF);
-    }
+  /**
+   * @brief Generate a time-ordered UUID version 7 (RFC 9562).
+   *
+   * The first 48 bits are `unix_ms()`, so IDs sort by creation time and
+   * keep B-tree inserts near the right edge of the index. IDs generated
+   * on one thread are strictly increasing.
+   *
+   * @return A 36-character lowercase UUID v7 string.
+   *
+   * @code
+   * std::string id = vix::utils::uuid7();
+   * // Example: "019a1c3e-7b2d-7c41-9f0e-3a5d8c2b1e47"
+   * @endcode
+   */
+  inline std::string uuid7() noexcept
+  {
+    return Uuid::v7().str();
+  }
 
-    // RFC 4122 — version & variant
-    b[6] = static_cast<std::uint8_t>((b[6] & 0x0F) | 0x40); // version 4
-    b[8] = static_cast<std::uint8_t>((b[8] & 0x3F) | 0x80); // variant 10xxxxxx
+} // namespace vix::utils
 
-    // Format as "8-4-4-4-12" hex string (lowercase)
-    static constexpr char hexdig[] = "0123456789abcdef";
-    std::array<char, 36> out{};
-    std::size_t oi = 0;
-    for (std::size_t i = 0; i < 16; ++i)
+/**
+ * @brief Hash support, so Uuid can key unordered containers.
+ */
+template <>
+struct std::hash<vix::utils::Uuid>
+{
+  std::size_t operator()(const vix::utils::Uuid &u) const noexcept
+  {
+    std::uint64_t hi = 0;
+    std::uint64_t lo = 0;
+    for (std::size_t i = 0; i < 8; ++i)
     {
-      // Insert dashes at UUID canonical positions
-      if (oi == 8 || oi == 13 || oi == 18 || oi == 23)
-        out[oi++] = '-';
-
-      out[oi++] = hexdig[static_cast<std::size_t>((b[i] >> 4) & 0x0F)];
-      out[oi++] = hexdig[static_cast<std::size_t>((b[i] >> 0) & 0x0F)];
+      hi = (hi << 8) | u.bytes[i];
+      lo = (lo << 8) | u.bytes[8 + i];
     }
-
-    return std::string(out.data(), out.size());
+    return static_cast<std::size_t>(hi ^ (lo * 0x9e3779b97f4a7c15ull));
   }
-
-} // namespace vix::utils
+};
 
 #endif // VIX_UUID_HPP
@@ -21,9 +21,18 @@
 #include <optional>
 #include <charconv> // from_chars
 #include <limits>
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <exception>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 #include "String.hpp"
 #include "Result.hpp"
+#include "Pattern.hpp"
 
 /**
  * @brief Lightweight map validation utilities with schema-based rules.
@@ -57,6 +66,14 @@
  *   const auto& errs = res.error();  // FieldErrors
  *   // handle errs.at("field")…
  * }
+ *
+ * // Per-request validation: compile once, reuse.
+ * static const CompiledSchema compiled(schema);
+ * auto fast = compiled.validate(data, ValidationMode::FailFast);
+ *
+ * // Bulk import: one span per column, bitmap result.
+ * ColumnView cols[] = {{"name", names}, {"age", ages}};
+ * BatchResult br = validate_batch(compiled, cols);
  * @endcode
  */
 
@@ -101,6 +118,12 @@ namespace vix::utils
      * If empty, the field key is used.
      */
     std::string label;
+
+    /**
+     * @brief Source of `pattern`, set by `match()`; lets `CompiledSchema`
+     * build a DFA for it. Empty when `pattern` was assigned directly.
+     */
+    std::string pattern_source{};
   };
 
   /**
@@ -266,10 +289,436 @@ namespace vix::utils
   {
     Rule r;
     r.pattern = std::regex(regex_str);
+    r.pattern_source = std::move(regex_str);
     r.label = std::move(lbl);
     return r;
   }
 
+  /**
+   * @brief How `CompiledSchema::validate` reports failures.
+   */
+  enum class ValidationMode
+  {
+    CollectAll, ///< One message per failing field (same as validate_map).
+    FailFast    ///< Stop at the first failing field, in key order.
+  };
+
+  /**
+   * @brief A `Schema` flattened for repeated validation.
+   *
+   * Fields are stored in a contiguous array sorted by key. Error messages
+   * are rendered once at construction. Patterns become `Pattern` objects,
+   * which use a DFA when the expression allows it. A passing input costs
+   * one lookup per field plus the checks, with no allocation.
+   *
+   * Checks and messages are identical to `validate_map`.
+   *
+   * `data` may be any map whose `find(std::string)` yields a value
+   * convertible to `std::string_view`, or a callable
+   * `std::string_view -> std::optional<std::string_view>` (for example a
+   * lambda over `QueryView`).
+   *
+   * @code
+   * static const CompiledSchema compiled(schema);
+   * if (!compiled.is_valid(data)) { ... }
+   * @endcode
+   */
+  class CompiledSchema;
+
+  /**
+   * @brief One input column for `validate_batch`: a field and its per-row values.
+   *
+   * An empty value means the field is absent in that row, as in validate_map.
+   */
+  struct ColumnView
+  {
+    std::string_view key;
+    std::span<const std::string_view> values;
+  };
+
+  /**
+   * @brief Options for `validate_batch`.
+   */
+  struct BatchOptions
+  {
+    /** @brief Worker threads; 0 = hardware concurrency, 1 = calling thread only. */
+    std::size_t threads;
+
+    /** @brief Do not start a worker for fewer rows than this. */
+    std::size_t min_rows_per_thread;
+
+    BatchOptions()
+        : threads(1),
+          min_rows_per_thread(16384)
+    {
+    }
+  };
+
+  /**
+   * @brief Outcome of `validate_batch`: per-field failure bitmaps and failing rows.
+   *
+   * Field `f` (index into `fields`, the schema keys in sorted order) failed
+   * on row `r` when bit `r % 64` of `bits[f * words + r / 64]` is set. Use
+   * `CompiledSchema::row_errors` to render the messages for a row.
+   *
+   * @warning `fields` views the keys of the CompiledSchema passed to
+   * `validate_batch`: the result must not outlive that schema. Field
+   * indices stay valid for any copy of it.
+   */
+  struct BatchResult
+  {
+    std::size_t rows = 0;
+    std::size_t words = 0; ///< 64-bit words per field bitmap.
+    std::vector<std::string_view> fields; ///< Views into the schema's keys.
+    std::vector<std::uint64_t> bits;
+    std::vector<std::size_t> failed_rows; ///< Ascending.
+
+    bool ok() const noexcept { return failed_rows.empty(); }
+
+    bool failed(std::size_t row, std::size_t field) const noexcept
+    {
+      return (bits[field * words + row / 64] >> (row % 64)) & 1u;
+    }
+
+    /**
+     * @brief Number of rows on which `field` failed.
+     */
+    std::size_t failures(std::size_t field) const noexcept
+    {
+      std::size_t n = 0;
+      for (std::size_t w = 0; w < words; ++w)
+        n += static_cast<std::size_t>(std::popcount(bits[field * words + w]));
+      return n;
+    }
+  };
+
+  BatchResult validate_batch(const CompiledSchema &schema,
+                             std::span<const ColumnView> columns,
+                             const BatchOptions &options = BatchOptions());
+
+  class CompiledSchema
+  {
+  public:
+    CompiledSchema() = default;
+
+    explicit CompiledSchema(const Schema &schema)
+    {
+      fields_.reserve(schema.size());
+      for (const auto &[key, rule] : schema)
+        fields_.push_back(compileField(key, rule));
+      std::sort(fields_.begin(), fields_.end(),
+                [](const Field &a, const Field &b)
+                { return a.key < b.key; });
+    }
+
+    /**
+     * @brief Validate `data`; same result as `validate_map` in CollectAll mode.
+     */
+    template <typename Data>
+    Result<void, FieldErrors> validate(const Data &data,
+                                       ValidationMode mode = ValidationMode::CollectAll) const
+    {
+      FieldErrors errs;
+      for (const Field &f : fields_)
+      {
+        const Failure fail = check(f, lookup(data, f.key));
+        if (fail == Failure::None)
+          continue;
+        errs.emplace(f.key, f.messages[static_cast<std::size_t>(fail)]);
+        if (mode == ValidationMode::FailFast)
+          break;
+      }
+
+      if (!errs.empty())
+        return Result<void, FieldErrors>::Err(std::move(errs));
+      return Result<void, FieldErrors>::Ok();
+    }
+
+    /**
+     * @brief Pass/fail only; stops at the first failure and never allocates.
+     */
+    template <typename Data>
+    bool is_valid(const Data &data) const
+    {
+      for (const Field &f : fields_)
+      {
+        if (check(f, lookup(data, f.key)) != Failure::None)
+          return false;
+      }
+      return true;
+    }
+
+    std::size_t size() const noexcept { return fields_.size(); }
+
+    /**
+     * @brief Messages for one row of a columnar batch, as validate() would return.
+     */
+    FieldErrors row_errors(std::span<const ColumnView> columns, std::size_t row) const
+    {
+      FieldErrors errs;
+      for (const Field &f : fields_)
+      {
+        const std::span<const std::string_view> col = column(columns, f.key);
+        const Failure fail = check(f, cell(col, row));
+        if (fail != Failure::None)
+          errs.emplace(f.key, f.messages[static_cast<std::size_t>(fail)]);
+      }
+      return errs;
+    }
+
+  private:
+    friend BatchResult validate_batch(const CompiledSchema &,
+                                      std::span<const ColumnView>,
+                                      const BatchOptions &);
+
+    static std::span<const std::string_view> column(std::span<const ColumnView> columns,
+                                                    std::string_view key) noexcept
+    {
+      for (const ColumnView &c : columns)
+      {
+        if (c.key == key)
+          return c.values;
+      }
+      return {};
+    }
+
+    static std::optional<std::string_view> cell(std::span<const std::string_view> col,
+                                                std::size_t row) noexcept
+    {
+      if (row < col.size())
+        return col[row];
+      return std::nullopt;
+    }
+
+    /**
+     * @brief Fill the bitmap words [w0, w1) of every field.
+     *
+     * Runs one field at a time over the rows so the rule and its pattern
+     * tables stay hot while the column streams through.
+     */
+    void validateWords(std::span<const ColumnView> columns, BatchResult &out,
+                       std::size_t w0, std::size_t w1) const
+    {
+      const std::size_t r1 = std::min(out.rows, w1 * 64);
+      for (std::size_t fi = 0; fi < fields_.size(); ++fi)
+      {
+        const Field &f = fields_[fi];
+        const std::span<const std::string_view> col = column(columns, f.key);
+        std::uint64_t *bits = out.bits.data() + fi * out.words;
+
+        for (std::size_t r = w0 * 64; r < r1; ++r)
+        {
+          if (check(f, cell(col, r)) != Failure::None)
+            bits[r / 64] |= std::uint64_t{1} << (r % 64);
+        }
+      }
+    }
+
+    enum class Failure : std::uint8_t
+    {
+      None,
+      Required,
+      MinLen,
+      MaxLen,
+      NotNumber,
+      Min,
+      Max,
+      Format,
+      Count
+    };
+
+    struct Field
+    {
+      std::string key;
+      bool required = false;
+      bool numeric = false;
+      std::size_t min_len = 0;
+      std::size_t max_len = std::numeric_limits<std::size_t>::max();
+      long long min = std::numeric_limits<long long>::min();
+      long long max = std::numeric_limits<long long>::max();
+      std::optional<Pattern> pattern;
+      std::string messages[static_cast<std::size_t>(Failure::Count)];
+    };
+
+    static Field compileField(const std::string &key, const Rule &rule)
+    {
+      Field f;
+      f.key = key;
+      f.required = rule.required;
+      f.numeric = rule.min.has_value() || rule.max.has_value();
+      if (rule.min_len)
+        f.min_len = *rule.min_len;
+      if (rule.max_len)
+        f.max_len = *rule.max_len;
+      if (rule.min)
+        f.min = *rule.min;
+      if (rule.max)
+        f.max = *rule.max;
+      if (rule.pattern)
+      {
+        if (!rule.pattern_source.empty())
+          f.pattern.emplace(rule.pattern_source);
+        else
+          f.pattern.emplace(*rule.pattern);
+      }
+
+      const std::string &label = rule.label.empty() ? key : rule.label;
+      auto msg = [&](Failure which) -> std::string &
+      { return f.messages[static_cast<std::size_t>(which)]; };
+      msg(Failure::Required) = label + " is required";
+      if (rule.min_len)
+        msg(Failure::MinLen) = label + " must be at least " + std::to_string(*rule.min_len) + " chars";
+      if (rule.max_len)
+        msg(Failure::MaxLen) = label + " must be at most " + std::to_string(*rule.max_len) + " chars";
+      if (f.numeric)
+        msg(Failure::NotNumber) = label + " must be a number";
+      if (rule.min)
+        msg(Failure::Min) = label + " must be >= " + std::to_string(*rule.min);
+      if (rule.max)
+        msg(Failure::Max) = label + " must be <= " + std::to_string(*rule.max);
+      if (rule.pattern)
+        msg(Failure::Format) = label + " has invalid format";
+      return f;
+    }
+
+    template <typename Data>
+    static std::optional<std::string_view> lookup(const Data &data, const std::string &key)
+    {
+      if constexpr (std::is_invocable_r_v<std::optional<std::string_view>, const Data &, std::string_view>)
+      {
+        return data(std::string_view(key));
+      }
+      else
+      {
+        const auto it = data.find(key);
+        if (it == data.end())
+          return std::nullopt;
+        return std::string_view(it->second);
+      }
+    }
+
+    /**
+     * @brief The first failing check, in validate_map order.
+     */
+    static Failure check(const Field &f, std::optional<std::string_view> value)
+    {
+      if (!value || value->empty())
+        return f.required ? Failure::Required : Failure::None;
+
+      const std::string_view v = *value;
+      if (v.size() < f.min_len)
+        return Failure::MinLen;
+      if (v.size() > f.max_len)
+        return Failure::MaxLen;
+
+      if (f.numeric)
+      {
+        long long n = 0;
+        const auto [ptr, ec] = std::from_chars(v.data(), v.data() + v.size(), n, 10);
+        if (ec != std::errc{} || ptr != v.data() + v.size())
+          return Failure::NotNumber;
+        if (n < f.min)
+          return Failure::Min;
+        if (n > f.max)
+          return Failure::Max;
+      }
+
+      if (f.pattern && !f.pattern->matches(v))
+        return Failure::Format;
+      return Failure::None;
+    }
+
+    std::vector<Field> fields_;
+  };
+
+  /**
+   * @brief Validate a columnar batch against a compiled schema.
+   *
+   * Rows are validated one field at a time across each column. With
+   * `options.threads` other than 1, the rows are split into chunks on
+   * 64-row boundaries, so workers never share a bitmap word.
+   *
+   * Columns not named in the schema are ignored. A schema field with no
+   * column, or a column shorter than the batch, counts as absent. The
+   * batch length is the longest column.
+   */
+  inline BatchResult validate_batch(const CompiledSchema &schema,
+                                    std::span<const ColumnView> columns,
+                                    const BatchOptions &options)
+  {
+    BatchResult out;
+    for (const ColumnView &c : columns)
+      out.rows = std::max(out.rows, c.values.size());
+    out.words = (out.rows + 63) / 64;
+    out.fields.reserve(schema.fields_.size());
+    for (const auto &f : schema.fields_)
+      out.fields.push_back(f.key);
+    out.bits.assign(schema.fields_.size() * out.words, 0);
+
+    std::size_t threads = options.threads;
+    if (threads == 0)
+      threads = std::max<unsigned>(1u, std::thread::hardware_concurrency());
+    const std::size_t min_rows = std::max<std::size_t>(64, options.min_rows_per_thread);
+    threads = std::min(threads, std::max<std::size_t>(1, out.rows / min_rows));
+
+    if (threads <= 1)
+    {
+      schema.validateWords(columns, out, 0, out.words);
+    }
+    else
+    {
+      const std::size_t per = (out.words + threads - 1) / threads;
+      std::vector<std::exception_ptr> errors(threads);
+      std::vector<std::thread> workers;
+      workers.reserve(threads - 1);
+      for (std::size_t t = 1; t < threads; ++t)
+      {
+        const std::size_t w0 = std::min(out.words, t * per);
+        const std::size_t w1 = std::min(out.words, w0 + per);
+        if (w0 < w1)
+          workers.emplace_back([&schema, columns, &out, &errors, t, w0, w1]
+                               {
+                                 try
+                                 {
+                                   schema.validateWords(columns, out, w0, w1);
+                                 }
+                                 catch (...)
+                                 {
+                                   errors[t] = std::current_exception();
+                                 } });
+      }
+      try
+      {
+        schema.validateWords(columns, out, 0, std::min(out.words, per));
+      }
+      catch (...)
+      {
+        errors[0] = std::current_exception();
+      }
+      for (auto &w : workers)
+        w.join();
+      for (const auto &e : errors)
+      {
+        if (e)
+          std::rethrow_exception(e);
+      }
+    }
+
+    for (std::size_t w = 0; w < out.words; ++w)
+    {
+      std::uint64_t any = 0;
+      for (std::size_t f = 0; f < out.fields.size(); ++f)
+        any |= out.bits[f * out.words + w];
+      while (any)
+      {
+        const int b = std::countr_zero(any);
+        out.failed_rows.push_back(w * 64 + static_cast<std::size_t>(b));
+        any &= any - 1;
+      }
+    }
+    return out;
+  }
+
 } // namespace vix::utils
 
 #endif // VIX_VALIDATION_HPP
@@ -25,8 +25,12 @@
 #define VIX_UTILS_UTILS_HPP
 
 #include <vix/utils/ConsoleMutex.hpp>
+#include <vix/utils/ConsoleWriter.hpp>
 #include <vix/utils/Env.hpp>
 #include <vix/utils/Logger.hpp>
+#include <vix/utils/Metrics.hpp>
+#include <vix/utils/Multipart.hpp>
+#include <vix/utils/Pattern.hpp>
 #include <vix/utils/Result.hpp>
 #include <vix/utils/ScopeGuard.hpp>
 #include <vix/utils/ServerPrettyLogs.hpp>
@@ -0,0 +1,277 @@
+/**
+ *
+ *  @file ConsoleWriter.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/utils/ConsoleWriter.hpp>
+#include <vix/utils/ConsoleMutex.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace vix::utils
+{
+  namespace
+  {
+    constexpr std::uint64_t kMask = ConsoleWriter::kCapacity - 1;
+    static_assert((ConsoleWriter::kCapacity & kMask) == 0, "capacity must be a power of two");
+
+    /// Batches are written once they reach this size, even if more is queued.
+    constexpr std::size_t kBatchBytes = 64 * 1024;
+
+    /// Slots holding a larger buffer give it back after use.
+    constexpr std::size_t kSlotKeepBytes = 16 * 1024;
+
+    std::FILE *file_of(ConsoleStream stream) noexcept
+    {
+      return stream == ConsoleStream::Err ? stderr : stdout;
+    }
+
+    void emit(ConsoleStream stream, std::string_view text)
+    {
+      if (text.empty())
+        return;
+      std::FILE *f = file_of(stream);
+      std::lock_guard<std::mutex> lk(console_mutex());
+      std::fwrite(text.data(), 1, text.size(), f);
+      std::fflush(f);
+    }
+  } // namespace
+
+  ConsoleWriter &ConsoleWriter::instance()
+  {
+    // Leaked so that loggers destroyed after exit handlers can still reach
+    // it; the exit handler drains the queue and switches to direct writes.
+    static ConsoleWriter *writer = []
+    {
+      auto *w = new ConsoleWriter();
+      std::atexit([]
+                  { ConsoleWriter::instance().stop(); });
+      return w;
+    }();
+    return *writer;
+  }
+
+  ConsoleWriter::ConsoleWriter()
+      : slots_(new Slot[kCapacity])
+  {
+    for (std::size_t i = 0; i < kCapacity; ++i)
+      slots_[i].seq.store(i, std::memory_order_relaxed);
+  }
+
+  ConsoleWriter::~ConsoleWriter()
+  {
+    stop();
+  }
+
+  void ConsoleWriter::writeDirect(ConsoleStream stream, std::string_view text)
+  {
+    emit(stream, text);
+  }
+
+  bool ConsoleWriter::ensureStarted()
+  {
+    const int s = state_.load(std::memory_order_acquire);
+    if (s != kIdle)
+      return s == kRunning;
+
+    std::lock_guard<std::mutex> lk(control_);
+    if (state_.load(std::memory_order_relaxed) == kIdle)
+    {
+      try
+      {
+        thread_ = std::thread([this]
+                              { run(); });
+        state_.store(kRunning, std::memory_order_release);
+      }
+      catch (...)
+      {
+        state_.store(kStopped, std::memory_order_release);
+      }
+    }
+    return state_.load(std::memory_order_relaxed) == kRunning;
+  }
+
+  void ConsoleWriter::write(ConsoleStream stream, std::string_view text)
+  {
+    if (text.empty())
+      return;
+
+    // Announce before checking the state so stop() waits for this write.
+    inflight_.fetch_add(1, std::memory_order_seq_cst);
+    if (!ensureStarted())
+    {
+      inflight_.fetch_sub(1, std::memory_order_release);
+      writeDirect(stream, text);
+      return;
+    }
+
+    std::uint64_t pos = tail_.load(std::memory_order_relaxed);
+    Slot *slot = nullptr;
+    for (;;)
+    {
+      slot = &slots_[pos & kMask];
+      const std::uint64_t seq = slot->seq.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::int64_t>(seq - pos);
+      if (diff == 0)
+      {
+        if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          break;
+      }
+      else if (diff < 0)
+      {
+        // Full: the writer is behind, wait for it to free a slot.
+        std::this_thread::yield();
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+      else
+      {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+
+    slot->stream = stream;
+    try
+    {
+      slot->text.assign(text.data(), text.size());
+    }
+    catch (...)
+    {
+      // The slot must still be published or the queue would stall.
+      slot->text.clear();
+    }
+
+    // seq_cst pairs with the writer's sleeping_ store / slot re-check.
+    slot->seq.store(pos + 1, std::memory_order_seq_cst);
+    inflight_.fetch_sub(1, std::memory_order_release);
+
+    if (sleeping_.load(std::memory_order_seq_cst))
+      wake();
+  }
+
+  void ConsoleWriter::wake() noexcept
+  {
+    if (sleeping_.exchange(false, std::memory_order_acq_rel))
+    {
+      wake_.fetch_add(1, std::memory_order_release);
+      wake_.notify_one();
+    }
+  }
+
+  void ConsoleWriter::flush()
+  {
+    if (!running())
+    {
+      std::lock_guard<std::mutex> lk(console_mutex());
+      std::fflush(stdout);
+      std::fflush(stderr);
+      return;
+    }
+
+    const std::uint64_t target = tail_.load(std::memory_order_acquire);
+    std::uint64_t d = done_.load(std::memory_order_acquire);
+    while (d < target && running())
+    {
+      done_.wait(d, std::memory_order_acquire);
+      d = done_.load(std::memory_order_acquire);
+    }
+  }
+
+  void ConsoleWriter::run()
+  {
+    std::string batch;
+    batch.reserve(kBatchBytes);
+    ConsoleStream current = ConsoleStream::Out;
+
+    auto publish = [&]
+    {
+      emit(current, batch);
+      batch.clear();
+      done_.store(head_, std::memory_order_release);
+      done_.notify_all();
+    };
+
+    for (;;)
+    {
+      for (;;)
+      {
+        Slot &slot = slots_[head_ & kMask];
+        if (slot.seq.load(std::memory_order_acquire) != head_ + 1)
+          break;
+
+        if (!batch.empty() && (slot.stream != current || batch.size() >= kBatchBytes))
+          publish();
+
+        current = slot.stream;
+        batch.append(slot.text);
+        if (slot.text.capacity() > kSlotKeepBytes)
+          std::string().swap(slot.text);
+
+        slot.seq.store(head_ + kCapacity, std::memory_order_release);
+        ++head_;
+      }
+
+      if (!batch.empty() || done_.load(std::memory_order_relaxed) != head_)
+        publish();
+
+      if (state_.load(std::memory_order_acquire) == kStopped)
+        return;
+
+      const std::uint32_t gen = wake_.load(std::memory_order_acquire);
+      sleeping_.store(true, std::memory_order_seq_cst);
+
+      const Slot &next = slots_[head_ & kMask];
+      if (next.seq.load(std::memory_order_seq_cst) == head_ + 1 ||
+          state_.load(std::memory_order_seq_cst) == kStopped)
+      {
+        sleeping_.store(false, std::memory_order_relaxed);
+        continue;
+      }
+
+      wake_.wait(gen, std::memory_order_acquire);
+    }
+  }
+
+  void ConsoleWriter::stop()
+  {
+    std::lock_guard<std::mutex> lk(control_);
+    if (state_.exchange(kStopped, std::memory_order_seq_cst) != kRunning)
+      return;
+
+    sleeping_.store(true, std::memory_order_relaxed);
+    wake();
+    if (thread_.joinable())
+      thread_.join();
+
+    // Writes that raced with the state change: drain them here, while
+    // producers that are still publishing (or waiting for space) finish.
+    for (;;)
+    {
+      Slot &slot = slots_[head_ & kMask];
+      if (slot.seq.load(std::memory_order_acquire) == head_ + 1)
+      {
+        emit(slot.stream, slot.text);
+        slot.text.clear();
+        slot.seq.store(head_ + kCapacity, std::memory_order_release);
+        ++head_;
+        continue;
+      }
+      if (inflight_.load(std::memory_order_seq_cst) == 0 &&
+          tail_.load(std::memory_order_acquire) == head_)
+        break;
+      std::this_thread::yield();
+    }
+
+    done_.store(head_, std::memory_order_release);
+    done_.notify_all();
+  }
+
+} // namespace vix::utils
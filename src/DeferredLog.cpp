@@ -0,0 +1,560 @@
+/**
+ *
+ *  @file DeferredLog.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/utils/DeferredLog.hpp>
+#include <vix/utils/ConsoleMutex.hpp>
+
+#include <algorithm>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace vix::utils::deferred
+{
+  namespace
+  {
+    /**
+     * @brief Prefix of every entry in a ring.
+     *
+     * size covers the prefix, the header and the inline payload, rounded
+     * to 8 bytes. A wrap entry fills the tail of the buffer and sends the
+     * reader back to offset 0.
+     */
+    struct EntryPrefix
+    {
+      std::uint32_t size;
+      std::uint32_t wrap;
+    };
+
+    constexpr std::size_t kAlign = 8;
+    constexpr std::size_t kEntryOverhead = sizeof(EntryPrefix) + sizeof(RecordHeader);
+
+    constexpr std::size_t align_up(std::size_t n) noexcept
+    {
+      return (n + kAlign - 1) & ~(kAlign - 1);
+    }
+
+    std::size_t round_pow2(std::size_t n)
+    {
+      std::size_t p = 1;
+      while (p < n)
+        p <<= 1;
+      return p;
+    }
+
+    std::atomic<std::uint64_t> g_backend_ids{1};
+  } // namespace
+
+  /**
+   * @brief Single-producer single-consumer byte ring owned by one thread.
+   *
+   * tail is only written by the producer, head only by the backend; both
+   * count bytes since creation and are masked on access.
+   */
+  struct DeferredBackend::Ring
+  {
+    explicit Ring(std::size_t bytes)
+        : buffer(new std::byte[bytes]),
+          size(bytes),
+          mask(bytes - 1)
+    {
+    }
+
+    ~Ring()
+    {
+      // Release spilled payloads that were never drained.
+      std::size_t h = head.load(std::memory_order_relaxed);
+      const std::size_t t = tail.load(std::memory_order_relaxed);
+      while (h < t)
+      {
+        const auto *e = reinterpret_cast<const EntryPrefix *>(buffer.get() + (h & mask));
+        if (!e->wrap)
+        {
+          const auto *hdr = reinterpret_cast<const RecordHeader *>(e + 1);
+          if (hdr->spilled)
+          {
+            std::byte *spill = nullptr;
+            std::memcpy(&spill, hdr + 1, sizeof(spill));
+            delete[] spill;
+          }
+        }
+        h += e->size;
+      }
+    }
+
+    std::unique_ptr<std::byte[]> buffer;
+    const std::size_t size;
+    const std::size_t mask;
+
+    // producer side
+    alignas(64) std::atomic<std::size_t> tail{0};
+    std::size_t head_cache = 0;
+    std::atomic<std::uint64_t> written{0};
+    std::atomic<std::uint64_t> dropped{0};
+
+    // consumer side
+    alignas(64) std::atomic<std::size_t> head{0};
+    std::atomic<std::uint64_t> read{0};
+
+    /**
+     * @brief Set when the producing thread is done with this ring.
+     */
+    std::atomic<bool> closed{false};
+  };
+
+  /**
+   * @brief Backend view of one ring during a drain pass.
+   */
+  struct DeferredBackend::Cursor
+  {
+    std::shared_ptr<Ring> ring;
+    std::size_t head = 0;
+    std::size_t end = 0;
+  };
+
+  namespace
+  {
+    /**
+     * @brief The calling thread's ring for the backend it last logged to.
+     *
+     * On thread exit the ring is closed; the backend drains and releases it.
+     */
+    struct ThreadRing
+    {
+      std::uint64_t owner = 0;
+      std::shared_ptr<void> ring;
+      std::atomic<bool> *closed = nullptr;
+
+      ~ThreadRing()
+      {
+        if (closed)
+          closed->store(true, std::memory_order_release);
+      }
+    };
+
+    thread_local ThreadRing tls_ring;
+  } // namespace
+
+  DeferredBackend::DeferredBackend(std::size_t ring_bytes,
+                                   bool block,
+                                   bool defer_format,
+                                   std::shared_ptr<spdlog::logger> logger,
+                                   bool console_sync,
+                                   int cpu)
+      : id_(g_backend_ids.fetch_add(1, std::memory_order_relaxed)),
+        ring_bytes_(round_pow2(std::max<std::size_t>(ring_bytes, 4096))),
+        block_(block),
+        defer_format_(defer_format),
+        console_sync_(console_sync),
+        logger_(std::move(logger))
+  {
+    worker_ = std::thread(
+        [this, cpu]
+        {
+#if defined(__linux__)
+          const unsigned ncpu = std::thread::hardware_concurrency();
+          if (cpu >= 0 && ncpu > 0)
+          {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(static_cast<unsigned>(cpu) % ncpu, &set);
+            (void)::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+          }
+#else
+          (void)cpu;
+#endif
+          run();
+        });
+  }
+
+  DeferredBackend::~DeferredBackend()
+  {
+    stop_.store(true, std::memory_order_release);
+    wake_cv_.notify_all();
+    if (worker_.joinable())
+      worker_.join();
+
+    try
+    {
+      if (logger_)
+        logger_->flush();
+    }
+    catch (...)
+    {
+    }
+  }
+
+  DeferredBackend::Ring &DeferredBackend::localRing()
+  {
+    ThreadRing &t = tls_ring;
+    if (t.owner == id_)
+      return *static_cast<Ring *>(t.ring.get());
+
+    if (t.closed)
+      t.closed->store(true, std::memory_order_release);
+
+    auto ring = std::make_shared<Ring>(ring_bytes_);
+    {
+      std::lock_guard<std::mutex> lock(rings_mutex_);
+      rings_.push_back(ring);
+      rings_version_.fetch_add(1, std::memory_order_release);
+    }
+
+    t.owner = id_;
+    t.closed = &ring->closed;
+    t.ring = std::move(ring);
+    return *static_cast<Ring *>(t.ring.get());
+  }
+
+  bool DeferredBackend::reserve(std::size_t payload_size, Reservation &r)
+  {
+    Ring &ring = localRing();
+
+    const bool spilled = payload_size > ring.size / 4;
+    const std::size_t need =
+        align_up(kEntryOverhead + (spilled ? sizeof(std::byte *) : payload_size));
+
+    std::byte *spill = nullptr;
+    if (spilled)
+    {
+      spill = new (std::nothrow) std::byte[payload_size];
+      if (!spill)
+      {
+        ring.dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+    }
+
+    const std::size_t tail = ring.tail.load(std::memory_order_relaxed);
+    const std::size_t offset = tail & ring.mask;
+    const std::size_t contiguous = ring.size - offset;
+    const std::size_t wrap = contiguous < need ? contiguous : 0;
+
+    while (tail + wrap + need - ring.head_cache > ring.size)
+    {
+      ring.head_cache = ring.head.load(std::memory_order_acquire);
+      if (tail + wrap + need - ring.head_cache <= ring.size)
+        break;
+
+      if (!block_ || stop_.load(std::memory_order_relaxed))
+      {
+        delete[] spill;
+        ring.dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+
+      if (sleeping_.load(std::memory_order_relaxed))
+        wake_cv_.notify_one();
+      std::this_thread::yield();
+    }
+
+    if (wrap)
+    {
+      auto *w = reinterpret_cast<EntryPrefix *>(ring.buffer.get() + offset);
+      w->size = static_cast<std::uint32_t>(wrap);
+      w->wrap = 1;
+    }
+
+    std::byte *at = ring.buffer.get() + ((tail + wrap) & ring.mask);
+    auto *e = reinterpret_cast<EntryPrefix *>(at);
+    e->size = static_cast<std::uint32_t>(need);
+    e->wrap = 0;
+
+    auto *hdr = new (at + sizeof(EntryPrefix)) RecordHeader{};
+    hdr->time_ns = now_ns();
+    hdr->spilled = spilled;
+
+    std::byte *inline_payload = at + kEntryOverhead;
+    if (spilled)
+      std::memcpy(inline_payload, &spill, sizeof(spill));
+
+    r.ring = &ring;
+    r.next_tail = tail + wrap + need;
+    r.header = hdr;
+    r.payload = spilled ? spill : inline_payload;
+    return true;
+  }
+
+  void DeferredBackend::commit(const Reservation &r) noexcept
+  {
+    Ring &ring = *r.ring;
+    ring.tail.store(r.next_tail, std::memory_order_release);
+    ring.written.store(ring.written.load(std::memory_order_relaxed) + 1,
+                       std::memory_order_relaxed);
+
+    if (sleeping_.load(std::memory_order_relaxed))
+      wake_cv_.notify_one();
+  }
+
+  bool DeferredBackend::submitText(spdlog::level::level_enum level,
+                                   std::string_view module,
+                                   std::string_view text)
+  {
+    Reservation r;
+    if (!reserve(text.size() + module.size(), r))
+      return false;
+
+    r.header->fmt_size = static_cast<std::uint32_t>(text.size());
+    r.header->module_size = static_cast<std::uint32_t>(module.size());
+    r.header->level = static_cast<std::uint8_t>(level);
+
+    if (!text.empty())
+      std::memcpy(r.payload, text.data(), text.size());
+    if (!module.empty())
+      std::memcpy(r.payload + text.size(), module.data(), module.size());
+
+    commit(r);
+    return true;
+  }
+
+  std::size_t DeferredBackend::depth() const
+  {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    std::size_t n = 0;
+    for (const auto &ring : rings_)
+    {
+      const auto w = ring->written.load(std::memory_order_relaxed);
+      const auto rd = ring->read.load(std::memory_order_relaxed);
+      n += w > rd ? static_cast<std::size_t>(w - rd) : 0;
+    }
+    return n;
+  }
+
+  std::size_t DeferredBackend::producers() const
+  {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    return rings_.size();
+  }
+
+  std::uint64_t DeferredBackend::dropped() const
+  {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    std::uint64_t n = released_dropped_;
+    for (const auto &ring : rings_)
+      n += ring->dropped.load(std::memory_order_relaxed);
+    return n;
+  }
+
+  void DeferredBackend::flush()
+  {
+    std::vector<std::pair<std::shared_ptr<Ring>, std::size_t>> targets;
+    {
+      std::lock_guard<std::mutex> lock(rings_mutex_);
+      targets.reserve(rings_.size());
+      for (const auto &ring : rings_)
+        targets.emplace_back(ring, ring->tail.load(std::memory_order_acquire));
+    }
+
+    for (const auto &[ring, target] : targets)
+    {
+      while (ring->head.load(std::memory_order_acquire) < target &&
+             !stop_.load(std::memory_order_acquire))
+      {
+        wake_cv_.notify_one();
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+      }
+    }
+
+    logger_->flush();
+  }
+
+  void DeferredBackend::write(const RecordHeader &h, const std::byte *payload)
+  {
+    const auto *text = reinterpret_cast<const char *>(payload);
+    const std::string_view fmtstr(text, h.fmt_size);
+    const std::string_view module(text + h.fmt_size, h.module_size);
+
+    line_.clear();
+    if (!module.empty())
+    {
+      line_.push_back('[');
+      line_.append(module.data(), module.data() + module.size());
+      line_.append(std::string_view("] "));
+    }
+
+    if (h.decode)
+    {
+      try
+      {
+        h.decode(payload + h.fmt_size + h.module_size, fmtstr, line_);
+      }
+      catch (const std::exception &)
+      {
+        line_.append(fmtstr.data(), fmtstr.data() + fmtstr.size());
+      }
+    }
+    else
+    {
+      line_.append(fmtstr.data(), fmtstr.data() + fmtstr.size());
+    }
+
+    const spdlog::log_clock::time_point tp{
+        std::chrono::duration_cast<spdlog::log_clock::duration>(
+            std::chrono::nanoseconds(h.time_ns))};
+    const auto lvl = static_cast<spdlog::level::level_enum>(h.level);
+    const spdlog::string_view_t line(line_.data(), line_.size());
+
+    if (console_sync_)
+      vix::utils::console_wait_banner();
+
+    logger_->log(tp, spdlog::source_loc{}, lvl, line);
+  }
+
+  std::size_t DeferredBackend::drain(std::vector<Cursor> &cursors)
+  {
+    // Snapshot what each producer has published so far.
+    for (auto &c : cursors)
+    {
+      c.head = c.ring->head.load(std::memory_order_relaxed);
+      c.end = c.ring->tail.load(std::memory_order_acquire);
+    }
+
+    std::size_t n = 0;
+    for (;;)
+    {
+      Cursor *best = nullptr;
+      const RecordHeader *best_hdr = nullptr;
+
+      for (auto &c : cursors)
+      {
+        Ring &ring = *c.ring;
+        while (c.head < c.end)
+        {
+          const auto *e = reinterpret_cast<const EntryPrefix *>(ring.buffer.get() + (c.head & ring.mask));
+          if (!e->wrap)
+            break;
+          c.head += e->size;
+          ring.head.store(c.head, std::memory_order_release);
+        }
+
+        if (c.head >= c.end)
+          continue;
+
+        const auto *hdr = reinterpret_cast<const RecordHeader *>(
+            ring.buffer.get() + (c.head & ring.mask) + sizeof(EntryPrefix));
+        if (!best || hdr->time_ns < best_hdr->time_ns)
+        {
+          best = &c;
+          best_hdr = hdr;
+        }
+      }
+
+      if (!best)
+        break;
+
+      Ring &ring = *best->ring;
+      const std::byte *at = ring.buffer.get() + (best->head & ring.mask);
+      const auto *e = reinterpret_cast<const EntryPrefix *>(at);
+
+      std::byte *spill = nullptr;
+      const std::byte *payload = at + kEntryOverhead;
+      if (best_hdr->spilled)
+      {
+        std::memcpy(&spill, payload, sizeof(spill));
+        payload = spill;
+      }
+
+      try
+      {
+        write(*best_hdr, payload);
+      }
+      catch (...)
+      {
+      }
+      delete[] spill;
+
+      best->head += e->size;
+      ring.head.store(best->head, std::memory_order_release);
+      ring.read.store(ring.read.load(std::memory_order_relaxed) + 1,
+                      std::memory_order_relaxed);
+      ++n;
+    }
+
+    return n;
+  }
+
+  void DeferredBackend::run()
+  {
+    std::vector<Cursor> cursors;
+    std::uint64_t seen_version = ~std::uint64_t{0};
+    unsigned idle = 0;
+
+    for (;;)
+    {
+      const std::uint64_t version = rings_version_.load(std::memory_order_acquire);
+      if (version != seen_version)
+      {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        cursors.clear();
+        for (const auto &ring : rings_)
+          cursors.push_back(Cursor{ring, 0, 0});
+        seen_version = rings_version_.load(std::memory_order_relaxed);
+      }
+
+      if (drain(cursors) != 0)
+      {
+        idle = 0;
+        continue;
+      }
+
+      // Release rings whose thread has exited once they are empty.
+      bool released = false;
+      for (const auto &c : cursors)
+      {
+        if (c.ring->closed.load(std::memory_order_acquire) &&
+            c.ring->head.load(std::memory_order_relaxed) ==
+                c.ring->tail.load(std::memory_order_acquire))
+        {
+          released = true;
+          break;
+        }
+      }
+
+      if (released)
+      {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        auto it = std::remove_if(
+            rings_.begin(), rings_.end(),
+            [this](const std::shared_ptr<Ring> &ring)
+            {
+              const bool done =
+                  ring->closed.load(std::memory_order_acquire) &&
+                  ring->head.load(std::memory_order_relaxed) ==
+                      ring->tail.load(std::memory_order_acquire);
+              if (done)
+                released_dropped_ += ring->dropped.load(std::memory_order_relaxed);
+              return done;
+            });
+        rings_.erase(it, rings_.end());
+        rings_version_.fetch_add(1, std::memory_order_release);
+        continue;
+      }
+
+      if (stop_.load(std::memory_order_acquire))
+        break;
+
+      if (++idle < 64)
+      {
+        std::this_thread::yield();
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lk(wake_mutex_);
+      sleeping_.store(true, std::memory_order_relaxed);
+      wake_cv_.wait_for(lk, std::chrono::milliseconds(1));
+      sleeping_.store(false, std::memory_order_relaxed);
+    }
+  }
+
+} // namespace vix::utils::deferred
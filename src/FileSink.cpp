@@ -0,0 +1,434 @@
+/**
+ *
+ *  @file FileSink.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/utils/FileSink.hpp>
+
+#include <spdlog/common.h>
+#include <spdlog/details/os.h>
+
+#include <algorithm>
+#include <ctime>
+#include <filesystem>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if defined(VIX_UTILS_HAS_ZLIB)
+#include <zlib.h>
+#endif
+
+namespace vix::utils
+{
+  namespace fs = std::filesystem;
+
+  BatchedFileSink::BatchedFileSink(Options options)
+      : options_(std::move(options))
+  {
+    if (options_.path.empty())
+      spdlog::throw_spdlog_ex("BatchedFileSink: empty path");
+
+    if (options_.batch_bytes == 0)
+      options_.batch_bytes = 1;
+
+    batch_.reserve(options_.batch_bytes);
+    open();
+    scanSegments();
+
+    if (options_.interval.count() > 0)
+    {
+      const auto now = spdlog::log_clock::now().time_since_epoch();
+      const auto step = std::chrono::duration_cast<spdlog::log_clock::duration>(options_.interval);
+      next_rotation_ = spdlog::log_clock::time_point((now / step + 1) * step);
+    }
+
+    bg_ = std::thread([this]
+                      { run(); });
+  }
+
+  BatchedFileSink::~BatchedFileSink()
+  {
+    {
+      std::lock_guard<std::mutex> lk(bg_mutex_);
+      bg_stop_ = true;
+    }
+    bg_cv_.notify_all();
+    if (bg_.joinable())
+      bg_.join();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    try
+    {
+      writeBatch();
+    }
+    catch (...)
+    {
+    }
+
+    if (file_)
+      std::fclose(file_);
+  }
+
+  bool BatchedFileSink::compressionAvailable() noexcept
+  {
+#if defined(VIX_UTILS_HAS_ZLIB)
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  void BatchedFileSink::open()
+  {
+    const fs::path p(options_.path);
+    std::error_code ec;
+    if (p.has_parent_path())
+      fs::create_directories(p.parent_path(), ec);
+
+    file_ = std::fopen(options_.path.c_str(), "ab");
+    if (!file_)
+      spdlog::throw_spdlog_ex("BatchedFileSink: cannot open " + options_.path, errno);
+
+    // Batches are already large; stdio buffering would only add a copy.
+    std::setvbuf(file_, nullptr, _IONBF, 0);
+
+    const auto size = fs::file_size(p, ec);
+    file_size_ = ec ? 0 : static_cast<std::size_t>(size);
+  }
+
+  void BatchedFileSink::writeBatch()
+  {
+    if (batch_.size() == 0)
+      return;
+
+    // A failed reopen after rotation leaves no file: retry, and drop the
+    // batch if that fails too so it cannot grow without bound.
+    if (!file_)
+    {
+      try
+      {
+        open();
+      }
+      catch (...)
+      {
+        dropped_.fetch_add(batch_records_, std::memory_order_relaxed);
+        batch_.clear();
+        batch_records_ = 0;
+        throw;
+      }
+    }
+
+    const std::size_t n = std::fwrite(batch_.data(), 1, batch_.size(), file_);
+    file_size_ += n;
+    const bool ok = n == batch_.size();
+    batch_.clear();
+    batch_records_ = 0;
+
+    if (!ok)
+      spdlog::throw_spdlog_ex("BatchedFileSink: write failed on " + options_.path, errno);
+  }
+
+  std::string BatchedFileSink::rotatedName() const
+  {
+    const fs::path p(options_.path);
+    const std::string stem = (p.parent_path() / p.stem()).string();
+    const std::string ext = p.extension().string();
+
+    const std::time_t t = std::time(nullptr);
+    std::tm tm{};
+#if defined(_WIN32)
+    gmtime_s(&tm, &t);
+#else
+    gmtime_r(&t, &tm);
+#endif
+    char stamp[32];
+    std::strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", &tm);
+
+    std::string name = stem + "." + stamp + ext;
+    std::error_code ec;
+    for (int i = 1; fs::exists(name, ec) || fs::exists(name + ".gz", ec); ++i)
+      name = stem + "." + stamp + "-" + std::to_string(i) + ext;
+
+    return name;
+  }
+
+  void BatchedFileSink::rotate()
+  {
+    writeBatch();
+
+    if (file_)
+    {
+      std::fclose(file_);
+      file_ = nullptr;
+    }
+    file_size_ = 0;
+
+    const std::string target = rotatedName();
+    std::error_code ec;
+    fs::rename(options_.path, target, ec);
+
+    // On failure file_ stays null and writeBatch() retries the open.
+    try
+    {
+      open();
+    }
+    catch (...)
+    {
+    }
+
+    if (ec)
+      return;
+
+    segments_.push_back(target);
+
+    if (options_.compress && compressionAvailable())
+    {
+      {
+        std::lock_guard<std::mutex> lk(bg_mutex_);
+        to_compress_.push_back(target);
+      }
+      bg_cv_.notify_one();
+    }
+
+    prune();
+  }
+
+  void BatchedFileSink::scanSegments()
+  {
+    // Segments are named <stem>.<YYYYmmdd-HHMMSS>[-<n>]<ext>[.gz] by rotatedName().
+    const fs::path p(options_.path);
+    const std::string prefix = p.stem().string() + ".";
+    const std::string ext = p.extension().string();
+    const fs::path dir = p.parent_path();
+
+    struct Found
+    {
+      std::string stamp;
+      unsigned long n;
+      std::string base;
+    };
+    std::vector<Found> found;
+
+    std::error_code ec;
+    for (fs::directory_iterator it(dir.empty() ? fs::path(".") : dir, ec), end;
+         !ec && it != end; it.increment(ec))
+    {
+      std::string name = it->path().filename().string();
+      if (name.size() > 3 && name.compare(name.size() - 3, 3, ".gz") == 0)
+        name.resize(name.size() - 3);
+
+      constexpr std::size_t kStamp = 15; // YYYYmmdd-HHMMSS
+      if (name.size() < prefix.size() + kStamp + ext.size() ||
+          name.compare(0, prefix.size(), prefix) != 0 ||
+          name.compare(name.size() - ext.size(), ext.size(), ext) != 0)
+        continue;
+
+      const std::string_view mid(name.data() + prefix.size(),
+                                 name.size() - prefix.size() - ext.size());
+      bool ok = mid[8] == '-';
+      for (std::size_t i = 0; ok && i < kStamp; ++i)
+        ok = i == 8 || (mid[i] >= '0' && mid[i] <= '9');
+
+      unsigned long n = 0;
+      if (ok && mid.size() > kStamp)
+      {
+        ok = mid[kStamp] == '-' && mid.size() > kStamp + 1;
+        for (std::size_t i = kStamp + 1; ok && i < mid.size(); ++i)
+        {
+          ok = mid[i] >= '0' && mid[i] <= '9';
+          n = n * 10 + static_cast<unsigned long>(mid[i] - '0');
+        }
+      }
+      if (!ok)
+        continue;
+
+      found.push_back(Found{std::string(mid.substr(0, kStamp)), n, (dir / name).string()});
+    }
+
+    std::sort(found.begin(), found.end(),
+              [](const Found &a, const Found &b)
+              { return a.stamp != b.stamp ? a.stamp < b.stamp : a.n < b.n; });
+
+    // A segment caught mid-compression shows up under both names.
+    for (Found &f : found)
+      if (segments_.empty() || segments_.back() != f.base)
+        segments_.push_back(std::move(f.base));
+
+    prune();
+  }
+
+  void BatchedFileSink::prune()
+  {
+    if (options_.max_files == 0)
+      return;
+
+    std::error_code ec;
+    while (segments_.size() > options_.max_files)
+    {
+      {
+        // The background thread prunes again once the segment is compressed.
+        std::lock_guard<std::mutex> lk(bg_mutex_);
+        if (segments_.front() == compressing_ ||
+            std::find(to_compress_.begin(), to_compress_.end(), segments_.front()) != to_compress_.end())
+          return;
+      }
+
+      const std::string oldest = std::move(segments_.front());
+      segments_.pop_front();
+      fs::remove(oldest, ec);
+      fs::remove(oldest + ".gz", ec);
+    }
+  }
+
+  void BatchedFileSink::sink_it_(const spdlog::details::log_msg &msg)
+  {
+    if (options_.interval.count() > 0 && msg.time >= next_rotation_)
+    {
+      rotate();
+      const auto step = std::chrono::duration_cast<spdlog::log_clock::duration>(options_.interval);
+      next_rotation_ = spdlog::log_clock::time_point(
+          (msg.time.time_since_epoch() / step + 1) * step);
+    }
+
+    formatted_.clear();
+    formatter_->format(msg, formatted_);
+
+    if (options_.max_size > 0 &&
+        file_size_ + batch_.size() + formatted_.size() > options_.max_size &&
+        file_size_ + batch_.size() > 0)
+      rotate();
+
+    if (batch_.size() == 0)
+      batch_since_ = std::chrono::steady_clock::now();
+
+    batch_.append(formatted_.data(), formatted_.data() + formatted_.size());
+    ++batch_records_;
+
+    if (batch_.size() >= options_.batch_bytes)
+      writeBatch();
+  }
+
+  void BatchedFileSink::flush_()
+  {
+    writeBatch();
+  }
+
+  bool BatchedFileSink::gzipFile(const std::string &src, const std::string &dst)
+  {
+#if defined(VIX_UTILS_HAS_ZLIB)
+    std::FILE *in = std::fopen(src.c_str(), "rb");
+    if (!in)
+      return false;
+
+    gzFile out = gzopen(dst.c_str(), "wb6");
+    if (!out)
+    {
+      std::fclose(in);
+      return false;
+    }
+
+    std::vector<char> buf(256 * 1024);
+    bool ok = true;
+    for (;;)
+    {
+      const std::size_t n = std::fread(buf.data(), 1, buf.size(), in);
+      if (n == 0)
+        break;
+      if (gzwrite(out, buf.data(), static_cast<unsigned>(n)) != static_cast<int>(n))
+      {
+        ok = false;
+        break;
+      }
+    }
+
+    ok = ok && !std::ferror(in);
+    std::fclose(in);
+    ok = gzclose(out) == Z_OK && ok;
+
+    std::error_code ec;
+    if (ok)
+      fs::remove(src, ec);
+    else
+      fs::remove(dst, ec);
+    return ok;
+#else
+    (void)src;
+    (void)dst;
+    return false;
+#endif
+  }
+
+  void BatchedFileSink::run()
+  {
+    const auto tick = options_.flush_interval.count() > 0
+                          ? options_.flush_interval
+                          : std::chrono::milliseconds(1000);
+
+    std::unique_lock<std::mutex> lk(bg_mutex_);
+    for (;;)
+    {
+      bg_cv_.wait_for(lk, tick, [this]
+                      { return bg_stop_ || !to_compress_.empty(); });
+
+      const bool compressed = !to_compress_.empty();
+      while (!to_compress_.empty())
+      {
+        compressing_ = std::move(to_compress_.front());
+        to_compress_.pop_front();
+        const std::string src = compressing_;
+
+        lk.unlock();
+        std::error_code ec;
+        if (fs::exists(src, ec))
+          gzipFile(src, src + ".gz");
+        lk.lock();
+        compressing_.clear();
+      }
+
+      // Segments skipped by prune() while they were being compressed.
+      if (compressed)
+      {
+        lk.unlock();
+        {
+          std::lock_guard<std::mutex> sink_lock(mutex_);
+          prune();
+        }
+        lk.lock();
+      }
+
+      if (bg_stop_)
+        return;
+
+      if (options_.flush_interval.count() > 0)
+      {
+        lk.unlock();
+        {
+          std::lock_guard<std::mutex> sink_lock(mutex_);
+          if (batch_.size() > 0 &&
+              std::chrono::steady_clock::now() - batch_since_ >= options_.flush_interval)
+          {
+            try
+            {
+              writeBatch();
+            }
+            catch (...)
+            {
+            }
+          }
+        }
+        lk.lock();
+      }
+    }
+  }
+
+} // namespace vix::utils
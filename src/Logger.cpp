@@ -12,55 +12,318 @@
  *
  */
 #include <vix/utils/Logger.hpp>
+#include <vix/utils/ConsoleWriter.hpp>
 
 #include <spdlog/async.h>
 #include <spdlog/async_logger.h>
 #include <spdlog/pattern_formatter.h>
 #include <spdlog/sinks/ansicolor_sink.h>
 
-#include <cctype>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <limits>
 #include <string>
 #include <string_view>
+#include <thread>
 #ifndef _WIN32
 #include <unistd.h>
 #endif
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 namespace vix::utils
 {
-  thread_local Logger::Context Logger::tls_ctx_{};
+  thread_local Logger::ContextState Logger::tls_ctx_;
+
+  namespace
+  {
+    /**
+     * @brief Colored console sink that queues lines on ConsoleWriter.
+     *
+     * Used instead of stdout_color_sink_mt when VIX_CONSOLE_SYNC is set.
+     * Renders like spdlog's ansicolor sink in color_mode::always. Each
+     * thread formats with its own clone of the formatter, so producers
+     * share no lock; set_pattern / set_formatter bump a stamp that makes
+     * the clones refresh.
+     */
+    class ConsoleQueueSink final : public spdlog::sinks::sink
+    {
+    public:
+      ConsoleQueueSink()
+          : formatter_(std::make_unique<spdlog::pattern_formatter>()),
+            stamp_(next_stamp())
+      {
+      }
+
+      void log(const spdlog::details::log_msg &msg) override
+      {
+        Local &local = local_state();
+        if (local.stamp != stamp_.load(std::memory_order_acquire))
+          refresh(local);
+
+        local.formatted.clear();
+        local.formatter->format(msg, local.formatted);
+
+        const spdlog::memory_buf_t &f = local.formatted;
+        if (msg.color_range_end > msg.color_range_start)
+        {
+          local.line.clear();
+          local.line.append(f.data(), f.data() + msg.color_range_start);
+          const std::string_view color = level_color(msg.level);
+          local.line.append(color.data(), color.data() + color.size());
+          local.line.append(f.data() + msg.color_range_start, f.data() + msg.color_range_end);
+          local.line.append(kReset.data(), kReset.data() + kReset.size());
+          local.line.append(f.data() + msg.color_range_end, f.data() + f.size());
+          ConsoleWriter::instance().write(ConsoleStream::Out,
+                                          std::string_view(local.line.data(), local.line.size()));
+          return;
+        }
+
+        ConsoleWriter::instance().write(ConsoleStream::Out, std::string_view(f.data(), f.size()));
+      }
+
+      // The writer flushes after every batch; waiting here would block producers.
+      void flush() override {}
+
+      void set_pattern(const std::string &pattern) override
+      {
+        set_formatter(std::make_unique<spdlog::pattern_formatter>(pattern));
+      }
+
+      void set_formatter(std::unique_ptr<spdlog::formatter> formatter) override
+      {
+        std::lock_guard<std::mutex> lk(mutex_);
+        formatter_ = std::move(formatter);
+        stamp_.store(next_stamp(), std::memory_order_release);
+      }
+
+    private:
+      static constexpr std::string_view kReset = "\033[m";
+
+      struct Local
+      {
+        std::uint64_t stamp = 0;
+        std::unique_ptr<spdlog::formatter> formatter;
+        spdlog::memory_buf_t formatted;
+        spdlog::memory_buf_t line;
+      };
+
+      static Local &local_state()
+      {
+        thread_local Local local;
+        return local;
+      }
+
+      /// Process-wide, so a stamp never matches a clone of another sink.
+      static std::uint64_t next_stamp() noexcept
+      {
+        static std::atomic<std::uint64_t> stamps{0};
+        return stamps.fetch_add(1, std::memory_order_relaxed) + 1;
+      }
 
-  static std::string lower_copy(std::string_view in)
+      static std::string_view level_color(spdlog::level::level_enum lvl) noexcept
+      {
+        switch (lvl)
+        {
+        case spdlog::level::trace:
+          return "\033[37m";
+        case spdlog::level::debug:
+          return "\033[36m";
+        case spdlog::level::info:
+          return "\033[32m";
+        case spdlog::level::warn:
+          return "\033[33m\033[1m";
+        case spdlog::level::err:
+          return "\033[31m\033[1m";
+        case spdlog::level::critical:
+          return "\033[1m\033[41m";
+        default:
+          return kReset;
+        }
+      }
+
+      void refresh(Local &local)
+      {
+        std::lock_guard<std::mutex> lk(mutex_);
+        local.formatter = formatter_->clone();
+        local.stamp = stamp_.load(std::memory_order_relaxed);
+      }
+
+      std::mutex mutex_;
+      std::unique_ptr<spdlog::formatter> formatter_;
+      std::atomic<std::uint64_t> stamp_;
+    };
+  } // namespace
+
+  /**
+   * @brief Pin the calling thread to a CPU (Linux only, best effort).
+   */
+  static void pin_current_thread(int cpu)
   {
-    std::string out;
-    out.reserve(in.size());
+#if defined(__linux__)
+    const unsigned n = std::thread::hardware_concurrency();
+    if (cpu < 0 || n == 0)
+      return;
 
-    for (char ch : in)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<unsigned>(cpu) % n, &set);
+    (void)::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+#else
+    (void)cpu;
+#endif
+  }
+
+  /**
+   * @brief Create a Logger-owned worker pool; worker i is pinned to first_cpu + i.
+   */
+  static std::shared_ptr<spdlog::details::thread_pool> make_pool(
+      std::size_t capacity,
+      std::size_t workers,
+      int first_cpu)
+  {
+    std::function<void()> on_start = [] {};
+    if (first_cpu >= 0)
     {
-      const auto uc = static_cast<unsigned char>(ch);
-      out.push_back(static_cast<char>(std::tolower(uc)));
+      auto next = std::make_shared<std::atomic<int>>(first_cpu);
+      on_start = [next]
+      { pin_current_thread(next->fetch_add(1, std::memory_order_relaxed)); };
     }
 
-    return out;
+    return std::make_shared<spdlog::details::thread_pool>(
+        capacity, workers, std::move(on_start), [] {});
   }
 
-  Logger::Level Logger::parseLevel(std::string_view s)
+  /**
+   * @brief Default pattern for file output (no ANSI colors).
+   */
+  static constexpr const char *kFilePattern = "%Y-%m-%d %H:%M:%S.%e [%l] %v";
+
+  /**
+   * @brief Default pattern for console output in KV format.
+   *
+   * %T = HH:MM:SS, %^%$ = level color, %l = level (info/warn/error).
+   */
+  static constexpr const char *kConsolePattern = "\033[90m%T [vix]\033[0m [%^%l%$] \033[2m%v\033[0m";
+
+  static bool is_file_sink(const spdlog::sink_ptr &sink)
+  {
+    return dynamic_cast<const BatchedFileSink *>(sink.get()) != nullptr;
+  }
+
+  /**
+   * @brief Console sink: queued on ConsoleWriter, or spdlog's color sink.
+   */
+  static spdlog::sink_ptr make_console_sink(bool sync)
   {
-    const auto v = lower_copy(s);
+    // With VIX_CONSOLE_SYNC, lines go through the ConsoleWriter thread so
+    // they stay ordered with the runtime banner.
+    if (sync)
+      return std::make_shared<ConsoleQueueSink>();
 
-    if (v == "off" || v == "never" || v == "none" || v == "silent" || v == "0")
+    auto color_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+    color_sink->set_color_mode(spdlog::color_mode::always);
+    return color_sink;
+  }
+
+  /**
+   * @brief Swap console sinks that do not match the VIX_CONSOLE_SYNC setting.
+   */
+  static void match_console_sinks(std::vector<spdlog::sink_ptr> &sinks,
+                                  bool sync,
+                                  const std::string &pattern)
+  {
+    for (auto &sink : sinks)
+    {
+      const bool queued = dynamic_cast<const ConsoleQueueSink *>(sink.get()) != nullptr;
+      const bool colored = dynamic_cast<const spdlog::sinks::stdout_color_sink_mt *>(sink.get()) != nullptr;
+      if ((queued && !sync) || (colored && sync))
+      {
+        spdlog::sink_ptr next = make_console_sink(sync);
+        next->set_level(sink->level());
+        next->set_pattern(pattern);
+        sink = std::move(next);
+      }
+    }
+  }
+
+  /**
+   * @brief Parse "64M"-style sizes (K/M/G, powers of 1024); 0 on error.
+   */
+  static std::size_t parse_size(std::string_view s)
+  {
+    const std::string_view v = trim_view(s);
+    std::size_t i = 0;
+    std::size_t n = 0;
+    while (i < v.size() && v[i] >= '0' && v[i] <= '9')
+      n = n * 10 + static_cast<std::size_t>(v[i++] - '0');
+
+    if (i == 0)
+      return 0;
+
+    const std::string_view unit = v.substr(i);
+    if (unit.empty() || iequals(unit, "b"))
+      return n;
+    if (iequals(unit, "k") || iequals(unit, "kb"))
+      return n << 10;
+    if (iequals(unit, "m") || iequals(unit, "mb"))
+      return n << 20;
+    if (iequals(unit, "g") || iequals(unit, "gb"))
+      return n << 30;
+    return 0;
+  }
+
+  /**
+   * @brief Parse hourly|daily or a duration with an optional s/m/h/d suffix; 0 on error.
+   */
+  static std::chrono::seconds parse_interval(std::string_view s)
+  {
+    const std::string_view v = trim_view(s);
+    if (iequals(v, "hourly"))
+      return std::chrono::hours(1);
+    if (iequals(v, "daily"))
+      return std::chrono::hours(24);
+
+    std::size_t i = 0;
+    long long n = 0;
+    while (i < v.size() && v[i] >= '0' && v[i] <= '9')
+      n = n * 10 + (v[i++] - '0');
+
+    if (i == 0)
+      return std::chrono::seconds(0);
+
+    const std::string_view unit = v.substr(i);
+    if (unit.empty() || iequals(unit, "s"))
+      return std::chrono::seconds(n);
+    if (iequals(unit, "m"))
+      return std::chrono::minutes(n);
+    if (iequals(unit, "h"))
+      return std::chrono::hours(n);
+    if (iequals(unit, "d"))
+      return std::chrono::hours(24 * n);
+    return std::chrono::seconds(0);
+  }
+
+  Logger::Level Logger::parseLevel(std::string_view s)
+  {
+    if (iequals(s, "off") || iequals(s, "never") || iequals(s, "none") ||
+        iequals(s, "silent") || iequals(s, "0"))
       return Level::Off;
 
-    if (v == "trace")
+    if (iequals(s, "trace"))
       return Level::Trace;
-    if (v == "debug")
+    if (iequals(s, "debug"))
       return Level::Debug;
-    if (v == "info")
+    if (iequals(s, "info"))
       return Level::Info;
-    if (v == "warn" || v == "warning")
+    if (iequals(s, "warn") || iequals(s, "warning"))
       return Level::Warn;
-    if (v == "error")
+    if (iequals(s, "error"))
       return Level::Error;
-    if (v == "critical" || v == "fatal")
+    if (iequals(s, "critical") || iequals(s, "fatal"))
       return Level::Critical;
 
     return Level::Warn;
@@ -84,25 +347,39 @@ namespace vix::utils
   {
     try
     {
-      auto console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+      const bool console_sync = console_sync_enabled();
+      spdlog::sink_ptr console_sink = make_console_sink(console_sync);
       console_sink->set_level(spdlog::level::trace);
-      console_sink->set_color_mode(spdlog::color_mode::always);
+      console_pattern_ = kConsolePattern;
+      console_sink->set_pattern(console_pattern_);
 
-      // %T = HH:MM:SS
-      // %^%$ = level color
-      // %l = level (info/warn/error)
-      console_sink->set_pattern("\033[90m%T [vix]\033[0m [%^%l%$] \033[2m%v\033[0m");
-
-      spd_ = std::make_shared<spdlog::logger>(
+      auto spd = std::make_shared<spdlog::logger>(
           "vix",
           spdlog::sinks_init_list{console_sink});
       // Default INFO, override with env VIX_LOG_LEVEL
       auto lvl = toSpdLevel(parseLevelFromEnv("VIX_LOG_LEVEL", Level::Info));
-      spd_->set_level(lvl);
-      setFormatFromEnv("VIX_LOG_FORMAT");
+      spd->set_level(lvl);
       // flush on warn+ (keep it snappy)
-      spd_->flush_on(spdlog::level::warn);
-      spdlog::set_default_logger(spd_);
+      spd->flush_on(spdlog::level::warn);
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Pipeline p;
+        p.logger = spd;
+        p.console_sync = console_sync;
+        publish(std::move(p));
+        level_.store(static_cast<int>(lvl), std::memory_order_relaxed);
+      }
+
+      setFormatFromEnv("VIX_LOG_FORMAT");
+      spdlog::set_default_logger(spd);
+      setFileFromEnv();
+      setAsyncFromEnv();
+      setStatsTiming(env_bool("VIX_LOG_STATS_TIMING", false));
+
+      metrics_collector_ = MetricsRegistry::instance().addCollector(
+          [this](MetricsSnapshot &snap)
+          { appendMetrics(snap, stats()); });
     }
     catch (const spdlog::spdlog_ex &ex)
     {
@@ -110,18 +387,43 @@ namespace vix::utils
     }
   }
 
+  Logger::~Logger()
+  {
+    if (metrics_collector_)
+      MetricsRegistry::instance().removeCollector(metrics_collector_);
+    stopFlusher();
+    flush();
+  }
+
   void Logger::setPattern(const std::string &pattern)
   {
+    env_reload();
+
     std::lock_guard<std::mutex> lock(mutex_);
     if (!spd_)
       return;
 
+    console_pattern_ = pattern;
     for (auto &sink : spd_->sinks())
       sink->set_pattern(pattern);
   }
 
   void Logger::setAsync(bool enable)
   {
+    if (enable)
+    {
+      AsyncOptions options;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        options = pool_options_;
+      }
+      setAsync(options);
+      return;
+    }
+
+    env_reload();
+    stopFlusher();
+
     std::lock_guard<std::mutex> lock(mutex_);
     if (!spd_)
       return;
@@ -129,69 +431,628 @@ namespace vix::utils
     try
     {
       auto sinks = spd_->sinks();
+      const bool console_sync = console_sync_enabled();
+      match_console_sinks(sinks, console_sync, console_pattern_);
       auto lvl = spd_->level();
       auto flush = spd_->flush_level();
 
-      if (enable)
+      auto sync_logger = std::make_shared<spdlog::logger>(
+          "vix",
+          sinks.begin(),
+          sinks.end());
+
+      sync_logger->set_level(lvl);
+      sync_logger->flush_on(flush);
+
+      Pipeline p;
+      p.logger = sync_logger;
+      p.console_sync = console_sync;
+      publish(std::move(p));
+      spdlog::set_default_logger(spd_);
+      spd_->debug("Logger switched to sync mode");
+    }
+    catch (const std::exception &e)
+    {
+      std::cerr << "[Logger::setAsync] Failed to toggle mode: " << e.what() << std::endl;
+    }
+  }
+
+  void Logger::setAsync(const AsyncOptions &options)
+  {
+    env_reload();
+    stopFlusher();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!spd_)
+        return;
+
+      try
       {
-        if (!spdlog::thread_pool())
-          spdlog::init_thread_pool(262144, 1);
+        auto sinks = spd_->sinks();
+        const bool console_sync = console_sync_enabled();
+        match_console_sinks(sinks, console_sync, console_pattern_);
+        AsyncOptions next = options;
+        next.queue_capacity = std::max<std::size_t>(next.queue_capacity, 1);
+        next.worker_threads = std::clamp<std::size_t>(next.worker_threads, 1, 1000);
 
-        auto async_logger = std::make_shared<spdlog::async_logger>(
-            "vix",
-            sinks.begin(),
-            sinks.end(),
-            spdlog::thread_pool(),
-            spdlog::async_overflow_policy::overrun_oldest);
+        if (next.deferred || next.thread_rings)
+        {
+          // The backend drains per-thread rings and writes through a sync logger.
+          auto sink_logger = std::make_shared<spdlog::logger>(
+              "vix",
+              sinks.begin(),
+              sinks.end());
 
-        async_logger->set_level(lvl);
-        async_logger->flush_on(flush);
+          sink_logger->set_level(spd_->level());
+          sink_logger->flush_on(spd_->flush_level());
 
-        spd_ = async_logger;
-        spdlog::set_default_logger(spd_);
+          Pipeline p;
+          p.logger = sink_logger;
+          p.backend = std::make_shared<deferred::DeferredBackend>(
+              next.ring_bytes,
+              next.overflow == AsyncOptions::Overflow::Block,
+              next.deferred,
+              sink_logger,
+              console_sync,
+              next.worker_cpu);
+          p.capacity = p.backend->ringBytes();
+          p.console_sync = console_sync;
+
+          pool_options_ = next;
+          publish(std::move(p));
+          spdlog::set_default_logger(spd_);
+        }
+        else
+        {
+          if (!pool_ ||
+              pool_options_.queue_capacity != next.queue_capacity ||
+              pool_options_.worker_threads != next.worker_threads ||
+              pool_options_.worker_cpu != next.worker_cpu)
+          {
+            pool_ = make_pool(next.queue_capacity, next.worker_threads, next.worker_cpu);
+            for (Counter &c : dropped_)
+              c.reset();
+          }
+          pool_options_ = next;
+
+          // DropNew is checked in admit(); a racing producer then waits instead of overrunning.
+          const auto policy = next.overflow == AsyncOptions::Overflow::Overrun
+                                  ? spdlog::async_overflow_policy::overrun_oldest
+                                  : spdlog::async_overflow_policy::block;
+
+          auto async_logger = std::make_shared<spdlog::async_logger>(
+              "vix",
+              sinks.begin(),
+              sinks.end(),
+              pool_,
+              policy);
+
+          async_logger->set_level(spd_->level());
+          async_logger->flush_on(spd_->flush_level());
+
+          Pipeline p;
+          p.logger = async_logger;
+          p.pool = pool_;
+          p.capacity = next.queue_capacity;
+          p.drop_new = next.overflow == AsyncOptions::Overflow::DropNew;
+          p.console_sync = console_sync;
+          publish(std::move(p));
+          spdlog::set_default_logger(spd_);
+        }
       }
-      else
+      catch (const std::exception &e)
+      {
+        std::cerr << "[Logger::setAsync] Failed to toggle mode: " << e.what() << std::endl;
+        return;
+      }
+    }
+
+    if (options.flush_interval.count() > 0)
+      startFlusher(options.flush_interval);
+  }
+
+  void Logger::setFile(const BatchedFileSink::Options &options, bool console)
+  {
+    bool was_async = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!spd_)
+        return;
+
+      try
       {
+        std::vector<spdlog::sink_ptr> sinks;
+        if (console)
+        {
+          for (const auto &sink : spd_->sinks())
+            if (!is_file_sink(sink))
+              sinks.push_back(sink);
+        }
+
+        const bool console_sync = console_sync_enabled();
+        match_console_sinks(sinks, console_sync, console_pattern_);
+
+        auto file_sink = std::make_shared<BatchedFileSink>(options);
+        file_sink->set_level(spdlog::level::trace);
+        sinks.push_back(std::move(file_sink));
+
         auto sync_logger = std::make_shared<spdlog::logger>(
             "vix",
             sinks.begin(),
             sinks.end());
 
-        sync_logger->set_level(lvl);
-        sync_logger->flush_on(flush);
+        sync_logger->set_level(spd_->level());
+        sync_logger->flush_on(spd_->flush_level());
+
+        was_async = current_ && (current_->pool || current_->backend);
 
-        spd_ = sync_logger;
+        Pipeline p;
+        p.logger = sync_logger;
+        p.console_sync = console_sync;
+        publish(std::move(p));
         spdlog::set_default_logger(spd_);
-        spd_->debug("Logger switched to sync mode");
+      }
+      catch (const std::exception &e)
+      {
+        std::cerr << "[Logger::setFile] Failed to open log file: " << e.what() << std::endl;
+        return;
       }
     }
-    catch (const std::exception &e)
+
+    setFormat(format_.load(std::memory_order_relaxed));
+
+    if (was_async)
     {
-      std::cerr << "[Logger::setAsync] Failed to toggle mode: " << e.what() << std::endl;
+      AsyncOptions options_copy;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        options_copy = pool_options_;
+      }
+      setAsync(options_copy);
+    }
+  }
+
+  void Logger::setFileFromEnv()
+  {
+    const std::string path = env_or("VIX_LOG_FILE");
+    if (path.empty())
+      return;
+
+    BatchedFileSink::Options o;
+    o.path = path;
+    o.max_size = parse_size(env_or("VIX_LOG_ROTATE_SIZE", "0"));
+    o.interval = parse_interval(env_or("VIX_LOG_ROTATE_INTERVAL", "0"));
+    o.max_files = env_uint("VIX_LOG_ROTATE_KEEP", 0u);
+    o.compress = env_bool("VIX_LOG_ROTATE_COMPRESS", false);
+    o.flush_interval = std::chrono::milliseconds(
+        env_uint("VIX_LOG_FILE_FLUSH_MS", static_cast<unsigned>(o.flush_interval.count())));
+
+    setFile(o, env_bool("VIX_LOG_CONSOLE", true));
+  }
+
+  void Logger::setAsyncFromEnv()
+  {
+    if (!env_bool("VIX_LOG_ASYNC", false))
+      return;
+    setAsync(AsyncOptions::fromEnv());
+  }
+
+  Logger::AsyncOptions::Overflow Logger::AsyncOptions::parseOverflow(std::string_view s)
+  {
+    if (iequals(s, "block"))
+      return Overflow::Block;
+    if (iequals(s, "drop") || iequals(s, "drop_new") || iequals(s, "drop-new"))
+      return Overflow::DropNew;
+    return Overflow::Overrun;
+  }
+
+  Logger::AsyncOptions Logger::AsyncOptions::fromEnv()
+  {
+    AsyncOptions o;
+    o.queue_capacity = env_uint("VIX_LOG_ASYNC_QUEUE", static_cast<unsigned>(o.queue_capacity));
+    o.worker_threads = env_uint("VIX_LOG_ASYNC_THREADS", static_cast<unsigned>(o.worker_threads));
+    o.flush_interval = std::chrono::milliseconds(env_uint("VIX_LOG_ASYNC_FLUSH_MS", 0u));
+    o.worker_cpu = env_int("VIX_LOG_ASYNC_CPU", o.worker_cpu);
+    o.deferred = env_bool("VIX_LOG_ASYNC_DEFERRED", o.deferred);
+    o.thread_rings = env_bool("VIX_LOG_ASYNC_RINGS", o.thread_rings);
+    o.ring_bytes = env_uint("VIX_LOG_ASYNC_RING_BYTES", static_cast<unsigned>(o.ring_bytes));
+
+    const std::string overflow = env_or("VIX_LOG_ASYNC_OVERFLOW");
+    if (!overflow.empty())
+      o.overflow = parseOverflow(overflow);
+
+    return o;
+  }
+
+  Logger::Stats Logger::stats() const
+  {
+    Stats s;
+    for (std::size_t i = 0; i < kLevelCount; ++i)
+    {
+      s.lines[i] = lines_[i].value();
+      s.dropped_by_level[i] = dropped_[i].value();
+      s.dropped += s.dropped_by_level[i];
+    }
+    s.format_ns = format_ns_.snapshot();
+    s.sink_ns = sink_ns_.snapshot();
+
+    const PipelineRef ref(*this);
+    const Pipeline *p = ref.get();
+    if (p && p->backend)
+    {
+      s.async = true;
+      s.queue_capacity = p->capacity;
+      s.queue_depth = p->backend->depth();
+      s.producers = p->backend->producers();
+      s.dropped += p->backend->dropped();
+      return s;
+    }
+
+    if (!p || !p->pool)
+      return s;
+
+    s.async = true;
+    s.queue_capacity = p->capacity;
+    s.queue_depth = p->pool->queue_size();
+    s.overrun = p->pool->overrun_counter();
+    return s;
+  }
+
+  void Logger::appendMetrics(MetricsSnapshot &snap, const Stats &s)
+  {
+    for (std::size_t i = 0; i < kLevelCount; ++i)
+    {
+      const std::string_view name = levelToString(static_cast<Level>(i));
+      snap.counters.emplace_back(std::string("log.lines.").append(name), s.lines[i]);
+      snap.counters.emplace_back(std::string("log.dropped.").append(name), s.dropped_by_level[i]);
+    }
+    snap.counters.emplace_back("log.dropped", s.dropped);
+    snap.counters.emplace_back("log.overrun", s.overrun);
+    snap.gauges.emplace_back("log.queue_depth", static_cast<std::int64_t>(s.queue_depth));
+    snap.gauges.emplace_back("log.producers", static_cast<std::int64_t>(s.producers));
+    snap.histograms.emplace_back("log.format_ns", s.format_ns);
+    snap.histograms.emplace_back("log.sink_ns", s.sink_ns);
+  }
+
+  void Logger::logMetrics(Level level, const MetricsSnapshot &snap, std::string_view msg)
+  {
+    if (!compiled(level) || !enabled(level))
+      return;
+
+    if (format_.load(std::memory_order_relaxed) == Format::KV)
+    {
+      std::string line(msg);
+      const std::string text = metrics_to_text(snap, ' ');
+      if (!text.empty())
+        line.append(" ").append(text);
+      logf(level, line);
+      return;
+    }
+
+    const std::string json = metrics_to_json(snap);
+    logf(level, std::string(msg), "metrics", RawJson{json});
+  }
+
+  void Logger::waitForReaders() noexcept
+  {
+    for (int pass = 0; pass < 2; ++pass)
+    {
+      const unsigned epoch = reader_epoch_.fetch_xor(1, std::memory_order_seq_cst) & 1u;
+      for (const ReaderCount &c : readers_[epoch])
+        while (c.n.load(std::memory_order_seq_cst) != 0)
+          std::this_thread::yield();
+    }
+  }
+
+  bool Logger::admitSlow(const Pipeline &p, Level level) noexcept
+  {
+    if (!p.pool)
+      return true;
+
+    try
+    {
+      if (p.pool->queue_size() < p.capacity)
+        return true;
+    }
+    catch (...)
+    {
+      return true;
+    }
+
+    dropped_[static_cast<std::size_t>(level)].inc();
+    return false;
+  }
+
+  static std::uint64_t mix64(std::uint64_t x) noexcept
+  {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return x;
+  }
+
+  static std::uint64_t sample_draw() noexcept
+  {
+    // xorshift64*, seeded per thread from the thread's own address.
+    thread_local std::uint64_t state = 0;
+    if (state == 0)
+      state = mix64(reinterpret_cast<std::uintptr_t>(&state)) | 1;
+
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545f4914f6cdd1dull;
+  }
+
+  Logger::ThrottleSlot &Logger::throttleSlot(std::uint64_t key) noexcept
+  {
+    constexpr std::size_t kProbes = 8;
+    const std::size_t home = static_cast<std::size_t>(mix64(key)) & (kThrottleSlots - 1);
+
+    for (;;)
+    {
+      ThrottleSlot *victim = nullptr;
+      std::uint64_t victim_key = 0;
+      std::int64_t oldest = std::numeric_limits<std::int64_t>::max();
+
+      for (std::size_t probe = 0, i = home; probe < kProbes; ++probe, i = (i + 1) & (kThrottleSlots - 1))
+      {
+        ThrottleSlot &s = throttle_[i];
+        std::uint64_t k = s.key.load(std::memory_order_acquire);
+        if (k == key)
+          return s;
+        if (k == 0 && (s.key.compare_exchange_strong(k, key, std::memory_order_acq_rel) || k == key))
+          return s;
+
+        const std::int64_t start = s.window_start.load(std::memory_order_relaxed);
+        if (k != 0 && start < oldest)
+        {
+          oldest = start;
+          victim = &s;
+          victim_key = k;
+        }
+      }
+
+      // Crowded run: evict the slot whose window is oldest rather than let
+      // two keys share a budget. The evicted key starts over when it comes
+      // back, and its pending suppressed count is dropped.
+      if (victim && victim->key.compare_exchange_strong(victim_key, key, std::memory_order_acq_rel))
+      {
+        victim->calls.store(0, std::memory_order_relaxed);
+        victim->window_count.store(0, std::memory_order_relaxed);
+        victim->suppressed.store(0, std::memory_order_relaxed);
+        victim->window_start.store(0, std::memory_order_relaxed);
+        return *victim;
+      }
+      if (victim && victim_key == key)
+        return *victim;
     }
   }
 
+  bool Logger::throttle(Throttle mode,
+                        std::uint64_t key,
+                        std::uint64_t param,
+                        Level level,
+                        std::string_view label)
+  {
+    ThrottleSlot &s = throttleSlot(key ? key : 1);
+
+    if (mode == Throttle::Every)
+      return s.calls.fetch_add(1, std::memory_order_relaxed) % param == 0;
+
+    constexpr std::int64_t kWindowNs = 1000000000;
+    const std::int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                 std::chrono::steady_clock::now().time_since_epoch())
+                                 .count();
+
+    std::int64_t start = s.window_start.load(std::memory_order_relaxed);
+    if (now - start >= kWindowNs &&
+        s.window_start.compare_exchange_strong(start, now, std::memory_order_relaxed))
+    {
+      // Budget resets are approximate: a racing caller may still count
+      // against the closed window.
+      s.window_count.store(0, std::memory_order_relaxed);
+      const std::uint64_t n = s.suppressed.exchange(0, std::memory_order_relaxed);
+      if (n > 0)
+        log(level, "suppressed {} similar messages: {}", n, label);
+    }
+
+    const bool pass = mode == Throttle::Rate
+                          ? s.window_count.fetch_add(1, std::memory_order_relaxed) < param
+                          : (param == UINT64_MAX || sample_draw() < param);
+
+    if (!pass)
+      s.suppressed.fetch_add(1, std::memory_order_relaxed);
+    return pass;
+  }
+
+  void Logger::startFlusher(std::chrono::milliseconds interval)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (flusher_.joinable())
+      return;
+
+    flusher_stop_ = false;
+    flusher_ = std::thread(
+        [this, interval]
+        {
+          std::unique_lock<std::mutex> lk(mutex_);
+          while (!flusher_cv_.wait_for(lk, interval, [this]
+                                       { return flusher_stop_; }))
+          {
+            lk.unlock();
+            flush();
+            lk.lock();
+          }
+        });
+  }
+
+  void Logger::flush()
+  {
+    std::shared_ptr<spdlog::logger> spd;
+    std::shared_ptr<deferred::DeferredBackend> backend;
+    bool console_sync = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!current_)
+        return;
+      spd = current_->logger;
+      backend = current_->backend;
+      console_sync = current_->console_sync;
+    }
+
+    try
+    {
+      if (backend)
+        backend->flush();
+      else if (spd)
+        spd->flush();
+
+      if (console_sync)
+        ConsoleWriter::instance().flush();
+    }
+    catch (...)
+    {
+    }
+  }
+
+  void Logger::stopFlusher()
+  {
+    std::thread t;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      flusher_stop_ = true;
+      t = std::move(flusher_);
+    }
+    flusher_cv_.notify_all();
+
+    if (t.joinable())
+      t.join();
+  }
+
   void Logger::setContext(Context ctx)
   {
-    tls_ctx_ = std::move(ctx);
+    tls_ctx_.ctx = std::move(ctx);
+    tls_ctx_.base_valid = false;
+  }
+
+  void Logger::resetContext(std::string_view request_id, std::string_view module)
+  {
+    Context &c = tls_ctx_.ctx;
+    c.request_id.assign(request_id.data(), request_id.size());
+    c.module.assign(module.data(), module.size());
+    c.fields.clear();
+    tls_ctx_.base_valid = false;
+  }
+
+  void Logger::setContextField(std::string_view key, std::string_view value)
+  {
+    tls_ctx_.ctx.fields[std::string(key)].assign(value.data(), value.size());
+    tls_ctx_.base_valid = false;
   }
 
   void Logger::clearContext()
   {
-    tls_ctx_ = Logger::Context{};
+    Context &c = tls_ctx_.ctx;
+    c.request_id.clear();
+    c.module.clear();
+    c.fields.clear();
+    tls_ctx_.base_valid = false;
   }
 
   Logger::Context Logger::getContext() const
   {
-    return tls_ctx_;
+    return tls_ctx_.ctx;
+  }
+
+  void Logger::renderContext(ContextState &st)
+  {
+    const Context &c = st.ctx;
+    fmt::memory_buffer &kv = st.base_kv;
+    fmt::memory_buffer &json = st.base_json;
+    kv.clear();
+    json.clear();
+
+    auto add = [&](std::string_view k, std::string_view v)
+    {
+      kv.push_back(' ');
+      append(kv, k);
+      kv.push_back('=');
+      append(kv, v);
+
+      json.push_back(',');
+      appendJsonKey(json, k);
+      appendJsonStringValue(json, v);
+    };
+
+    if (!c.request_id.empty())
+      add("rid", c.request_id);
+    if (!c.module.empty())
+      add("mod", c.module);
+    for (const auto &it : c.fields)
+      add(it.first, it.second);
+
+    st.base_valid = true;
+  }
+
+  Logger::ContextGuard &Logger::ContextGuard::push(std::string_view key, std::string_view value)
+  {
+    ContextState &st = tls_ctx_;
+    if (!active_)
+    {
+      base_ = st.fields.size();
+      active_ = true;
+    }
+
+    ContextState::Field f{};
+    f.arena_mark = st.arena.size();
+    f.kv_mark = st.scoped_kv.size();
+    f.json_mark = st.scoped_json.size();
+
+    f.key_off = st.arena.size();
+    f.key_len = key.size();
+    st.arena.append(key.data(), key.size());
+    f.val_off = st.arena.size();
+    f.val_len = value.size();
+    st.arena.append(value.data(), value.size());
+
+    st.scoped_kv.push_back(' ');
+    append(st.scoped_kv, key);
+    st.scoped_kv.push_back('=');
+    append(st.scoped_kv, value);
+
+    st.scoped_json.push_back(',');
+    appendJsonKey(st.scoped_json, key);
+    appendJsonStringValue(st.scoped_json, value);
+
+    st.fields.push_back(f);
+    return *this;
+  }
+
+  Logger::ContextGuard::~ContextGuard() noexcept
+  {
+    if (!active_)
+      return;
+
+    ContextState &st = tls_ctx_;
+    if (base_ >= st.fields.size())
+      return;
+
+    const ContextState::Field &first = st.fields[base_];
+    st.arena.resize(first.arena_mark);
+    st.scoped_kv.resize(first.kv_mark);
+    st.scoped_json.resize(first.json_mark);
+    st.fields.resize(base_);
   }
 
   Logger::Format Logger::parseFormat(std::string_view s)
   {
-    const auto v = lower_copy(s);
-    if (v == "json")
+    if (iequals(s, "json"))
       return Format::JSON;
-    if (v == "json-pretty" || v == "pretty-json" || v == "json_pretty")
+    if (iequals(s, "json-pretty") || iequals(s, "pretty-json") || iequals(s, "json_pretty"))
       return Format::JSON_PRETTY;
     return Format::KV;
   }
@@ -199,22 +1060,34 @@ namespace vix::utils
   void Logger::setFormat(Format f)
   {
     std::lock_guard<std::mutex> lock(mutex_);
-    format_ = f;
+    format_.store(f, std::memory_order_relaxed);
 
     if (!spd_)
       return;
 
-    if (format_ == Format::JSON || format_ == Format::JSON_PRETTY)
+    bool file_mode = false;
+    for (const auto &sink : spd_->sinks())
+      file_mode = file_mode || is_file_sink(sink);
+
+    if (f == Format::JSON || f == Format::JSON_PRETTY)
     {
+      console_pattern_ = "%v";
       for (auto &sink : spd_->sinks())
         sink->set_pattern("%v");
 
-      spd_->flush_on(spdlog::level::info);
+      // Per-line flushes would defeat file batching; the sink flushes on a timer.
+      spd_->flush_on(file_mode ? spdlog::level::warn : spdlog::level::info);
       return;
     }
 
+    console_pattern_ = kConsolePattern;
     for (auto &sink : spd_->sinks())
-      sink->set_pattern("\033[90m%T [vix]\033[0m [%^%l%$] \033[2m%v\033[0m");
+    {
+      if (is_file_sink(sink))
+        sink->set_pattern(kFilePattern);
+      else
+        sink->set_pattern(console_pattern_);
+    }
 
     spd_->flush_on(spdlog::level::warn);
   }
@@ -230,17 +1103,16 @@ namespace vix::utils
 
   bool Logger::jsonColorsEnabled()
   {
-    if (const char *nc = vix::utils::vix_getenv("NO_COLOR"); nc && *nc)
+    const EnvSnapshot &env = env_snapshot();
+    if (!env.view_or("NO_COLOR").empty())
       return false;
 
-    if (const char *c = vix::utils::vix_getenv("VIX_COLOR"); c && *c)
+    if (const std::string_view v = env.view_or("VIX_COLOR"); !v.empty())
     {
-      const std::string v = lower_copy(c);
-
-      if (v == "never" || v == "0" || v == "false")
+      if (iequals(v, "never") || iequals(v, "0") || iequals(v, "false"))
         return false;
 
-      if (v == "always" || v == "1" || v == "true")
+      if (iequals(v, "always") || iequals(v, "1") || iequals(v, "true"))
         return true;
     }
 
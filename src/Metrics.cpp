@@ -0,0 +1,330 @@
+/**
+ *
+ *  @file Metrics.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#include <vix/utils/Metrics.hpp>
+#include <vix/utils/String.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <new>
+
+namespace vix::utils
+{
+  namespace
+  {
+    template <typename N>
+    void append_number(std::string &out, N v)
+    {
+      char buf[32];
+      const auto r = std::to_chars(buf, buf + sizeof(buf), v);
+      out.append(buf, r.ptr);
+    }
+
+    void append_mean(std::string &out, double v)
+    {
+      char buf[32];
+      const auto r = std::to_chars(buf, buf + sizeof(buf), v, std::chars_format::fixed, 1);
+      out.append(buf, r.ptr);
+    }
+
+    struct Quantile
+    {
+      std::string_view name;
+      double q;
+    };
+
+    constexpr Quantile kQuantiles[] = {
+        {"p50", 0.50}, {"p90", 0.90}, {"p99", 0.99}, {"p999", 0.999}};
+
+    void append_json_key(std::string &out, std::string_view k)
+    {
+      out.push_back('"');
+      json_escape_to(out, k);
+      out.append("\":");
+    }
+  } // namespace
+
+  std::uint64_t HistogramSnapshot::percentile(double q) const noexcept
+  {
+    if (count == 0 || buckets.empty())
+      return 0;
+
+    q = std::clamp(q, 0.0, 1.0);
+    // Rank of the sample, 1-based: the q-quantile is the ceil(q * count)-th value.
+    const auto rank = std::max<std::uint64_t>(
+        1, static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(count))));
+
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < buckets.size(); ++i)
+    {
+      seen += buckets[i];
+      if (seen >= rank)
+      {
+        const std::uint64_t lo = Histogram::bucket_low(i);
+        const std::uint64_t hi = std::min(Histogram::bucket_high(i), max);
+        const std::uint64_t mid = lo + (hi > lo ? (hi - lo) / 2 : 0);
+        // A snapshot racing record() may see the bucket before min/max move.
+        if (min > max)
+          return mid;
+        return std::clamp(mid, min, max);
+      }
+    }
+    return max;
+  }
+
+  void HistogramSnapshot::merge(const HistogramSnapshot &other)
+  {
+    if (other.count == 0)
+      return;
+
+    if (buckets.size() < other.buckets.size())
+      buckets.resize(other.buckets.size(), 0);
+    for (std::size_t i = 0; i < other.buckets.size(); ++i)
+      buckets[i] += other.buckets[i];
+
+    min = count ? std::min(min, other.min) : other.min;
+    max = count ? std::max(max, other.max) : other.max;
+    count += other.count;
+    sum += other.sum;
+  }
+
+  Histogram::Shard *Histogram::allocShard(std::atomic<Shard *> &slot) noexcept
+  {
+    Shard *fresh = new (std::nothrow) Shard();
+    if (!fresh)
+      return nullptr;
+
+    // Threads that share a shard may race here; the loser frees its copy.
+    Shard *expected = nullptr;
+    if (slot.compare_exchange_strong(expected, fresh, std::memory_order_acq_rel))
+      return fresh;
+    delete fresh;
+    return expected;
+  }
+
+  HistogramSnapshot Histogram::snapshot() const
+  {
+    HistogramSnapshot out;
+    out.min = std::numeric_limits<std::uint64_t>::max();
+
+    for (const auto &slot : shards_)
+    {
+      const Shard *s = slot.load(std::memory_order_acquire);
+      if (!s)
+        continue;
+
+      if (out.buckets.empty())
+        out.buckets.assign(kBuckets, 0);
+
+      for (std::size_t i = 0; i < kBuckets; ++i)
+      {
+        const std::uint64_t n = s->buckets[i].load(std::memory_order_relaxed);
+        out.buckets[i] += n;
+        out.count += n;
+      }
+      out.sum += s->sum.load(std::memory_order_relaxed);
+      out.min = std::min(out.min, s->min.load(std::memory_order_relaxed));
+      out.max = std::max(out.max, s->max.load(std::memory_order_relaxed));
+    }
+
+    if (out.count == 0)
+      out = HistogramSnapshot{};
+    return out;
+  }
+
+  void Histogram::reset() noexcept
+  {
+    for (auto &slot : shards_)
+    {
+      Shard *s = slot.load(std::memory_order_acquire);
+      if (!s)
+        continue;
+      for (auto &b : s->buckets)
+        b.store(0, std::memory_order_relaxed);
+      s->sum.store(0, std::memory_order_relaxed);
+      s->min.store(std::numeric_limits<std::uint64_t>::max(), std::memory_order_relaxed);
+      s->max.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  MetricsRegistry &MetricsRegistry::instance()
+  {
+    // Leaked so that metrics stay usable from other static destructors.
+    static MetricsRegistry *registry = new MetricsRegistry();
+    return *registry;
+  }
+
+  Counter &MetricsRegistry::counter(std::string_view name)
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto it = counters_.find(name);
+    if (it == counters_.end())
+      it = counters_.emplace(std::string(name), std::make_unique<Counter>()).first;
+    return *it->second;
+  }
+
+  Gauge &MetricsRegistry::gauge(std::string_view name)
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto it = gauges_.find(name);
+    if (it == gauges_.end())
+      it = gauges_.emplace(std::string(name), std::make_unique<Gauge>()).first;
+    return *it->second;
+  }
+
+  Histogram &MetricsRegistry::histogram(std::string_view name)
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto it = histograms_.find(name);
+    if (it == histograms_.end())
+      it = histograms_.emplace(std::string(name), std::make_unique<Histogram>()).first;
+    return *it->second;
+  }
+
+  std::uint64_t MetricsRegistry::addCollector(Collector fn)
+  {
+    std::lock_guard<std::mutex> lk(collectors_mutex_);
+    const std::uint64_t id = next_collector_++;
+    collectors_.emplace_back(id, std::move(fn));
+    return id;
+  }
+
+  void MetricsRegistry::removeCollector(std::uint64_t id)
+  {
+    std::lock_guard<std::mutex> lk(collectors_mutex_);
+    collectors_.erase(std::remove_if(collectors_.begin(), collectors_.end(),
+                                     [id](const auto &c)
+                                     { return c.first == id; }),
+                      collectors_.end());
+  }
+
+  MetricsSnapshot MetricsRegistry::snapshot() const
+  {
+    MetricsSnapshot snap;
+    {
+      std::lock_guard<std::mutex> lk(mutex_);
+      snap.counters.reserve(counters_.size());
+      for (const auto &[name, c] : counters_)
+        snap.counters.emplace_back(name, c->value());
+      snap.gauges.reserve(gauges_.size());
+      for (const auto &[name, g] : gauges_)
+        snap.gauges.emplace_back(name, g->value());
+      snap.histograms.reserve(histograms_.size());
+      for (const auto &[name, h] : histograms_)
+        snap.histograms.emplace_back(name, h->snapshot());
+    }
+
+    // Held while collectors run so removeCollector() cannot return mid-call.
+    std::lock_guard<std::mutex> lk(collectors_mutex_);
+    for (const auto &c : collectors_)
+      c.second(snap);
+    return snap;
+  }
+
+  std::string metrics_to_text(const MetricsSnapshot &snap, char sep)
+  {
+    std::string out;
+    auto entry = [&](std::string_view name, std::string_view suffix, std::string_view sub = {})
+    {
+      if (!out.empty())
+        out.push_back(sep);
+      out.append(name);
+      out.append(suffix);
+      out.append(sub);
+      out.push_back('=');
+    };
+
+    for (const auto &[name, v] : snap.counters)
+    {
+      entry(name, {});
+      append_number(out, v);
+    }
+    for (const auto &[name, v] : snap.gauges)
+    {
+      entry(name, {});
+      append_number(out, v);
+    }
+    for (const auto &[name, h] : snap.histograms)
+    {
+      entry(name, ".count");
+      append_number(out, h.count);
+      entry(name, ".sum");
+      append_number(out, h.sum);
+      entry(name, ".min");
+      append_number(out, h.min);
+      entry(name, ".max");
+      append_number(out, h.max);
+      entry(name, ".mean");
+      append_mean(out, h.mean());
+      for (const Quantile &q : kQuantiles)
+      {
+        entry(name, ".", q.name);
+        append_number(out, h.percentile(q.q));
+      }
+    }
+    return out;
+  }
+
+  std::string metrics_to_json(const MetricsSnapshot &snap)
+  {
+    std::string out;
+    out.append("{\"counters\":{");
+    for (std::size_t i = 0; i < snap.counters.size(); ++i)
+    {
+      if (i)
+        out.push_back(',');
+      append_json_key(out, snap.counters[i].first);
+      append_number(out, snap.counters[i].second);
+    }
+
+    out.append("},\"gauges\":{");
+    for (std::size_t i = 0; i < snap.gauges.size(); ++i)
+    {
+      if (i)
+        out.push_back(',');
+      append_json_key(out, snap.gauges[i].first);
+      append_number(out, snap.gauges[i].second);
+    }
+
+    out.append("},\"histograms\":{");
+    for (std::size_t i = 0; i < snap.histograms.size(); ++i)
+    {
+      const HistogramSnapshot &h = snap.histograms[i].second;
+      if (i)
+        out.push_back(',');
+      append_json_key(out, snap.histograms[i].first);
+      out.append("{\"count\":");
+      append_number(out, h.count);
+      out.append(",\"sum\":");
+      append_number(out, h.sum);
+      out.append(",\"min\":");
+      append_number(out, h.min);
+      out.append(",\"max\":");
+      append_number(out, h.max);
+      out.append(",\"mean\":");
+      append_mean(out, h.mean());
+      for (const Quantile &q : kQuantiles)
+      {
+        out.append(",\"");
+        out.append(q.name);
+        out.append("\":");
+        append_number(out, h.percentile(q.q));
+      }
+      out.push_back('}');
+    }
+    out.append("}}");
+    return out;
+  }
+
+} // namespace vix::utils
@@ -0,0 +1,193 @@
+/**
+ *
+ *  @file test_metrics.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#undef NDEBUG
+#include <vix/utils/Metrics.hpp>
+
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace vix::utils;
+
+namespace
+{
+  void test_buckets()
+  {
+    using H = Histogram;
+
+    // exact buckets below kSub, then kSub sub-buckets per power of two
+    for (std::uint64_t v = 0; v < 2 * H::kSub; ++v)
+    {
+      assert(H::bucket_of(v) == v);
+      assert(H::bucket_low(v) == v);
+    }
+
+    // every bucket boundary maps back to its own bucket
+    for (std::size_t i = 0; i + 1 < H::kBuckets; ++i)
+    {
+      const std::uint64_t lo = H::bucket_low(i);
+      const std::uint64_t hi = H::bucket_high(i);
+      assert(lo <= hi);
+      assert(H::bucket_of(lo) == i);
+      assert(H::bucket_of(hi) == i);
+      assert(H::bucket_of(hi + 1) == i + 1);
+    }
+
+    // relative bucket width stays under 1/kSub
+    for (std::size_t i = 2 * H::kSub; i + 1 < H::kBuckets; ++i)
+      assert((H::bucket_high(i) - H::bucket_low(i) + 1) * H::kSub <= H::bucket_low(i));
+
+    assert(H::bucket_of(std::uint64_t{1} << 48) == H::kBuckets - 1);
+    assert(H::bucket_of(~std::uint64_t{0}) == H::kBuckets - 1);
+    assert(H::bucket_high(H::kBuckets - 1) == ~std::uint64_t{0});
+  }
+
+  void test_percentiles()
+  {
+    Histogram h;
+    for (std::uint64_t v = 1; v <= 10000; ++v)
+      h.record(v);
+
+    const HistogramSnapshot s = h.snapshot();
+    assert(s.count == 10000);
+    assert(s.sum == 10000ull * 10001 / 2);
+    assert(s.min == 1);
+    assert(s.max == 10000);
+    assert(s.mean() > 5000.4 && s.mean() < 5000.6);
+
+    const auto near = [](std::uint64_t got, double want)
+    {
+      const double err = (static_cast<double>(got) - want) / want;
+      return err > -1.0 / Histogram::kSub && err < 1.0 / Histogram::kSub;
+    };
+    assert(near(s.percentile(0.50), 5000));
+    assert(near(s.percentile(0.90), 9000));
+    assert(near(s.percentile(0.99), 9900));
+    assert(s.percentile(0.0) == 1);
+    assert(near(s.percentile(1.0), 10000));
+
+    // a single sample is exact through the [min, max] clamp
+    Histogram one;
+    one.record(123456);
+    assert(one.snapshot().percentile(0.5) == 123456);
+
+    // inconsistent min/max (snapshot racing record) must not trip the clamp
+    HistogramSnapshot torn = one.snapshot();
+    torn.min = ~std::uint64_t{0};
+    torn.max = 0;
+    const std::uint64_t p = torn.percentile(0.5);
+    assert(p >= Histogram::bucket_low(Histogram::bucket_of(123456)));
+    assert(p <= Histogram::bucket_high(Histogram::bucket_of(123456)));
+
+    assert(Histogram().snapshot().percentile(0.5) == 0);
+
+    HistogramSnapshot merged = s;
+    merged.merge(one.snapshot());
+    assert(merged.count == 10001);
+    assert(merged.max == 123456);
+    assert(merged.min == 1);
+
+    h.reset();
+    assert(h.snapshot().count == 0);
+  }
+
+  void test_concurrent_counter()
+  {
+    Counter c;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t)
+      threads.emplace_back([&c]
+                           {
+                             for (int i = 0; i < 10000; ++i)
+                               c.inc();
+                           });
+    for (auto &t : threads)
+      t.join();
+    assert(c.value() == 80000);
+  }
+
+  void test_exporters()
+  {
+    MetricsSnapshot snap;
+    snap.counters.emplace_back("req.total", 42);
+    snap.gauges.emplace_back("queue.depth", -3);
+
+    Histogram h;
+    h.record(7);
+    snap.histograms.emplace_back("lat.ns", h.snapshot());
+
+    const std::string text = metrics_to_text(snap);
+    assert(text ==
+           "req.total=42\n"
+           "queue.depth=-3\n"
+           "lat.ns.count=1\n"
+           "lat.ns.sum=7\n"
+           "lat.ns.min=7\n"
+           "lat.ns.max=7\n"
+           "lat.ns.mean=7.0\n"
+           "lat.ns.p50=7\n"
+           "lat.ns.p90=7\n"
+           "lat.ns.p99=7\n"
+           "lat.ns.p999=7");
+
+    assert(metrics_to_text(snap, ' ').find("req.total=42 queue.depth=-3 ") == 0);
+
+    const std::string json = metrics_to_json(snap);
+    assert(json ==
+           "{\"counters\":{\"req.total\":42},"
+           "\"gauges\":{\"queue.depth\":-3},"
+           "\"histograms\":{\"lat.ns\":{\"count\":1,\"sum\":7,\"min\":7,\"max\":7,\"mean\":7.0,"
+           "\"p50\":7,\"p90\":7,\"p99\":7,\"p999\":7}}}");
+
+    MetricsSnapshot quoted;
+    quoted.counters.emplace_back("a\"b", 1);
+    assert(metrics_to_json(quoted) == "{\"counters\":{\"a\\\"b\":1},\"gauges\":{},\"histograms\":{}}");
+  }
+
+  void test_registry()
+  {
+    auto &reg = MetricsRegistry::instance();
+    Counter &c = reg.counter("test.metrics.counter");
+    assert(&c == &reg.counter("test.metrics.counter"));
+    c.add(5);
+
+    const std::uint64_t id = reg.addCollector([](MetricsSnapshot &s)
+                                              { s.gauges.emplace_back("test.metrics.collected", 9); });
+    MetricsSnapshot snap = reg.snapshot();
+    bool counter = false;
+    bool collected = false;
+    for (const auto &[name, v] : snap.counters)
+      counter = counter || (name == "test.metrics.counter" && v == 5);
+    for (const auto &[name, v] : snap.gauges)
+      collected = collected || (name == "test.metrics.collected" && v == 9);
+    assert(counter && collected);
+
+    reg.removeCollector(id);
+    snap = reg.snapshot();
+    for (const auto &[name, v] : snap.gauges)
+      assert(name != "test.metrics.collected");
+  }
+} // namespace
+
+int main()
+{
+  test_buckets();
+  test_percentiles();
+  test_concurrent_counter();
+  test_exporters();
+  test_registry();
+  return 0;
+}
@@ -0,0 +1,177 @@
+/**
+ *
+ *  @file test_multipart.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#undef NDEBUG
+#include <vix/utils/Multipart.hpp>
+
+#include <cassert>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace vix::utils;
+
+namespace
+{
+  struct Part
+  {
+    std::string name;
+    std::string filename;
+    std::string data;
+  };
+
+  struct Collect
+  {
+    std::vector<Part> parts;
+    std::size_t ended = 0;
+
+    void on_part_begin(const MultipartParser::PartHeaders &h)
+    {
+      parts.push_back(Part{std::string(h.name), std::string(h.filename), {}});
+    }
+    void on_part_data(std::string_view d)
+    {
+      assert(!d.empty());
+      parts.back().data.append(d);
+    }
+    void on_part_end() { ++ended; }
+  };
+
+  std::vector<Part> parse(std::string_view disposition, std::size_t chunk)
+  {
+    const std::string body = std::string("--XyZ\r\n") +
+                             "Content-Disposition: " + std::string(disposition) + "\r\n\r\n" +
+                             "hello\r\n--XyZ--\r\n";
+
+    MultipartParser parser("XyZ");
+    Collect c;
+    for (std::size_t pos = 0; pos < body.size(); pos += chunk)
+      assert(parser.feed(std::string_view(body).substr(pos, chunk), c));
+    assert(parser.done());
+    return c.parts;
+  }
+
+  std::string field(std::string_view name, std::string_view data)
+  {
+    return "--XyZ\r\nContent-Disposition: form-data; name=\"" + std::string(name) + "\"\r\n\r\n" +
+           std::string(data) + "\r\n";
+  }
+
+  // Part data made of delimiter false starts: each prefix of "\r\n--XyZ"
+  // followed by a byte that breaks the match.
+  std::string false_starts()
+  {
+    const std::string delim = "\r\n--XyZ";
+    std::string out = "x";
+    for (std::size_t n = 1; n < delim.size(); ++n)
+      out += delim.substr(0, n) + "!";
+    out += "\r\r\n--\r\n--Xy\r\n--XyY\n--XyZ\r--XyZ";
+    return out;
+  }
+
+  /**
+   * @brief Feed `body` cut at each offset in `cuts` (ascending) and check the result.
+   */
+  void expect(const std::string &body, const std::vector<std::size_t> &cuts,
+              const std::vector<std::pair<std::string, std::string>> &want)
+  {
+    MultipartParser parser("XyZ");
+    Collect c;
+    std::size_t pos = 0;
+    for (const std::size_t cut : cuts)
+    {
+      assert(parser.feed(std::string_view(body).substr(pos, cut - pos), c));
+      pos = cut;
+    }
+    assert(parser.feed(std::string_view(body).substr(pos), c));
+    assert(parser.done());
+    assert(c.parts.size() == want.size());
+    assert(c.ended == want.size());
+    for (std::size_t i = 0; i < want.size(); ++i)
+    {
+      assert(c.parts[i].name == want[i].first);
+      assert(c.parts[i].data == want[i].second);
+    }
+  }
+
+  void test_streaming()
+  {
+    const std::string tricky = false_starts();
+    const std::vector<std::pair<std::string, std::string>> want = {
+        {"a", "alpha"},
+        {"empty", ""},
+        {"tricky", tricky},
+        {"crlf", "\r\n"},
+        {"last", "-"},
+    };
+
+    std::string body = "preamble\r\n";
+    for (const auto &[name, data] : want)
+      body += field(name, data);
+    body += "--XyZ--\r\nepilogue";
+
+    // one cut at every offset
+    for (std::size_t cut = 0; cut <= body.size(); ++cut)
+      expect(body, {cut}, want);
+
+    // two cuts around every offset, so false starts straddle a chunk
+    for (std::size_t cut = 1; cut + 3 <= body.size(); ++cut)
+      expect(body, {cut, cut + 3}, want);
+
+    // fixed chunk sizes
+    for (std::size_t chunk = 1; chunk <= body.size(); ++chunk)
+    {
+      std::vector<std::size_t> cuts;
+      for (std::size_t pos = chunk; pos < body.size(); pos += chunk)
+        cuts.push_back(pos);
+      expect(body, cuts, want);
+    }
+
+    // a part whose data ends exactly at a chunk boundary, then the delimiter
+    const std::size_t end_of_alpha = body.find("alpha") + 5;
+    expect(body, {end_of_alpha}, want);
+    expect(body, {end_of_alpha, end_of_alpha + 2}, want);
+    expect(body, {end_of_alpha, end_of_alpha + 9}, want);
+  }
+} // namespace
+
+int main()
+{
+  for (const std::size_t chunk : {std::size_t{1}, std::size_t{7}, std::size_t{4096}})
+  {
+    auto p = parse(R"(form-data; name="field"; filename="a.txt")", chunk);
+    assert(p.size() == 1);
+    assert(p[0].name == "field");
+    assert(p[0].filename == "a.txt");
+    assert(p[0].data == "hello");
+
+    // a token without '=' must not shift the scan onto the next parameter
+    p = parse(R"(form-data; foo; name="x")", chunk);
+    assert(p.size() == 1);
+    assert(p[0].name == "x");
+    assert(p[0].filename.empty());
+
+    p = parse(R"(form-data; foo; bar ; filename=b.bin; name=y)", chunk);
+    assert(p[0].name == "y");
+    assert(p[0].filename == "b.bin");
+
+    p = parse("form-data; foo", chunk);
+    assert(p[0].name.empty());
+
+    p = parse(R"(form-data; NAME="up")", chunk);
+    assert(p[0].name == "up");
+  }
+
+  test_streaming();
+  return 0;
+}
@@ -0,0 +1,76 @@
+/**
+ *
+ *  @file test_network_error.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#undef NDEBUG
+#include <vix/utils/NetworkError.hpp>
+
+#include <cassert>
+#include <string>
+#include <system_error>
+
+using namespace vix::utils;
+
+namespace
+{
+  // Category whose raw values are not errno values, like the Windows
+  // system category (WSAECONNRESET = 10054 maps to connection_reset).
+  class WsaLikeCategory final : public std::error_category
+  {
+  public:
+    const char *name() const noexcept override { return "wsa-like"; }
+
+    std::string message(int) const override { return "unknown"; }
+
+    std::error_condition default_error_condition(int value) const noexcept override
+    {
+      if (value == 10054)
+        return std::errc::connection_reset;
+      if (value == 10061)
+        return std::errc::connection_refused;
+      return {value, *this};
+    }
+  };
+
+  const WsaLikeCategory &wsa_like_category()
+  {
+    static const WsaLikeCategory cat;
+    return cat;
+  }
+} // namespace
+
+int main()
+{
+  // errno values, system and generic categories
+  assert(is_normal_network_disconnect(std::error_code(ECONNRESET, std::system_category())));
+  assert(is_normal_network_disconnect(std::error_code(EPIPE, std::generic_category())));
+  assert(is_normal_network_disconnect(std::make_error_code(std::errc::timed_out)));
+  assert(!is_normal_network_disconnect(std::error_code(ECONNREFUSED, std::system_category())));
+  assert(!is_normal_network_disconnect(std::error_code()));
+
+  // value differs from its errc: equivalence goes through default_error_condition()
+  assert(is_normal_network_disconnect(std::error_code(10054, wsa_like_category())));
+  assert(!is_normal_network_disconnect(std::error_code(10061, wsa_like_category())));
+  assert(!is_normal_network_disconnect(std::error_code(10000, wsa_like_category())));
+
+#if defined(_WIN32)
+  assert(is_normal_network_disconnect(std::error_code(10054, std::system_category()))); // WSAECONNRESET
+  assert(is_normal_network_disconnect(std::error_code(10053, std::system_category()))); // WSAECONNABORTED
+#endif
+
+  // messages
+  assert(is_normal_network_disconnect_message("read: Connection reset by peer"));
+  assert(is_normal_network_disconnect_message("write: Broken Pipe"));
+  assert(!is_normal_network_disconnect_message("connection refused"));
+
+  return 0;
+}
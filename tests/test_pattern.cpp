@@ -0,0 +1,183 @@
+/**
+ *
+ *  @file test_pattern.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#undef NDEBUG
+#include <vix/utils/Pattern.hpp>
+
+#include <cassert>
+#include <cstdio>
+#include <random>
+#include <regex>
+#include <string>
+
+using namespace vix::utils;
+
+namespace
+{
+  // Small alphabet so random inputs hit the random patterns often.
+  constexpr char kAlphabet[] = {'a', 'b', 'c', '0', '7', '_', ' ', '\t', '\n', '-', '.', '@'};
+
+  struct Gen
+  {
+    std::mt19937 rng;
+
+    explicit Gen(std::uint32_t seed) : rng(seed) {}
+
+    int pick(int n) { return std::uniform_int_distribution<int>(0, n - 1)(rng); }
+
+    char letter() { return kAlphabet[pick(static_cast<int>(sizeof(kAlphabet)))]; }
+
+    std::string atom(int depth)
+    {
+      switch (pick(depth > 0 ? 9 : 7))
+      {
+      case 0:
+        return std::string(1, "abc"[pick(3)]);
+      case 1:
+        return ".";
+      case 2:
+      {
+        static const char *esc[] = {"\\d", "\\w", "\\s", "\\D", "\\W", "\\S", "\\.", "\\-", "\\t", "\\n"};
+        return esc[pick(10)];
+      }
+      case 3:
+      {
+        static const char *cls[] = {"[ab]", "[^a]", "[a-c]", "[0-9_]", "[^@\\s]", "[\\w.-]", "[^\\d]", "[-a]"};
+        return cls[pick(8)];
+      }
+      case 4:
+        return "@";
+      case 5:
+        return "0";
+      case 6:
+        return " ";
+      case 7:
+        return "(" + alt(depth - 1) + ")";
+      default:
+        return "(?:" + alt(depth - 1) + ")";
+      }
+    }
+
+    std::string piece(int depth)
+    {
+      std::string a = atom(depth);
+      switch (pick(10))
+      {
+      case 0:
+        return a + "*";
+      case 1:
+        return a + "+";
+      case 2:
+        return a + "?";
+      case 3:
+        return a + "{" + std::to_string(pick(3)) + "}";
+      case 4:
+        return a + "{" + std::to_string(pick(3)) + ",}";
+      case 5:
+      {
+        const int m = pick(3);
+        return a + "{" + std::to_string(m) + "," + std::to_string(m + pick(3)) + "}";
+      }
+      case 6:
+        return a + (pick(2) ? "*?" : "+?");
+      default:
+        return a;
+      }
+    }
+
+    std::string concat(int depth)
+    {
+      std::string out;
+      for (int n = 1 + pick(3); n > 0; --n)
+        out += piece(depth);
+      return out;
+    }
+
+    std::string alt(int depth)
+    {
+      std::string out = concat(depth);
+      while (pick(4) == 0)
+        out += "|" + concat(depth);
+      return out;
+    }
+
+    std::string pattern()
+    {
+      // Shallow on purpose: std::regex backtracks, deep nesting is slow there.
+      std::string p = alt(1);
+      if (pick(4) == 0)
+        p = "^" + p;
+      if (pick(4) == 0)
+        p += "$";
+      return p;
+    }
+
+    std::string input()
+    {
+      std::string s;
+      for (int n = pick(9); n > 0; --n)
+        s += letter();
+      return s;
+    }
+  };
+
+  void test_fixed()
+  {
+    const Pattern email(R"(^[^@\s]+@[^@\s]+\.[^@\s]+$)");
+    assert(email.compiled());
+    assert(email.matches("ada@example.com"));
+    assert(!email.matches("ada@example"));
+    assert(!email.matches("a da@example.com"));
+
+    // back-references are outside the DFA subset
+    const Pattern backref(R"((a+)b\1)");
+    assert(!backref.compiled());
+    assert(backref.matches("aabaa"));
+    assert(!backref.matches("aaba"));
+  }
+
+  void test_differential()
+  {
+    Gen gen(0x5eed1234u);
+    int compiled = 0;
+
+    for (int round = 0; round < 2000; ++round)
+    {
+      const std::string src = gen.pattern();
+      const Pattern p(src);
+      const std::regex re(src);
+      compiled += p.compiled() ? 1 : 0;
+
+      for (int k = 0; k < 40; ++k)
+      {
+        const std::string s = gen.input();
+        const bool want = std::regex_match(s, re);
+        if (p.matches(s) != want)
+        {
+          std::fprintf(stderr, "mismatch: /%s/ on \"%s\": regex=%d\n", src.c_str(), s.c_str(), want);
+          assert(false);
+        }
+      }
+    }
+
+    // the generator only uses the DFA subset
+    assert(compiled == 2000);
+  }
+} // namespace
+
+int main()
+{
+  test_fixed();
+  test_differential();
+  return 0;
+}
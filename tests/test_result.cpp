@@ -0,0 +1,218 @@
+/**
+ *
+ *  @file test_result.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#undef NDEBUG
+#include <vix/utils/Result.hpp>
+
+#include <cassert>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+using namespace vix::utils;
+
+namespace
+{
+  struct Errno
+  {
+    int value;
+  };
+} // namespace
+
+template <>
+struct vix::utils::ResultNiche<Errno>
+{
+  static constexpr bool enabled = true;
+  static Errno ok_value() noexcept { return Errno{0}; }
+  static bool is_ok(const Errno &e) noexcept { return e.value == 0; }
+};
+
+namespace
+{
+  // Trivial payloads keep the whole Result trivial.
+  static_assert(std::is_trivially_copyable_v<Result<int, int>>);
+  static_assert(std::is_trivially_destructible_v<Result<int, int>>);
+  static_assert(std::is_trivially_copyable_v<Result<void, int>>);
+  static_assert(!std::is_trivially_copyable_v<Result<std::string, int>>);
+  static_assert(std::is_nothrow_move_constructible_v<Result<std::string, std::string>>);
+
+  // Move-only payloads make a move-only Result.
+  using Owned = Result<std::unique_ptr<int>, std::unique_ptr<std::string>>;
+  static_assert(!std::is_copy_constructible_v<Owned>);
+  static_assert(std::is_move_constructible_v<Owned>);
+  static_assert(std::is_move_assignable_v<Owned>);
+
+  // The niche folds the discriminant into E.
+  static_assert(sizeof(Result<void, Errno>) == sizeof(Errno));
+
+  constexpr Result<int, int> half(int v)
+  {
+    return v % 2 ? Result<int, int>::Err(v) : Result<int, int>::Ok(v / 2);
+  }
+  static_assert(half(8).and_then(half).value() == 2);
+  static_assert(half(6).and_then(half).error() == 3);
+
+  struct Counted
+  {
+    static inline int live = 0;
+    Counted() { ++live; }
+    Counted(const Counted &) { ++live; }
+    Counted(Counted &&) noexcept { ++live; }
+    Counted &operator=(const Counted &) = default;
+    Counted &operator=(Counted &&) noexcept = default;
+    ~Counted() { --live; }
+  };
+
+  void test_basics()
+  {
+    const auto ok = Result<int, std::string>::Ok(42);
+    assert(ok.is_ok() && !ok.is_err() && ok);
+    assert(ok.value() == 42);
+    assert(ok.value_or(7) == 42);
+
+    const auto err = Result<int, std::string>::Err("boom");
+    assert(err.is_err() && !err);
+    assert(err.error() == "boom");
+    assert(err.value_or(7) == 7);
+
+    auto v = Result<void>::Ok();
+    assert(v.is_ok());
+    v = Result<void>::Err("denied");
+    assert(v.error() == "denied");
+  }
+
+  void test_move_only()
+  {
+    Owned a = Owned::Ok(std::make_unique<int>(5));
+    Owned b = std::move(a);
+    assert(b.is_ok() && *b.value() == 5);
+
+    std::unique_ptr<int> p = std::move(b).value();
+    assert(p && *p == 5);
+
+    Owned e = Owned::Err(std::make_unique<std::string>("gone"));
+    b = std::move(e);
+    assert(b.is_err() && *b.error() == "gone");
+
+    // rvalue combinators move the payload through
+    auto doubled = Owned::Ok(std::make_unique<int>(21)).map([](std::unique_ptr<int> q)
+                                                            { return *q * 2; });
+    static_assert(std::is_same_v<decltype(doubled), Result<int, std::unique_ptr<std::string>>>);
+    assert(doubled.value() == 42);
+
+    auto chained = Owned::Ok(std::make_unique<int>(1)).and_then([](std::unique_ptr<int> q)
+                                                                { return Owned::Ok(std::move(q)); });
+    assert(*chained.value() == 1);
+
+    // alternatives are destroyed exactly once across assignments
+    {
+      auto r = Result<Counted, Counted>::Ok(Counted{});
+      r = Result<Counted, Counted>::Err(Counted{});
+      r = Result<Counted, Counted>::Ok(Counted{});
+      auto copy = r;
+      assert(Counted::live == 2);
+    }
+    assert(Counted::live == 0);
+  }
+
+  void test_combinators()
+  {
+    using R = Result<int, std::string>;
+
+    // map keeps E, changes T
+    auto len = R::Ok(3).map([](int v)
+                            { return std::string(static_cast<std::size_t>(v), 'x'); });
+    static_assert(std::is_same_v<decltype(len), Result<std::string, std::string>>);
+    assert(len.value() == "xxx");
+    assert(R::Err("e").map([](int v)
+                           { return v + 1; })
+               .error() == "e");
+
+    // map to void
+    int seen = 0;
+    auto done = R::Ok(9).map([&](int v)
+                             { seen = v; });
+    static_assert(std::is_same_v<decltype(done), Result<void, std::string>>);
+    assert(done.is_ok() && seen == 9);
+
+    // map_error changes E
+    auto code = R::Err("four").map_error([](const std::string &s)
+                                         { return static_cast<int>(s.size()); });
+    static_assert(std::is_same_v<decltype(code), Result<int, int>>);
+    assert(code.error() == 4);
+    assert(R::Ok(1).map_error([](const std::string &)
+                              { return 0; })
+               .value() == 1);
+
+    // and_then changes T and short-circuits on Err
+    auto parsed = R::Ok(12).and_then([](int v)
+                                     { return Result<double, std::string>::Ok(v / 4.0); });
+    assert(parsed.value() == 3.0);
+    bool called = false;
+    auto skipped = R::Err("stop").and_then([&](int)
+                                           {
+                                             called = true;
+                                             return Result<double, std::string>::Ok(0.0);
+                                           });
+    assert(!called && skipped.error() == "stop");
+
+    // or_else changes E and is skipped on Ok
+    auto recovered = R::Err("x").or_else([](const std::string &s)
+                                         { return Result<int, int>::Ok(static_cast<int>(s.size())); });
+    static_assert(std::is_same_v<decltype(recovered), Result<int, int>>);
+    assert(recovered.value() == 1);
+    auto failed = R::Err("bad").or_else([](const std::string &)
+                                        { return Result<int, int>::Err(-1); });
+    assert(failed.error() == -1);
+    auto kept = R::Ok(5).or_else([](const std::string &)
+                                 { return Result<int, int>::Err(-1); });
+    assert(kept.value() == 5);
+
+    // void chains
+    auto step = Result<void, std::string>::Ok().and_then([]
+                                                          { return Result<int, std::string>::Ok(8); });
+    assert(step.value() == 8);
+    auto fixed = Result<void, std::string>::Err("e").or_else([](std::string)
+                                                             { return Result<void, int>::Ok(); });
+    assert(fixed.is_ok());
+  }
+
+  void test_niche()
+  {
+    auto ok = Result<void, Errno>::Ok();
+    assert(ok.is_ok());
+    auto err = Result<void, Errno>::Err(Errno{13});
+    assert(err.is_err() && err.error().value == 13);
+
+    bool threw = false;
+    try
+    {
+      (void)Result<void, Errno>::Err(Errno{0});
+    }
+    catch (const std::invalid_argument &)
+    {
+      threw = true;
+    }
+    assert(threw);
+  }
+} // namespace
+
+int main()
+{
+  test_basics();
+  test_move_only();
+  test_combinators();
+  test_niche();
+  return 0;
+}
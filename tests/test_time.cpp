@@ -0,0 +1,168 @@
+/**
+ *
+ *  @file test_time.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#undef NDEBUG
+#include <vix/utils/Time.hpp>
+
+#include <cassert>
+#include <cstdio>
+#include <ctime>
+#include <random>
+#include <string>
+#include <thread>
+
+using namespace vix::utils;
+
+namespace
+{
+  std::string reference(std::time_t t, const char *fmt)
+  {
+    const std::tm tm = utc_tm(t);
+    char buf[64];
+    const std::size_t n = std::strftime(buf, sizeof(buf), fmt, &tm);
+    return std::string(buf, n);
+  }
+
+  void check(std::time_t t)
+  {
+    char buf[64];
+    char *end = format_rfc1123(t, buf);
+    assert(end == buf + kRfc1123Size);
+    const std::string rfc(buf, kRfc1123Size);
+
+    end = format_iso8601(t, buf);
+    assert(end == buf + kIso8601Size);
+    const std::string iso(buf, kIso8601Size);
+
+    if (rfc != reference(t, "%a, %d %b %Y %H:%M:%S GMT") || iso != reference(t, "%Y-%m-%dT%H:%M:%SZ"))
+    {
+      std::fprintf(stderr, "mismatch at %lld: %s / %s\n", static_cast<long long>(t), rfc.c_str(), iso.c_str());
+      assert(false);
+    }
+  }
+
+  void test_formatting()
+  {
+    char epoch[64];
+    format_rfc1123(0, epoch);
+    assert(std::string(epoch, kRfc1123Size) == "Thu, 01 Jan 1970 00:00:00 GMT");
+
+    const std::time_t fixed[] = {
+        0,
+        -1,                    // 1969-12-31T23:59:59Z
+        -86400,                // 1969-12-31T00:00:00Z
+        -2208988800,           // 1900-01-01 (not a leap year)
+        -2203891200,           // 1900-03-01
+        951782400,             // 2000-02-29 (leap day, century divisible by 400)
+        951868800,             // 2000-03-01
+        1078012800,            // 2004-02-29
+        1709164800,            // 2024-02-29
+        1709251199,            // 2024-02-29T23:59:59Z
+        -68256000,             // 1967-11-03
+        -5364576060,           // 1800-01-01T23:59:00Z (not a leap year)
+        2147483647,            // 2038-01-19T03:14:07Z, INT32_MAX
+        2147483648,            // one past INT32_MAX
+        253402300799,          // 9999-12-31T23:59:59Z
+    };
+    for (const std::time_t t : fixed)
+      check(t);
+
+    // 1896-03-12 to 2105-01-01, stepping a day minus 7 s so the time of day
+    // drifts; crosses the leap rules of 1900, 2000 and 2100
+    for (std::time_t t = -2329084800; t < 4260211200; t += 86400 - 7)
+      check(t);
+
+    std::mt19937_64 rng(7);
+    // strftime's %Y does not zero-pad, so compare from year 1000 on
+    std::uniform_int_distribution<std::int64_t> any(-30610224000, 253402300799);
+    for (int i = 0; i < 100000; ++i)
+      check(static_cast<std::time_t>(any(rng)));
+
+    char year1[64];
+    format_rfc1123(-62135596800, year1);
+    assert(std::string(year1, kRfc1123Size) == "Mon, 01 Jan 0001 00:00:00 GMT");
+    format_iso8601(-62135596800, year1);
+    assert(std::string(year1, kIso8601Size) == "0001-01-01T00:00:00Z");
+
+    // time_point overloads truncate to the second
+    const auto tp = std::chrono::system_clock::from_time_t(951782400) + std::chrono::milliseconds(999);
+    char a[64];
+    char b[64];
+    format_rfc1123(tp, a);
+    format_rfc1123(951782400, b);
+    assert(std::string(a, kRfc1123Size) == std::string(b, kRfc1123Size));
+    format_iso8601(tp, a);
+    assert(std::string(a, kIso8601Size) == "2000-02-29T00:00:00Z");
+  }
+
+  void test_date_cache()
+  {
+    DateCache cache;
+    char a[64];
+    char b[64];
+    for (const std::time_t t : {std::time_t{1709164800}, std::time_t{1709164801}, std::time_t{1709164800}})
+    {
+      cache.rfc1123(t, a);
+      format_rfc1123(t, b);
+      assert(std::string(a, kRfc1123Size) == std::string(b, kRfc1123Size));
+      cache.iso8601(t, a);
+      format_iso8601(t, b);
+      assert(std::string(a, kIso8601Size) == std::string(b, kIso8601Size));
+    }
+  }
+
+  void test_clocks()
+  {
+    std::uint64_t prev = now_ms();
+    for (int i = 0; i < 1000; ++i)
+    {
+      const std::uint64_t t = now_ms();
+      assert(t >= prev);
+      prev = t;
+    }
+
+    const auto sys = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count());
+    assert(unix_ms() + 1000 > sys && unix_ms() < sys + 1000);
+
+    CoarseClock &cc = CoarseClock::instance();
+    cc.start();
+    assert(cc.running());
+    const std::uint64_t m0 = cc.now_ms();
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    const std::uint64_t m1 = cc.now_ms();
+    assert(m1 >= m0 + 10);
+    assert(cc.unix_ms() + 1000 > sys);
+    cc.stop();
+    assert(!cc.running());
+    assert(cc.now_ms() >= m1);
+
+    const TscClock &tsc = TscClock::instance();
+    const std::uint64_t t0 = tsc.now_ns();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    const std::uint64_t t1 = tsc.now_ns();
+    assert(t1 > t0);
+    assert(t1 - t0 >= 15'000'000u);
+    assert(t1 - t0 < 2'000'000'000u);
+  }
+} // namespace
+
+int main()
+{
+  test_formatting();
+  test_date_cache();
+  test_clocks();
+  return 0;
+}
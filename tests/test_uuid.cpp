@@ -0,0 +1,150 @@
+/**
+ *
+ *  @file test_uuid.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ *
+ */
+#undef NDEBUG
+#include <vix/utils/UUID.hpp>
+
+#include <array>
+#include <cassert>
+#include <string>
+#include <unordered_set>
+
+using namespace vix::utils;
+
+namespace
+{
+  bool rfc_variant(const Uuid &u) { return (u.bytes[8] & 0xC0) == 0x80; }
+
+  void test_v4()
+  {
+    // all-ones and all-zeros input bits still yield version 4, variant 10
+    struct Fixed
+    {
+      std::uint64_t v;
+      std::uint64_t operator()() noexcept { return v; }
+    };
+    for (const std::uint64_t bits : {std::uint64_t{0}, ~std::uint64_t{0}})
+    {
+      Fixed rng{bits};
+      const Uuid u = Uuid::v4(rng);
+      assert(u.version() == 4);
+      assert(rfc_variant(u));
+    }
+
+    std::unordered_set<Uuid> seen;
+    std::array<Uuid, 256> batch;
+    uuid4_batch(batch);
+    for (const Uuid &u : batch)
+    {
+      assert(u.version() == 4);
+      assert(rfc_variant(u));
+      assert(seen.insert(u).second);
+    }
+
+    const Uuid s = Uuid::v4_secure();
+    assert(s.version() == 4 && rfc_variant(s));
+
+    const std::string text = uuid4();
+    assert(text.size() == Uuid::kStringSize);
+    assert(text[14] == '4');
+    assert(text[19] == '8' || text[19] == '9' || text[19] == 'a' || text[19] == 'b');
+  }
+
+  void test_text_round_trip()
+  {
+    const Uuid u = Uuid::from_u64(0x0123456789abcdefull, 0xfedcba9876543210ull);
+    assert(u.bytes[0] == 0x01 && u.bytes[7] == 0xef && u.bytes[8] == 0xfe && u.bytes[15] == 0x10);
+    assert(u.str() == "01234567-89ab-cdef-fedc-ba9876543210");
+
+    char buf[Uuid::kStringSize];
+    assert(u.to_chars(buf) == buf + Uuid::kStringSize);
+    assert(std::string(buf, sizeof(buf)) == u.str());
+
+    assert(Uuid::parse(u.str()) == u);
+    assert(Uuid::parse("01234567-89AB-CDEF-FEDC-BA9876543210") == u);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+      const Uuid r = Uuid::v4();
+      const auto back = Uuid::parse(r.str());
+      assert(back && *back == r);
+    }
+
+    assert(!Uuid::parse(""));
+    assert(!Uuid::parse("01234567-89ab-cdef-fedc-ba987654321"));
+    assert(!Uuid::parse("01234567-89ab-cdef-fedc-ba98765432100"));
+    assert(!Uuid::parse("01234567_89ab-cdef-fedc-ba9876543210"));
+    assert(!Uuid::parse("0123456g-89ab-cdef-fedc-ba9876543210"));
+    assert(!Uuid::parse("01234567-89ab-cdef-fedc-ba987654321 "));
+
+    const auto nil = Uuid::parse("00000000-0000-0000-0000-000000000000");
+    assert(nil && nil->is_nil());
+    assert(!u.is_nil());
+  }
+
+  void test_v7()
+  {
+    Xoshiro256ss rng(42);
+    Uuid7Sequence seq;
+
+    // strictly increasing within one millisecond, across counter overflow,
+    // and when the clock steps backwards
+    Uuid prev = seq.next(1'700'000'000'000ull, rng);
+    assert(prev.version() == 7);
+    assert(rfc_variant(prev));
+    assert(prev.timestamp_ms() == 1'700'000'000'000ull);
+
+    for (int i = 0; i < 10000; ++i)
+    {
+      const Uuid u = seq.next(1'700'000'000'000ull, rng);
+      assert(u.version() == 7);
+      assert(rfc_variant(u));
+      assert(prev < u);
+      assert(prev.str() < u.str());
+      prev = u;
+    }
+    // 10000 IDs overflowed the 12-bit counter, so the timestamp moved ahead
+    assert(prev.timestamp_ms() > 1'700'000'000'000ull);
+
+    const std::uint64_t ahead = prev.timestamp_ms();
+    const Uuid back = seq.next(1'600'000'000'000ull, rng);
+    assert(prev < back);
+    assert(back.timestamp_ms() == ahead);
+
+    const Uuid later = seq.next(ahead + 5, rng);
+    assert(back < later);
+    assert(later.timestamp_ms() == ahead + 5);
+
+    // thread-local generator
+    std::array<Uuid, 512> batch;
+    uuid7_batch(batch);
+    for (std::size_t i = 1; i < batch.size(); ++i)
+      assert(batch[i - 1] < batch[i]);
+    const Uuid next = Uuid::v7();
+    assert(batch.back() < next);
+    assert(next.version() == 7);
+    assert(next.timestamp_ms() + 1000 >= unix_ms());
+
+    const std::string text = uuid7();
+    assert(text[14] == '7');
+    assert(Uuid::parse(text)->version() == 7);
+  }
+} // namespace
+
+int main()
+{
+  test_v4();
+  test_text_round_trip();
+  test_v7();
+  return 0;
+}